@@ -0,0 +1,30 @@
+#include <gba_interrupt.h>
+#include "adpcm.h"
+#include "audio_mixer.h"
+
+static AdpcmStream s_decoders[AUDIO_VOICES]; // By mixer voice
+
+static int fillStream(int voice, s8 *out, int count) {
+    return adpcmDecode(&s_decoders[voice], out, count);
+}
+
+static u32 readLong(const u8 *p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((u32)p[3] << 24);
+}
+
+int adpcmPlay(const u8 *blob, int volume) {
+    if (blob[0] != 'A' || blob[1] != 'D' || blob[2] != '4' || blob[3] != 'S') return -1;
+
+    // The stream is set up before the mixer can ask it for samples
+    u16 ime = REG_IME;
+    REG_IME = 0;
+    int voice = audioPlayStream(fillStream, readLong(blob + 8), volume);
+    AdpcmStream *s = &s_decoders[voice];
+    s->next = blob + ADPCM_HEADER_BYTES;
+    s->remaining = readLong(blob + 4);
+    s->scale = 0;
+    s->blockLeft = 0;
+    s->sample = 0;
+    REG_IME = ime;
+    return voice;
+}
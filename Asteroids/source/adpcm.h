@@ -0,0 +1,51 @@
+#ifndef ADPCM_H
+#define ADPCM_H
+
+#include <gba_base.h>
+#include <gba_types.h>
+
+// --- 4-bit ADPCM Sound Effects ---
+// Blobs made by tools/adpcm from WAV files (sfx/*.wav, linked in by the
+// Makefile as <name>_adpcm) are decoded while they play, a frame's worth at
+// a time, into a mixer stream voice (audio_mixer.h); nothing is unpacked
+// ahead. Layout, little-endian:
+//   "AD4S", u32 sample count, u32 sample rate
+//   blocks of ADPCM_BLOCK_SAMPLES: a scale byte (0-7), then one byte per
+//   two samples, low nibble first
+// Each nibble picks a step from the block's scale of ADPCM_STEPS, added to
+// the previous sample.
+
+#define ADPCM_HEADER_BYTES  12
+#define ADPCM_BLOCK_SAMPLES 32
+#define ADPCM_BLOCK_BYTES   (1 + ADPCM_BLOCK_SAMPLES / 2)
+#define ADPCM_SCALES        8
+
+// Shared with the encoder (tools/adpcm); the decoder is its only user here
+static const s8 ADPCM_STEPS[ADPCM_SCALES][16] ALIGN(4) = {
+    { 0, 1, 2,  4,  6,  9, 13, 18, -1,  -2,  -4,  -6,  -9, -13, -18,  -25 },
+    { 0, 2, 3,  6,  9, 14, 20, 27, -2,  -3,  -6,  -9, -14, -20, -27,  -38 },
+    { 0, 2, 4,  8, 12, 18, 26, 36, -2,  -4,  -8, -12, -18, -26, -36,  -50 },
+    { 0, 2, 5, 10, 15, 22, 32, 45, -2,  -5, -10, -15, -22, -32, -45,  -62 },
+    { 0, 3, 6, 12, 18, 27, 39, 54, -3,  -6, -12, -18, -27, -39, -54,  -75 },
+    { 0, 4, 7, 14, 21, 32, 46, 63, -4,  -7, -14, -21, -32, -46, -63,  -88 },
+    { 0, 4, 8, 16, 24, 36, 52, 72, -4,  -8, -16, -24, -36, -52, -72, -100 },
+    { 0, 5, 10, 20, 30, 45, 65, 90, -5, -10, -20, -30, -45, -65, -90, -125 },
+};
+
+typedef struct {
+    const u8 *next;     // Next byte of the blob
+    u32 remaining;      // Samples not decoded yet
+    int scale;          // The current block's row of ADPCM_STEPS
+    int blockLeft;      // Samples left in the current block
+    int sample;         // Last decoded sample
+} AdpcmStream;
+
+// Plays 'blob' on an effect voice at its own rate; returns the voice, or -1
+// if it is not an ADPCM blob
+int adpcmPlay(const u8 *blob, int volume);
+
+// Decodes up to 'count' samples; returns how many (adpcm.iwram.c). Works in
+// pairs: an odd end writes one sample past them.
+IWRAM_CODE int adpcmDecode(AdpcmStream *stream, s8 *out, int count);
+
+#endif // ADPCM_H
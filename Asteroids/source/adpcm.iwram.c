@@ -0,0 +1,38 @@
+#include "adpcm.h"
+
+// Built as ARM code (the .iwram.c rule). The block's row of steps is copied
+// out of ROM once per block, so a sample costs one table load from IWRAM
+// and an add; a byte of the blob holds two.
+
+IWRAM_CODE int adpcmDecode(AdpcmStream *stream, s8 *out, int count) {
+    if ((u32)count > stream->remaining) count = stream->remaining;
+
+    const u8 *next = stream->next;
+    int left = stream->blockLeft;
+    int sample = stream->sample;
+    u32 row[4];
+    const s8 *steps = (const s8 *)row;
+    const u32 *rom = (const u32 *)ADPCM_STEPS[stream->scale];
+    for (int w = 0; w < 4; w++) row[w] = rom[w];
+
+    for (int i = 0; i < count; i += 2) {
+        if (left == 0) {
+            stream->scale = *next++ & (ADPCM_SCALES - 1);
+            rom = (const u32 *)ADPCM_STEPS[stream->scale];
+            for (int w = 0; w < 4; w++) row[w] = rom[w];
+            left = ADPCM_BLOCK_SAMPLES;
+        }
+        u32 codes = *next++;
+        sample += steps[codes & 0x0F];
+        out[i] = sample;
+        sample += steps[codes >> 4];
+        out[i + 1] = sample;
+        left -= 2;
+    }
+
+    stream->next = next;
+    stream->blockLeft = left;
+    stream->sample = sample;
+    stream->remaining -= count;
+    return count;
+}
@@ -0,0 +1,230 @@
+#include <gba_dma.h>
+#include <gba_interrupt.h>
+#include <gba_sound.h>
+#include <gba_timers.h>
+#include <gba_video.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "audio_mixer.h"
+#include "mem_ops.h"
+#include "perf.h"
+
+#define AVG_SHIFT 3 // Mix cost average kept scaled by 8, as in perf.c
+#define EFFECT_VOICES   (AUDIO_VOICES - AUDIO_MUSIC_VOICES)
+#define MAX_STREAM_STEP (2 << AUDIO_FRAC_BITS) // A frame then reads under 460 samples
+
+// FIFO A plays left, FIFO B right, both clocked by timer 0
+#define STREAM_CONTROL  (SNDA_VOL_100 | SNDB_VOL_100 | SNDA_L_ENABLE | SNDB_R_ENABLE | \
+                         SNDA_RESET_FIFO | SNDB_RESET_FIFO)
+#define STREAM_DMA      (DMA_DST_FIXED | DMA_SRC_INC | DMA_REPEAT | DMA32 | DMA_SPECIAL | DMA_ENABLE)
+
+// Two halves each: DMA plays one while audioMix() fills the other
+static s8 s_left[2 * AUDIO_FRAME_SAMPLES] ALIGN(4);
+static s8 s_right[2 * AUDIO_FRAME_SAMPLES] ALIGN(4);
+static s16 s_mixLeft[AUDIO_FRAME_SAMPLES] ALIGN(4);
+static s16 s_mixRight[AUDIO_FRAME_SAMPLES] ALIGN(4);
+
+static MixVoice s_voices[AUDIO_VOICES];
+static u32 s_voiceStarted[AUDIO_VOICES]; // Start order, for stealing effect voices
+static u32 s_startCount = 0;
+
+static bool s_ready = false;    // audioInit() has run
+static bool s_streaming = false;
+static int s_playHalf = 0;
+
+// Effect voices that stream: their data is the window, holding s_streamFill
+// samples from the voice's position on
+static AudioStreamFill s_streams[EFFECT_VOICES];
+static s8 s_streamWindow[EFFECT_VOICES][AUDIO_STREAM_WINDOW] ALIGN(4);
+static int s_streamFill[EFFECT_VOICES];
+
+static AudioTickHandler s_tickHandler = NULL;
+static int s_tickLeft = 0;      // Output samples until the tick handler is due
+
+static int s_avgLines8 = 0;
+
+static void startStream(vu32 *control, vu32 *source, vu32 *dest, const s8 *buffer, u32 fifo) {
+    *control = 0;
+    *source = (u32)buffer;
+    *dest = fifo;
+    *control = STREAM_DMA;
+}
+
+static void restartStreams(void) {
+    startStream(&REG_DMA1CNT, &REG_DMA1SAD, &REG_DMA1DAD, s_left, (u32)&REG_FIFO_A);
+    startStream(&REG_DMA2CNT, &REG_DMA2SAD, &REG_DMA2DAD, s_right, (u32)&REG_FIFO_B);
+}
+
+void audioInit(void) {
+    for (int v = 0; v < AUDIO_VOICES; v++) s_voices[v].data = NULL;
+    for (int e = 0; e < EFFECT_VOICES; e++) s_streams[e] = NULL;
+    memFill32(s_left, 0, sizeof(s_left));
+    memFill32(s_right, 0, sizeof(s_right));
+
+    REG_TM0CNT_H = 0;
+    REG_SOUNDCNT_H = STREAM_CONTROL;
+    REG_TM0CNT_L = 65536 - AUDIO_TIMER_RELOAD;
+    s_streaming = false;
+    s_ready = true;
+}
+
+void audioVBlank(void) {
+    if (!s_ready) return;
+    if (!s_streaming) {
+        // Start on a VBlank so every later one falls on a half boundary
+        restartStreams();
+        REG_TM0CNT_H = TIMER_START;
+        s_streaming = true;
+        s_playHalf = 0;
+        return;
+    }
+    s_playHalf ^= 1;
+    if (s_playHalf == 0) restartStreams();
+}
+
+// Slides each stream's window to the voice's position and tops it up with
+// what this frame will play
+static void refillStreams(void) {
+    for (int e = 0; e < EFFECT_VOICES; e++) {
+        if (!s_streams[e]) continue;
+        MixVoice *v = &s_voices[AUDIO_MUSIC_VOICES + e];
+        if (!v->data) {
+            s_streams[e] = NULL;
+            continue;
+        }
+        s8 *window = s_streamWindow[e];
+        int used = v->pos >> AUDIO_FRAC_BITS;
+        int keep = s_streamFill[e] - used;
+        for (int i = 0; i < keep; i++) window[i] = window[used + i];
+        v->pos -= used << AUDIO_FRAC_BITS;
+
+        int need = ((v->pos + v->step * AUDIO_FRAME_SAMPLES) >> AUDIO_FRAC_BITS) + 1;
+        if (need > keep) {
+            int count = (need - keep + 1) & ~1; // Whole bytes of 4-bit codes
+            keep += s_streams[e](AUDIO_MUSIC_VOICES + e, window + keep, count);
+        }
+        s_streamFill[e] = keep;
+        v->end = keep << AUDIO_FRAC_BITS;
+    }
+}
+
+void audioMix(void) {
+    if (!s_streaming) return;
+    int start = REG_VCOUNT;
+    refillStreams();
+
+    int half = (s_playHalf ^ 1) * AUDIO_FRAME_SAMPLES;
+    memFill32(s_mixLeft, 0, sizeof(s_mixLeft));
+    memFill32(s_mixRight, 0, sizeof(s_mixRight));
+
+    // Mix in chunks that end where the tick handler is due, so its changes
+    // land on the exact sample
+    int done = 0;
+    while (done < AUDIO_FRAME_SAMPLES) {
+        int count = AUDIO_FRAME_SAMPLES - done;
+        if (s_tickHandler) {
+            if (s_tickLeft <= 0) s_tickLeft = s_tickHandler();
+            if (count > s_tickLeft) count = s_tickLeft;
+        }
+        for (int v = 0; v < AUDIO_VOICES; v++) {
+            if (s_voices[v].data) audioMixVoice(&s_voices[v], s_mixLeft + done, s_mixRight + done, count);
+        }
+        done += count;
+        s_tickLeft -= count;
+    }
+    audioClip(s_left + half, s_mixLeft, AUDIO_FRAME_SAMPLES);
+    audioClip(s_right + half, s_mixRight, AUDIO_FRAME_SAMPLES);
+
+    int lines = REG_VCOUNT - start;
+    if (lines < 0) lines += SCANLINES_PER_FRAME;
+    s_avgLines8 += lines - (s_avgLines8 >> AVG_SHIFT);
+}
+
+int audioMixPercent(void) {
+    return (s_avgLines8 * 100 + (SCANLINES_PER_FRAME << (AVG_SHIFT - 1))) / (SCANLINES_PER_FRAME << AVG_SHIFT);
+}
+
+void audioSetTickHandler(AudioTickHandler handler) {
+    u16 ime = REG_IME;
+    REG_IME = 0;
+    s_tickHandler = handler;
+    s_tickLeft = 0;
+    REG_IME = ime;
+}
+
+MixVoice *audioVoice(int voice) {
+    return &s_voices[voice];
+}
+
+void audioVoiceStart(int voice, const s8 *data, u32 offset, u32 length, u32 loopStart, u32 loopLength) {
+    MixVoice *v = &s_voices[voice];
+    if (offset >= length) {
+        v->data = NULL;
+        return;
+    }
+    v->pos = offset << AUDIO_FRAC_BITS;
+    if (loopLength) {
+        v->end = (loopStart + loopLength) << AUDIO_FRAC_BITS;
+        v->loopLength = loopLength << AUDIO_FRAC_BITS;
+    } else {
+        v->end = length << AUDIO_FRAC_BITS;
+        v->loopLength = 0;
+    }
+    v->data = data;
+    s_voiceStarted[voice] = ++s_startCount;
+    if (voice >= AUDIO_MUSIC_VOICES) s_streams[voice - AUDIO_MUSIC_VOICES] = NULL;
+}
+
+void audioVoiceStop(int voice) {
+    s_voices[voice].data = NULL;
+}
+
+u32 audioStep(u32 rate) {
+    return (rate << AUDIO_FRAC_BITS) / AUDIO_RATE;
+}
+
+// The first free effect voice, or the one started longest ago
+static int claimEffectVoice(void) {
+    int voice = AUDIO_MUSIC_VOICES;
+    for (int v = AUDIO_MUSIC_VOICES; v < AUDIO_VOICES; v++) {
+        if (!s_voices[v].data) return v;
+        if (s_voiceStarted[v] < s_voiceStarted[voice]) voice = v;
+    }
+    return voice;
+}
+
+static void setEffectVoice(MixVoice *v, u32 rate, int volume) {
+    v->step = audioStep(rate);
+    v->volume = (volume > AUDIO_MAX_VOLUME) ? AUDIO_MAX_VOLUME : volume;
+    v->pan = AUDIO_PAN_CENTER;
+}
+
+int audioPlaySample(const s8 *data, u32 length, u32 rate, int volume) {
+    u16 ime = REG_IME;
+    REG_IME = 0;
+    int voice = claimEffectVoice();
+    setEffectVoice(&s_voices[voice], rate, volume);
+    audioVoiceStart(voice, data, 0, length, 0, 0);
+    REG_IME = ime;
+    return voice;
+}
+
+int audioPlayStream(AudioStreamFill fill, u32 rate, int volume) {
+    u16 ime = REG_IME;
+    REG_IME = 0;
+    int voice = claimEffectVoice();
+    int e = voice - AUDIO_MUSIC_VOICES;
+    MixVoice *v = &s_voices[voice];
+    setEffectVoice(v, rate, volume);
+    if (v->step > MAX_STREAM_STEP) v->step = MAX_STREAM_STEP;
+    // Empty until the next audioMix() fills the window
+    v->data = s_streamWindow[e];
+    v->pos = 0;
+    v->end = 0;
+    v->loopLength = 0;
+    s_voiceStarted[voice] = ++s_startCount;
+    s_streams[e] = fill;
+    s_streamFill[e] = 0;
+    REG_IME = ime;
+    return voice;
+}
@@ -0,0 +1,74 @@
+#ifndef AUDIO_MIXER_H
+#define AUDIO_MIXER_H
+
+#include <gba_base.h>
+#include <gba_types.h>
+
+// --- DirectSound PCM Mixer ---
+// Timer 0 clocks both FIFOs at AUDIO_RATE; DMA1 feeds FIFO A (left) and
+// DMA2 FIFO B (right) from double-buffered frames of 8-bit samples in
+// IWRAM. The rate is exactly AUDIO_FRAME_SAMPLES per refresh, so the
+// buffer halves swap on VBlank: audioVBlank() swaps, audioMix() fills the
+// half not playing (audio_mixer.iwram.c is the ARM inner loop).
+
+#define AUDIO_TIMER_RELOAD  1254    // CPU cycles per sample
+#define AUDIO_RATE          13379   // Hz (16.78 MHz / AUDIO_TIMER_RELOAD)
+#define AUDIO_FRAME_SAMPLES 224     // 280896 cycles per refresh / AUDIO_TIMER_RELOAD
+
+// Hard cap: voices 0-3 belong to the module player (mod_player.h), the
+// rest play effects. A full effect set steals its oldest voice.
+#define AUDIO_VOICES        8
+#define AUDIO_MUSIC_VOICES  4
+
+#define AUDIO_FRAC_BITS     12      // Voice positions and steps are 20.12 samples
+#define AUDIO_MAX_VOLUME    64
+
+#define AUDIO_PAN_LEFT      1
+#define AUDIO_PAN_RIGHT     2
+#define AUDIO_PAN_CENTER    (AUDIO_PAN_LEFT | AUDIO_PAN_RIGHT)
+
+typedef struct {
+    const s8 *data;     // NULL: the voice is silent
+    u32 pos;            // Sample position
+    u32 step;           // Samples advanced per output sample
+    u32 end;            // Loop or sample end
+    u32 loopLength;     // 0: one-shot, the voice stops at end
+    u8 volume;          // 0-AUDIO_MAX_VOLUME
+    u8 pan;             // AUDIO_PAN_*
+} MixVoice;
+
+void audioInit(void);   // After REG_SOUNDCNT_X enables sound; streaming starts on the next VBlank
+void audioVBlank(void); // First in the VBlank handler: swaps the halves
+void audioMix(void);    // Last in the VBlank handler, interrupts on: mixes the next half
+int audioMixPercent(void); // Smoothed CPU share of audioMix(), in percent
+
+// Called between chunks of a mix; returns the output samples until it is
+// due again (the module player's tick)
+typedef int (*AudioTickHandler)(void);
+void audioSetTickHandler(AudioTickHandler handler);
+
+// Voice control. Lengths are in samples; call with interrupts off, or from
+// the tick handler.
+MixVoice *audioVoice(int voice);
+void audioVoiceStart(int voice, const s8 *data, u32 offset, u32 length, u32 loopStart, u32 loopLength);
+void audioVoiceStop(int voice);
+u32 audioStep(u32 rate); // Step that plays a sample recorded at 'rate' Hz at its pitch
+
+// One-shot PCM effect on the next free effect voice, centered; returns the
+// voice. Safe from the main loop.
+int audioPlaySample(const s8 *data, u32 length, u32 rate, int volume);
+
+// Streamed effects (e.g. adpcm.h): once per frame audioMix() asks 'fill' for
+// the samples the frame will play, into a window of AUDIO_STREAM_WINDOW
+// samples in IWRAM. 'fill' writes up to 'count' samples of the voice's
+// stream to 'out' and returns how many, fewer once the stream ends. Rates
+// up to twice AUDIO_RATE; otherwise as audioPlaySample().
+#define AUDIO_STREAM_WINDOW 512
+typedef int (*AudioStreamFill)(int voice, s8 *out, int count);
+int audioPlayStream(AudioStreamFill fill, u32 rate, int volume);
+
+// ARM inner loops (audio_mixer.iwram.c)
+IWRAM_CODE void audioMixVoice(MixVoice *voice, s16 *left, s16 *right, int count);
+IWRAM_CODE void audioClip(s8 *out, const s16 *mix, int count);
+
+#endif // AUDIO_MIXER_H
@@ -0,0 +1,44 @@
+#include <stddef.h>
+#include "audio_mixer.h"
+
+// Built as ARM code (the .iwram.c rule): the per-sample loops run from
+// IWRAM's 32-bit bus. Voices add (sample * volume) / 4 into 16-bit sums,
+// which keeps all eight voices at full volume in range; audioClip()
+// divides by 32, so two full-volume voices reach full scale.
+
+#define MIX_SHIFT   2
+#define CLIP_SHIFT  5
+
+IWRAM_CODE void audioMixVoice(MixVoice *voice, s16 *left, s16 *right, int count) {
+    const s8 *data = voice->data;
+    u32 pos = voice->pos;
+    u32 step = voice->step;
+    u32 end = voice->end;
+    u32 loop = voice->loopLength;
+    int volume = voice->volume;
+    int pan = voice->pan;
+
+    for (int i = 0; i < count; i++) {
+        if (pos >= end) {
+            if (!loop) {
+                voice->data = NULL;
+                return;
+            }
+            do pos -= loop; while (pos >= end);
+        }
+        int s = (data[pos >> AUDIO_FRAC_BITS] * volume) >> MIX_SHIFT;
+        if (pan & AUDIO_PAN_LEFT) left[i] += s;
+        if (pan & AUDIO_PAN_RIGHT) right[i] += s;
+        pos += step;
+    }
+    voice->pos = pos;
+}
+
+IWRAM_CODE void audioClip(s8 *out, const s16 *mix, int count) {
+    for (int i = 0; i < count; i++) {
+        int s = mix[i] >> CLIP_SHIFT;
+        if (s > 127) s = 127;
+        else if (s < -128) s = -128;
+        out[i] = s;
+    }
+}
@@ -0,0 +1,469 @@
+#include <stddef.h>
+#include <gba_input.h>
+#include "autopilot.h"
+#include "fixed_trig.h"
+#include "graphics.h"
+#include "object_pool.h"
+
+// Threats are asteroids due to pass within their radius plus THREAT_MARGIN
+// pixels of the ship in the next THREAT_HORIZON frames. Any threat sends the
+// bot to the evasion planner before it aims at anything.
+#define THREAT_HORIZON      PLAN_FRAMES
+#define THREAT_MARGIN       16
+// The planner plays each escape plan forward this many frames against the
+// asteroids' straight-line paths
+#define PLAN_FRAMES         32
+// Frames of thrust once a plan's heading is reached: a short hop, as longer
+// burns build speeds the bot cannot steer at
+#define PLAN_BURN           8
+#ifndef COMMIT
+#define COMMIT 2
+#endif
+// Farthest point of the ship's triangle from its center (front_offset)
+#define SHIP_REACH          6
+// A plan passing no closer than this many pixels leaves the bot free to aim
+#define SAFE_CLEARANCE      6
+// Cap on the clearance a plan is credited with, so wide misses tie and the
+// plan that stays nearest the middle of the screen wins
+#define CLEARANCE_CAP       24
+// Degrees turned per frame while KEY_LEFT/KEY_RIGHT is held (ROTATION_SPEED_DEG)
+#define TURN_STEP_DEG       18
+// Half the per-frame rotation step
+#define TURN_DEADBAND_DEG   9
+// Heading error within which thrust is applied
+#define THRUST_CONE_DEG     45
+// Between threats the bot drifts back to the middle of the screen, where
+// spawns arrive from furthest away: it aims for STATION_GAIN (fixed point per
+// pixel off center) up to STATION_SPEED, and only burns when its velocity is
+// more than STATION_SLACK off that. With so little friction anything faster
+// overruns the bot's reactions.
+#define STATION_GAIN        4
+#define STATION_SPEED       (INT_TO_FP(1) / 2)
+#define STATION_SLACK       48
+// Medium and large asteroids split where they are hit. A shot is held while
+// it would land nearer than SPLIT_RANGE pixels, or a fragment would
+// pass within FRAGMENT_MARGIN pixels of the ship in the FRAGMENT_HORIZON
+// frames after the split: born that close, it arrives before the bot can
+// turn away.
+#define SPLIT_RANGE         64
+#define FRAGMENT_HORIZON    40
+#define FRAGMENT_MARGIN     16
+// Frames between shots (bullets only fire on a fresh KEY_A press); the
+// bullet table caps the spray
+#define FIRE_COOLDOWN       1
+// Bullet travel speed in pixels/frame (BULLET_SPEED), used to lead targets
+#define LEAD_SPEED          BULLET_SPEED
+// Frames a bullet can fly before it is off screen
+#define SHOT_FRAMES         (SCREEN_WIDTH / BULLET_SPEED + 1)
+// Ship physics replayed by the planner (ACCEL_FACTOR_FP and the velocity
+// clamp in updatePlayer())
+#define ACCEL_FP            26
+#define MAX_VELOCITY_FP     INT_TO_FP(PLAYER_MAX_VELOCITY)
+
+void autopilotInit(Autopilot *ap) {
+    ap->fireCooldown = 0;
+    ap->evading = 0;
+    ap->planHeading = 0;
+}
+
+// Signed shortest difference target - current, in (-180, 180]
+static int angleDelta(int target, int current) {
+    int d = target - current;
+    while (d > 180) d -= 360;
+    while (d <= -180) d += 360;
+    return d;
+}
+
+static u16 steerTowards(int heading, int desired) {
+    int d = angleDelta(desired, heading);
+    if (d > TURN_DEADBAND_DEG) return KEY_RIGHT;   // Angles grow clockwise on screen
+    if (d < -TURN_DEADBAND_DEG) return KEY_LEFT;
+    return 0;
+}
+
+// Octagonal distance estimate (within ~7%), plenty for lead aiming
+static int approxDistance(int dx, int dy) {
+    if (dx < 0) dx = -dx;
+    if (dy < 0) dy = -dy;
+    return (dx > dy) ? dx + ((dy * 3) >> 3) : dy + ((dx * 3) >> 3);
+}
+
+// Heading that leads the asteroid by its travel during the bullet's flight
+static int leadAngle(const Asteroid *asteroid, int dx, int dy, int *flight) {
+    int dist = approxDistance(dx, dy);
+    *flight = fxDivU(dist, LEAD_SPEED);
+    int aimX = dx + FP_TO_INT(asteroid->obj.velocityX * *flight);
+    int aimY = dy + FP_TO_INT(asteroid->obj.velocityY * *flight);
+    return atan2_deg(aimY, aimX);
+}
+
+// Whether an asteroid at (px, py) pixels from the ship, moving at (vx, vy)
+// relative to it (fixed point), comes within 'reach' pixels in 'horizon' frames
+static int passesNear(int px, int py, int vx, int vy, int reach, int horizon) {
+    s64 pp = (s64)px * px + (s64)py * py;
+    if (pp <= (s64)reach * reach) return 1;
+    // 1/16 pixel per frame, as in findNearestThreat()
+    s64 rvx = vx >> 4, rvy = vy >> 4;
+    s64 pv = px * rvx + py * rvy;
+    s64 vv = rvx * rvx + rvy * rvy;
+    if (pv >= 0 || vv == 0) return 0;                   // Moving apart
+    if (-16 * pv > (s64)horizon * vv) return 0;          // Closest approach too late
+    return pp * vv - pv * pv <= (s64)reach * reach * vv;
+}
+
+// Whether both fragments of a shot at this asteroid, landing 'flight' frames
+// from now, pass clear of the ship (handleCollisions() splits large ones
+// sideways and medium ones vertically, one pixel per frame each way)
+static int fragmentsMiss(const GameObject *ship, const Asteroid *asteroid, int dx, int dy, int flight) {
+    if (asteroid->sizeType == ASTEROID_SIZE_S) return 1; // Nothing left to split
+
+    const GameObject *a = &asteroid->obj;
+    int px = dx + FP_TO_INT((a->velocityX - 2 * ship->velocityX) * flight);
+    int py = dy + FP_TO_INT((a->velocityY - 2 * ship->velocityY) * flight);
+    if (approxDistance(px, py) < SPLIT_RANGE) return 0;
+    int large = (asteroid->sizeType == ASTEROID_SIZE_L);
+    int reach = getAsteroidRadius(large ? ASTEROID_SIZE_M : ASTEROID_SIZE_S) + SHIP_REACH + FRAGMENT_MARGIN;
+    for (int side = -1; side <= 1; side += 2) {
+        int vx = INT_TO_FP(FP_TO_INT(a->velocityX) + (large ? side : 0)) - 2 * ship->velocityX;
+        int vy = INT_TO_FP(FP_TO_INT(a->velocityY) + (large ? 0 : side)) - 2 * ship->velocityY;
+        if (passesNear(px, py, vx, vy, reach, FRAGMENT_HORIZON)) return 0;
+    }
+    return 1;
+}
+
+typedef struct {
+    int x, y;           // Fixed point
+    int vx, vy;
+} BulletState;
+
+// Start point and velocity as spawnBullet() sets them for a shot fired this
+// frame, after updatePlayer() has turned the ship and moved it once
+static void bulletStart(const GameObject *ship, int heading, BulletState *b) {
+    int cosA = cos_fp_deg(heading);
+    int sinA = sin_fp_deg(heading);
+    int front = ship->width / 2 + PLAYER_FRONT_EXTEND;
+    b->x = ship->x + ship->velocityX + INT_TO_FP(ship->width / 2) + INT_TO_FP((front * cosA) >> FP_SHIFT);
+    b->y = ship->y + ship->velocityY + INT_TO_FP(ship->height / 2) + INT_TO_FP((front * sinA) >> FP_SHIFT);
+    b->vx = (INT_TO_FP(BULLET_SPEED) * cosA) >> FP_SHIFT;
+    b->vy = (INT_TO_FP(BULLET_SPEED) * sinA) >> FP_SHIFT;
+}
+
+// First frame (1 = the frame it is fired) a bullet comes within 'reach'
+// pixels of the asteroid, or 0 if it does not within 'frames'
+static int bulletMeets(const BulletState *b, const GameObject *a, int reach, int frames) {
+    for (int t = 1; t <= frames; t++) {
+        int bx = FP_TO_INT(b->x + b->vx * t);
+        int by = FP_TO_INT(b->y + b->vy * t);
+        // updateBullets() drops it at the screen edge
+        if (bx < -BULLET_SIZE || bx > SCREEN_WIDTH || by < -BULLET_SIZE || by > SCREEN_HEIGHT) return 0;
+        int dx = FP_TO_INT(a->x + a->velocityX * t) - bx;
+        int dy = FP_TO_INT(a->y + a->velocityY * t) - by;
+        if (dx * dx + dy * dy <= reach * reach) return t;
+    }
+    return 0;
+}
+
+// Whether a bullet fired now keeps clear of every medium and large asteroid
+// until it is SPLIT_RANGE pixels out: whatever it meets first splits,
+// target or not
+static int muzzleClear(const MatchContext *ctx, const GameObject *ship, int heading, const Asteroid asteroids[]) {
+    BulletState b;
+    bulletStart(ship, heading, &b);
+    POOL_FOR_EACH(&ctx->asteroidPool, i) {
+        if (asteroids[i].sizeType == ASTEROID_SIZE_S) continue;
+        int reach = getAsteroidRadius(asteroids[i].sizeType) - 1 + BULLET_SIZE + 1;
+        if (bulletMeets(&b, &asteroids[i].obj, reach, SPLIT_RANGE / BULLET_SPEED + 1)) return 0;
+    }
+    return 1;
+}
+
+// Whether a bullet fired along 'heading' hits the asteroid, a pixel inside
+// collisionWithAsteroid()'s reach, before it leaves the screen
+static int shotHits(const GameObject *ship, int heading, const Asteroid *asteroid) {
+    BulletState b;
+    bulletStart(ship, heading, &b);
+    int r = getAsteroidRadius(asteroid->sizeType);
+    int reach = ((r <= 3) ? r : r - 1) + BULLET_SIZE - 1;
+    return bulletMeets(&b, &asteroid->obj, reach, SHOT_FRAMES) != 0;
+}
+
+// Ship-to-asteroid vector as bullets travel it (they do not wrap); 0 if the
+// asteroid is off screen, out of their reach
+static int straightDelta(const GameObject *ship, const Asteroid *asteroid, int *dx, int *dy) {
+    int r = getAsteroidRadius(asteroid->sizeType);
+    int x = FP_TO_INT(asteroid->obj.x);
+    int y = FP_TO_INT(asteroid->obj.y);
+    if (x < -r || x > SCREEN_WIDTH + r || y < -r || y > SCREEN_HEIGHT + r) return 0;
+    *dx = x - (FP_TO_INT(ship->x) + ship->width / 2);
+    *dy = y - (FP_TO_INT(ship->y) + ship->height / 2);
+    return 1;
+}
+
+// The ship's heading once this frame's turn keys are applied; bullets leave
+// along it, as updatePlayer() turns before stepMatch() fires
+static int headingAfter(int angle, u16 held) {
+    if (held & KEY_LEFT) angle = fxWrapAdd(angle, -TURN_STEP_DEG, 360);
+    if (held & KEY_RIGHT) angle = fxWrapAdd(angle, TURN_STEP_DEG, 360);
+    return angle;
+}
+
+// The heading steerTowards() settles on for 'desired', starting from 'angle'
+static int nearestHeading(int angle, int desired) {
+    u16 turn;
+    while ((turn = steerTowards(angle, desired)) != 0) angle = headingAfter(angle, turn);
+    return angle;
+}
+
+// The nearest on-screen asteroid that a shot along the nearest holdable
+// heading to its lead would hit, else the nearest at all: the ship turns in
+// TURN_STEP_DEG steps, so a slow one at the wrong bearing can be missed for
+// as long as both sit still. Returns -1 if nothing is on screen.
+static int findTarget(const MatchContext *ctx, const GameObject *ship, const Asteroid asteroids[],
+                      int *dx, int *dy, int *desired, int *flight) {
+    int best = findNearestAsteroid(ctx, ship, asteroids, dx, dy, NULL);
+    if (best < 0) return -1;
+    int bestDist = 0x7FFFFFFF;
+    POOL_FOR_EACH(&ctx->asteroidPool, i) {
+        int ax, ay, t;
+        if (!straightDelta(ship, &asteroids[i], &ax, &ay)) continue;
+        int dist = approxDistance(ax, ay) - getAsteroidRadius(asteroids[i].sizeType);
+        if (dist >= bestDist) continue;
+        int aim = leadAngle(&asteroids[i], ax, ay, &t);
+        if (!shotHits(ship, nearestHeading(ship->angle, aim), &asteroids[i])) continue;
+        bestDist = dist;
+        best = i;
+        *dx = ax;
+        *dy = ay;
+    }
+    *desired = leadAngle(&asteroids[best], *dx, *dy, flight);
+    return best;
+}
+
+static u16 fire(Autopilot *ap, u16 *keysDown) {
+    if (ap->fireCooldown > 0) return 0;
+    *keysDown |= KEY_A;
+    ap->fireCooldown = FIRE_COOLDOWN;
+    return KEY_A;
+}
+
+static int clampSpeed(int v) {
+    if (v > STATION_SPEED) return STATION_SPEED;
+    if (v < -STATION_SPEED) return -STATION_SPEED;
+    return v;
+}
+
+// Keys that bring the ship's velocity to the station-keeping one, or 0 when
+// it is already close enough to aim instead
+static u16 holdStation(const GameObject *ship) {
+    int offX = SCREEN_WIDTH / 2 - (FP_TO_INT(ship->x) + ship->width / 2);
+    int offY = SCREEN_HEIGHT / 2 - (FP_TO_INT(ship->y) + ship->height / 2);
+    int ex = clampSpeed(offX * STATION_GAIN) - ship->velocityX;
+    int ey = clampSpeed(offY * STATION_GAIN) - ship->velocityY;
+    if (ex > -STATION_SLACK && ex < STATION_SLACK && ey > -STATION_SLACK && ey < STATION_SLACK) return 0;
+
+    int heading = atan2_deg(ey, ex);
+    u16 held = steerTowards(ship->angle, heading);
+    int err = angleDelta(heading, ship->angle);
+    if (err > -THRUST_CONE_DEG && err < THRUST_CONE_DEG) held |= KEY_UP;
+    return held;
+}
+
+// --- Evasion planner ---
+// Each plan turns to one of the headings the ship can hold (multiples of
+// TURN_STEP_DEG), burns for PLAN_BURN frames and coasts; the first plan just
+// drifts.
+// Plans are replayed with the ship physics of updatePlayer() and stepMatch(),
+// wrapping included, and scored by the first frame they touch an asteroid,
+// then by how close they pass.
+
+typedef struct {
+    int x, y;           // Top-left corner, fixed point
+    int vx, vy;
+    int angle;
+} ShipState;
+
+typedef struct {
+    int x, y;           // Fixed point
+    int vx, vy;
+    int size;           // Wrap margin (width)
+    int reach;          // Center distance at which it touches the ship
+} RockState;
+
+typedef struct {
+    int hitFrame;       // First frame in contact, or PLAN_FRAMES + 1
+    int clearance;      // Closest pass in pixels, capped at CLEARANCE_CAP
+    int offCenter;      // Distance from the screen center at the end
+} PlanScore;
+
+// Wraps a coordinate the way updatePlayer()/updateAsteroids() do: the
+// object's top-left corner runs from -size to the screen edge
+static int wrapAxis(int pos, int size, int extent) {
+    if (FP_TO_INT(pos) < -size) return INT_TO_FP(extent);
+    if (FP_TO_INT(pos) > extent) return INT_TO_FP(-size);
+    return pos;
+}
+
+static void stepShip(ShipState *s, int heading, int burn) {
+    int d = angleDelta(heading, s->angle);
+    if (d > 0) s->angle = fxWrapAdd(s->angle, TURN_STEP_DEG, 360);
+    else if (d < 0) s->angle = fxWrapAdd(s->angle, -TURN_STEP_DEG, 360);
+    else if (burn) {
+        s->vx += (ACCEL_FP * cos_fp_deg(s->angle)) >> FP_SHIFT;
+        s->vy += (ACCEL_FP * sin_fp_deg(s->angle)) >> FP_SHIFT;
+        if (s->vx > MAX_VELOCITY_FP) s->vx = MAX_VELOCITY_FP;
+        if (s->vx < -MAX_VELOCITY_FP) s->vx = -MAX_VELOCITY_FP;
+        if (s->vy > MAX_VELOCITY_FP) s->vy = MAX_VELOCITY_FP;
+        if (s->vy < -MAX_VELOCITY_FP) s->vy = -MAX_VELOCITY_FP;
+    }
+    // updatePlayer() moves the ship and applies friction, stepMatch() moves it again
+    s->x = wrapAxis(s->x + s->vx, PLAYER_SIZE, SCREEN_WIDTH);
+    s->y = wrapAxis(s->y + s->vy, PLAYER_SIZE, SCREEN_HEIGHT);
+    s->vx = s->vx * 253 / 256;
+    s->vy = s->vy * 253 / 256;
+    s->x = wrapAxis(s->x + s->vx, PLAYER_SIZE, SCREEN_WIDTH);
+    s->y = wrapAxis(s->y + s->vy, PLAYER_SIZE, SCREEN_HEIGHT);
+}
+
+// Pixels between the ship and the lines just off screen where large
+// asteroids appear without warning (spawnEdgeAsteroid())
+static int spawnClearance(int sx, int sy) {
+    int gap = sx + ASTEROID_SIZE_L;
+    if (SCREEN_WIDTH - sx < gap) gap = SCREEN_WIDTH - sx;
+    if (sy + ASTEROID_SIZE_L < gap) gap = sy + ASTEROID_SIZE_L;
+    if (SCREEN_HEIGHT - sy < gap) gap = SCREEN_HEIGHT - sy;
+    return gap - (getAsteroidRadius(ASTEROID_SIZE_L) - 1 + SHIP_REACH);
+}
+
+// Scores a plan; returns 0 as soon as it is sure to lose to 'bound' (if any)
+static int scorePlan(const ShipState *start, int heading, int burnFrames, const RockState *rocks, int count,
+                     const PlanScore *bound, PlanScore *score) {
+    ShipState s = *start;
+    RockState r[MAX_ASTEROIDS];
+    for (int i = 0; i < count; i++) r[i] = rocks[i];
+
+    score->hitFrame = PLAN_FRAMES + 1;
+    score->clearance = CLEARANCE_CAP;
+    int burn = burnFrames;
+    for (int t = 1; t <= PLAN_FRAMES; t++) {
+        int aligned = (s.angle == heading);
+        stepShip(&s, heading, burn > 0);
+        if (aligned && burn > 0) burn--;
+        int sx = FP_TO_INT(s.x) + PLAYER_SIZE / 2;
+        int sy = FP_TO_INT(s.y) + PLAYER_SIZE / 2;
+#ifndef EDGE_W
+#define EDGE_W 4
+#endif
+        int edge = spawnClearance(sx, sy) * EDGE_W / 4;
+        if (edge < score->clearance) score->clearance = edge;
+        for (int i = 0; i < count; i++) {
+            r[i].x = wrapAxis(r[i].x + r[i].vx, r[i].size, SCREEN_WIDTH);
+            r[i].y = wrapAxis(r[i].y + r[i].vy, r[i].size, SCREEN_HEIGHT);
+            // Collisions are tested on raw coordinates, not across the wrap
+            int gap = approxDistance(FP_TO_INT(r[i].x) - sx, FP_TO_INT(r[i].y) - sy) - r[i].reach;
+            if (gap < score->clearance) score->clearance = gap;
+            if (gap <= 0 && t < score->hitFrame) score->hitFrame = t;
+        }
+        if (score->hitFrame <= t) break;
+        // Against a plan that never touches anything, only clearance counts
+        if (bound && bound->hitFrame > PLAN_FRAMES && score->clearance < bound->clearance) return 0;
+    }
+    score->offCenter = approxDistance(FP_TO_INT(s.x) + PLAYER_SIZE / 2 - SCREEN_WIDTH / 2,
+                                      FP_TO_INT(s.y) + PLAYER_SIZE / 2 - SCREEN_HEIGHT / 2);
+    return 1;
+}
+
+static int betterPlan(const PlanScore *a, const PlanScore *b) {
+    if (a->hitFrame != b->hitFrame) return a->hitFrame > b->hitFrame;
+    if (a->clearance != b->clearance) return a->clearance > b->clearance;
+    return a->offCenter < b->offCenter;
+}
+
+// Returns the keys for the first frame of the best escape plan, or 0 with
+// *safe set when drifting already keeps SAFE_CLEARANCE from every asteroid
+static u16 planEscape(Autopilot *ap, const MatchContext *ctx, const GameObject *ship, const Asteroid asteroids[],
+                      int *safe) {
+    RockState rocks[MAX_ASTEROIDS];
+    int count = 0;
+    POOL_FOR_EACH(&ctx->asteroidPool, i) {
+        const GameObject *a = &asteroids[i].obj;
+        int r = getAsteroidRadius(asteroids[i].sizeType);
+        rocks[count].x = a->x;
+        rocks[count].y = a->y;
+        rocks[count].vx = a->velocityX;
+        rocks[count].vy = a->velocityY;
+        rocks[count].size = a->width;
+        // collisionWithAsteroid() trims a pixel off medium and large ones
+        rocks[count].reach = ((r <= 3) ? r : r - 1) + SHIP_REACH;
+        count++;
+    }
+
+    ShipState start = { ship->x, ship->y, ship->velocityX, ship->velocityY, ship->angle };
+    PlanScore best, score;
+    scorePlan(&start, ship->angle, 0, rocks, count, NULL, &best);
+    *safe = (best.hitFrame > PLAN_FRAMES && best.clearance >= SAFE_CLEARANCE);
+    if (*safe) return 0;
+
+    int bestHeading = -1;
+    if (ap->evading && scorePlan(&start, ap->planHeading, PLAN_BURN, rocks, count, &best, &score) &&
+        betterPlan(&score, &best)) {
+        best = score;
+        best.clearance += COMMIT;
+        bestHeading = ap->planHeading;
+    }
+    for (int heading = 0; heading < 360; heading += TURN_STEP_DEG) {
+        if (scorePlan(&start, heading, PLAN_BURN, rocks, count, &best, &score) && betterPlan(&score, &best)) {
+            best = score;
+            bestHeading = heading;
+        }
+    }
+    if (bestHeading >= 0) ap->planHeading = bestHeading;
+    if (bestHeading < 0) return 0;              // Drifting is still the best bet
+    if (bestHeading == ship->angle) return KEY_UP;
+    return steerTowards(ship->angle, bestHeading);
+}
+
+u16 autopilotKeys(Autopilot *ap, const MatchContext *ctx, const GameObject *ship, const Asteroid asteroids[],
+                  u16 *keysDown) {
+    u16 held = 0;
+    int dx, dy, flight;
+    *keysDown = 0;
+    if (ap->fireCooldown > 0) ap->fireCooldown--;
+
+    // Staying clear comes first: anything on a collision course hands the
+    // controls to the planner until drifting is safe again
+    int eta;
+    int threat = findNearestThreat(ctx, ship, asteroids, THREAT_HORIZON, THREAT_MARGIN, &dx, &dy, &eta);
+    int threatened = (threat >= 0);
+    int safe = 1;
+    if (threatened) held = planEscape(ap, ctx, ship, asteroids, &safe);
+    ap->evading = !safe;
+
+    // The threat itself is the better target while bullets can reach it:
+    // shooting it down may end the evasion
+    int target, desired;
+#ifdef TH
+    if (!threatened) threat = findNearestThreat(ctx, ship, asteroids, TH, THREAT_MARGIN, &dx, &dy, &eta);
+    if (threat >= 0 && straightDelta(ship, &asteroids[threat], &dx, &dy)) {
+#else
+    if (threatened && straightDelta(ship, &asteroids[threat], &dx, &dy)) {
+#endif
+        target = threat;
+        desired = leadAngle(&asteroids[target], dx, dy, &flight);
+    } else {
+        target = findTarget(ctx, ship, asteroids, &dx, &dy, &desired, &flight);
+    }
+    if (target < 0) return threatened ? held : holdStation(ship); // Nothing to shoot
+
+    // Aiming gets whatever turning the evasion and station keeping leave
+    // free; shots go out whenever they would hit, wherever the ship is headed. Station keeping waits
+    // until nothing is inbound: the planner has only cleared drifting, and a
+    // burn it never tried can steer straight back into the threat.
+    if (!threatened) held = holdStation(ship);
+    if (!held) held = steerTowards(ship->angle, desired);
+    int heading = headingAfter(ship->angle, held);
+    if (shotHits(ship, heading, &asteroids[target]) && fragmentsMiss(ship, &asteroids[target], dx, dy, flight) &&
+        muzzleClear(ctx, ship, heading, asteroids)) {
+        held |= fire(ap, keysDown);
+    }
+    return held;
+}
@@ -0,0 +1,26 @@
+#ifndef AUTOPILOT_H
+#define AUTOPILOT_H
+
+#include <gba_types.h>
+#include "game_objects.h"
+
+// --- Autoplay Bot ---
+// Produces the same key bitmasks a player would (KEY_UP/LEFT/RIGHT held,
+// KEY_A pressed to fire) so stepMatch()/updatePlayer() run unmodified.
+// Used for soak and stress testing, on hardware (AUTOPLAY build) or in the
+// host-side harnesses under tools/hostsim.
+
+typedef struct {
+    int fireCooldown;   // Frames until the next shot may be fired
+    int evading;        // Non-zero while sidestepping a threat
+    int planHeading;    // Heading of the escape plan being flown
+} Autopilot;
+
+void autopilotInit(Autopilot *ap);
+
+// Computes this frame's keys. Returns the held mask; *keysDown receives the
+// keys newly pressed this frame (the edge-triggered mask keysDown() would give).
+u16 autopilotKeys(Autopilot *ap, const MatchContext *ctx, const GameObject *ship, const Asteroid asteroids[],
+                  u16 *keysDown);
+
+#endif // AUTOPILOT_H
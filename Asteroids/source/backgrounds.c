@@ -0,0 +1,287 @@
+#include "backgrounds.h"
+
+#ifdef RENDER_TILED
+
+#include <gba_interrupt.h>
+#include <gba_video.h>
+#include <string.h>
+#include "graphics.h"
+#include "mem_ops.h"
+
+// The frame's pages take char blocks 0-1 and 2-3 up to 0x4B00 bytes in;
+// these tiles go in the gap after page 0, seen from char block 1
+#define SCENERY_CHAR_BASE   1
+#define BLANK_TILE          96  // First tile past page 0
+#define STAR_TILE           (BLANK_TILE + 1)
+#define STAR_TILE_COUNT     4   // Two far (dim), two near (bright)
+#define GLYPH_TILE          (STAR_TILE + STAR_TILE_COUNT) // One per character ' '..'Z'
+#define GLYPH_FIRST         ' '
+#define GLYPH_LAST          'Z'
+#define HUD_TILE            (GLYPH_TILE + (GLYPH_LAST - GLYPH_FIRST + 1))
+#define HUD_COLS            (SCREEN_WIDTH / 8)
+#define HUD_ROWS            2   // One strip of unique tiles per text row
+
+// Screen blocks below the frame's map (31)
+#define HUD_MAP_BLOCK       27
+#define FAR_MAP_BLOCK       28
+#define NEAR_MAP_BLOCK      29
+#define CREDITS_MAP_BLOCK   30
+#define MAP_SIZE            32  // 32x32 entries: 256 pixels, wrapping
+
+#define SCENERY_PALBANK     1
+#define CLR_STAR_DIM        1
+#define CLR_STAR_BRIGHT     2
+#define CLR_CREDITS_TEXT    3
+
+// Scroll speeds in 1/256 pixels per VBlank
+#define FAR_SPEED           0x40
+#define NEAR_SPEED          0xC0
+#define ROLL_SPEED          0x80
+
+// The roll shows in the top of the credits screen, above the MAIN MENU
+// option, and enters from the bottom of that band
+#define ROLL_BOTTOM         (END_TEXT_Y + LINE_HEIGHT)
+#define CREDIT_ROW_STEP     2   // Map rows per credits line
+
+// The HUD rows are not on the tile grid: scrolling BG0 down by HUD_VOFS
+// lines both up with map rows
+#define HUD_VOFS            ((8 - SCORE_Y % 8) % 8)
+#if (PLAYER_SYM_Y - SCORE_Y) % 8
+#error "HUD text rows must be a whole number of tiles apart"
+#endif
+#define HUD_TEXT_MAX        24
+
+static const char *const CREDIT_LINES[] = {
+    "ASTEROIDS",
+    "",
+    "MADE BY",
+    "TAYLOR BOESE",
+    "",
+    "THANKS FOR PLAYING!",
+};
+
+typedef struct {
+    s16 x, y;
+    u16 color;
+    char text[HUD_TEXT_MAX];
+} HudItem;
+
+static volatile u16 s_layers = 0;
+// Slots as last set, and as drawn into the strips by the VBlank handler
+static HudItem s_hudPending[HUD_SLOT_COUNT];
+static HudItem s_hudShown[HUD_SLOT_COUNT];
+static volatile u8 s_hudDirty = 0; // One bit per slot
+static u32 s_farX = 0, s_nearX = 0; // Scroll positions, 8.8 fixed point
+static u32 s_rollY = 0;
+
+static inline u32 *sceneryTile(int tile) {
+    return (u32 *)CHAR_BASE_ADR(SCENERY_CHAR_BASE) + tile * 8;
+}
+
+static inline u16 mapEntry(int tile) {
+    return tile | (SCENERY_PALBANK << 12);
+}
+
+// 4bpp tile rows are u32s with pixel x in bits 4x..4x+3
+static void plotTilePixel(int tile, int x, int y, u32 color) {
+    sceneryTile(tile)[y] |= color << (x * 4);
+}
+
+static void buildTiles(void) {
+    memFill32(sceneryTile(BLANK_TILE), 0, (HUD_TILE + HUD_ROWS * HUD_COLS - BLANK_TILE) * 32);
+
+    // Single far stars and small near crosses, off-center so the grid
+    // does not show
+    plotTilePixel(STAR_TILE + 0, 2, 5, CLR_STAR_DIM);
+    plotTilePixel(STAR_TILE + 1, 6, 1, CLR_STAR_DIM);
+    plotTilePixel(STAR_TILE + 2, 4, 3, CLR_STAR_BRIGHT);
+    plotTilePixel(STAR_TILE + 3, 1, 6, CLR_STAR_BRIGHT);
+    plotTilePixel(STAR_TILE + 3, 2, 6, CLR_STAR_BRIGHT);
+    plotTilePixel(STAR_TILE + 3, 1, 7, CLR_STAR_BRIGHT);
+
+    for (char c = GLYPH_FIRST; c <= GLYPH_LAST; c++) {
+        const bool *glyph = charGlyph(c);
+        if (!glyph) continue;
+        for (int y = 0; y < CHAR_PIX_SIZE; y++) {
+            for (int x = 0; x < CHAR_PIX_SIZE; x++) {
+                if (glyph[y * CHAR_PIX_SIZE + x]) {
+                    plotTilePixel(GLYPH_TILE + (c - GLYPH_FIRST), x, y, CLR_CREDITS_TEXT);
+                }
+            }
+        }
+    }
+}
+
+// Scatters one of the two star tiles at 'firstTile' over about one map
+// entry in 'oneIn'
+static void buildStarMap(int block, int firstTile, int oneIn, u32 seed) {
+    u16 *map = (u16 *)SCREEN_BASE_BLOCK(block);
+    for (int i = 0; i < MAP_SIZE * MAP_SIZE; i++) {
+        // xorshift32: a fixed seed gives the same sky every boot
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        int tile = (seed % oneIn) ? BLANK_TILE : firstTile + ((seed >> 16) & 1);
+        map[i] = mapEntry(tile);
+    }
+}
+
+static void buildCreditsMap(void) {
+    u16 *map = (u16 *)SCREEN_BASE_BLOCK(CREDITS_MAP_BLOCK);
+    memFill16(map, mapEntry(BLANK_TILE), MAP_SIZE * MAP_SIZE * 2);
+
+    for (unsigned line = 0; line < sizeof(CREDIT_LINES) / sizeof(CREDIT_LINES[0]); line++) {
+        const char *text = CREDIT_LINES[line];
+        int len = strlen(text);
+        u16 *row = map + line * CREDIT_ROW_STEP * MAP_SIZE + (SCREEN_WIDTH / 8 - len) / 2;
+        for (int i = 0; i < len; i++) {
+            char c = text[i];
+            if (c >= GLYPH_FIRST && c <= GLYPH_LAST) row[i] = mapEntry(GLYPH_TILE + (c - GLYPH_FIRST));
+        }
+    }
+}
+
+// Text row of a HUD y, or -1
+static int hudRow(int y) {
+    if (y == SCORE_Y) return 0;
+    if (y == PLAYER_SYM_Y) return 1;
+    return -1;
+}
+
+// Each HUD row maps a strip of its own tiles, so text lands at any x
+static void buildHudMap(void) {
+    u16 *map = (u16 *)SCREEN_BASE_BLOCK(HUD_MAP_BLOCK);
+    memFill16(map, mapEntry(BLANK_TILE), MAP_SIZE * MAP_SIZE * 2);
+
+    static const int rowY[HUD_ROWS] = { SCORE_Y, PLAYER_SYM_Y };
+    for (int row = 0; row < HUD_ROWS; row++) {
+        // Frame palette (bank 0): text pixels are CLR_* indices
+        u16 *line = map + (rowY[row] + HUD_VOFS) / 8 * MAP_SIZE;
+        for (int col = 0; col < HUD_COLS; col++) line[col] = HUD_TILE + row * HUD_COLS + col;
+    }
+}
+
+// Replaces the 8 pixels of a strip's line 'y' from pixel x with 'bits'
+// (4bpp, pixel 0 lowest); they may straddle two tiles
+static void hudPutRow(int row, int x, int y, u32 bits) {
+    int col = x >> 3;
+    int shift = (x & 7) * 4;
+    u32 *lo = sceneryTile(HUD_TILE + row * HUD_COLS + col) + y;
+    *lo = (*lo & ~(0xFFFFFFFFu << shift)) | (bits << shift);
+    if (shift && col + 1 < HUD_COLS) {
+        u32 *hi = lo + 8; // Same line of the next tile
+        *hi = (*hi & ~(0xFFFFFFFFu >> (32 - shift))) | (bits >> (32 - shift));
+    }
+}
+
+// Draws (or with erase, blanks) a slot's text cells
+static void hudDrawItem(const HudItem *item, bool erase) {
+    int row = hudRow(item->y);
+    if (row < 0) return;
+    for (int i = 0; item->text[i]; i++) {
+        int x = item->x + i * CHAR_PIX_SIZE;
+        if (x < 0 || x > SCREEN_WIDTH - CHAR_PIX_SIZE) continue;
+        const bool *glyph = erase ? NULL : charGlyph(item->text[i]);
+        for (int y = 0; y < CHAR_PIX_SIZE; y++) {
+            u32 bits = 0;
+            for (int px = 0; glyph && px < CHAR_PIX_SIZE; px++) {
+                if (glyph[y * CHAR_PIX_SIZE + px]) bits |= (u32)item->color << (px * 4);
+            }
+            hudPutRow(row, x, y, bits);
+        }
+    }
+}
+
+void initBackgrounds(void) {
+    BG_PALETTE[SCENERY_PALBANK * 16 + CLR_STAR_DIM]     = RGB5(10, 10, 16);
+    BG_PALETTE[SCENERY_PALBANK * 16 + CLR_STAR_BRIGHT]  = RGB5(24, 24, 31);
+    BG_PALETTE[SCENERY_PALBANK * 16 + CLR_CREDITS_TEXT] = RGB5(31, 31, 31);
+
+    buildTiles();
+    buildStarMap(FAR_MAP_BLOCK, STAR_TILE + 0, 10, 0x2545F491u);
+    buildStarMap(NEAR_MAP_BLOCK, STAR_TILE + 2, 24, 0x9E3779B9u);
+    buildCreditsMap();
+    buildHudMap();
+
+    // Behind the game's BG2 (priority 0), whose index 0 is transparent;
+    // backgroundsVBlank() sets up BG0 for the credits or the HUD
+    REG_BG1CNT = CHAR_BASE(SCENERY_CHAR_BASE) | SCREEN_BASE(NEAR_MAP_BLOCK) | BG_16_COLOR | BG_PRIORITY(2);
+    REG_BG3CNT = CHAR_BASE(SCENERY_CHAR_BASE) | SCREEN_BASE(FAR_MAP_BLOCK) | BG_16_COLOR | BG_PRIORITY(3);
+
+    // Window 0 keeps the roll to its band; BG1-3 and sprites show everywhere
+    REG_WIN0H = SCREEN_WIDTH;       // Left 0, right SCREEN_WIDTH
+    REG_WIN0V = ROLL_BOTTOM;        // Top 0
+    REG_WININ = 0x1F;               // BG0-3 and OBJ inside
+    REG_WINOUT = 0x1E;              // All but BG0 outside
+}
+
+void backgroundsShow(u16 layers) {
+    if (layers == s_layers) return;
+    // The VBlank handler scrolls by s_layers; restart the roll with it off
+    u16 ime = REG_IME;
+    REG_IME = 0;
+    if ((layers & BGL_CREDITS) && !(s_layers & BGL_CREDITS)) s_rollY = 0;
+    s_layers = layers;
+    REG_IME = ime;
+}
+
+void hudText(int slot, int x, int y, const char *text, u16 color) {
+    if (slot < 0 || slot >= HUD_SLOT_COUNT) return;
+    HudItem item;
+    item.x = x;
+    item.y = y;
+    item.color = color;
+    strncpy(item.text, text, HUD_TEXT_MAX - 1);
+    item.text[HUD_TEXT_MAX - 1] = '\0';
+
+    HudItem *pending = &s_hudPending[slot];
+    if (pending->x == item.x && pending->y == item.y && pending->color == item.color &&
+        strcmp(pending->text, item.text) == 0) return;
+    // The VBlank handler reads the pending slots
+    u16 ime = REG_IME;
+    REG_IME = 0;
+    *pending = item;
+    s_hudDirty |= 1 << slot;
+    REG_IME = ime;
+}
+
+// Redraws the changed HUD slots while their rows are not being displayed
+static void hudVBlank(void) {
+    u8 dirty = s_hudDirty;
+    if (!dirty) return;
+    for (int slot = 0; slot < HUD_SLOT_COUNT; slot++) {
+        if (!(dirty & (1 << slot))) continue;
+        hudDrawItem(&s_hudShown[slot], true);
+        s_hudShown[slot] = s_hudPending[slot];
+        hudDrawItem(&s_hudShown[slot], false);
+    }
+    s_hudDirty = 0;
+}
+
+void backgroundsVBlank(void) {
+    u16 layers = s_layers;
+    u16 enable = 0;
+    if (layers & BGL_STARFIELD) {
+        s_farX += FAR_SPEED;
+        s_nearX += NEAR_SPEED;
+        REG_BG3HOFS = s_farX >> 8;
+        REG_BG1HOFS = s_nearX >> 8;
+        enable |= BG1_ON | BG3_ON;
+    }
+    if (layers & BGL_CREDITS) {
+        // Map row 0 starts just below the band and rolls up through it
+        REG_BG0CNT = CHAR_BASE(SCENERY_CHAR_BASE) | SCREEN_BASE(CREDITS_MAP_BLOCK) | BG_16_COLOR | BG_PRIORITY(1);
+        REG_BG0VOFS = (s_rollY >> 8) - ROLL_BOTTOM;
+        s_rollY += ROLL_SPEED;
+        enable |= BG0_ON | WIN0_ON;
+    } else if (layers & BGL_HUD) {
+        // In front of BG2: same priority, lower BG number
+        REG_BG0CNT = CHAR_BASE(SCENERY_CHAR_BASE) | SCREEN_BASE(HUD_MAP_BLOCK) | BG_16_COLOR | BG_PRIORITY(0);
+        REG_BG0VOFS = HUD_VOFS;
+        enable |= BG0_ON;
+    }
+    hudVBlank();
+    REG_DISPCNT = (REG_DISPCNT & ~(BG0_ON | BG1_ON | BG3_ON | WIN0_ON)) | enable;
+}
+
+#endif // RENDER_TILED
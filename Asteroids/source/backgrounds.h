@@ -0,0 +1,44 @@
+#ifndef BACKGROUNDS_H
+#define BACKGROUNDS_H
+
+#include <gba_types.h>
+
+// --- Scrolling Backgrounds ---
+// The tiled renderer (RENDERER=tiled) draws the game into BG2, which leaves
+// three tile backgrounds: a two-layer parallax starfield behind gameplay
+// (BG3 far, BG1 near), and BG0 for the credits roll or the match HUD. Their
+// tiles and maps are built once; after that the VBlank handler only writes
+// scroll registers, so they cost the frame nothing. The bitmap renderers
+// have no tile backgrounds and these do nothing there.
+#define BGL_STARFIELD   (1 << 0)
+#define BGL_CREDITS     (1 << 1)
+#define BGL_HUD         (1 << 2) // Not with BGL_CREDITS: both are BG0
+
+// HUD text slots. Each holds one string on the score row (SCORE_Y) or the
+// bottom row (PLAYER_SYM_Y), at any x.
+enum { HUD_SCORE, HUD_LIVES, HUD_HIGH, HUD_PERF, HUD_SLOT_COUNT };
+
+#ifdef RENDER_TILED
+// Builds the tiles and maps; called by initGraphics()
+void initBackgrounds(void);
+
+// Layers (BGL_*) shown from the next VBlank; the credits roll restarts each
+// time it appears
+void backgroundsShow(u16 layers);
+
+// Sets a HUD slot's text ("" clears it) in a CLR_* color. Only changes are
+// redrawn, by the VBlank handler, so calling it every frame costs a compare.
+void hudText(int slot, int x, int y, const char *text, u16 color);
+
+// Called from the VBlank handler
+void backgroundsVBlank(void);
+#else
+static inline void initBackgrounds(void) {}
+static inline void backgroundsShow(u16 layers) { (void)layers; }
+static inline void hudText(int slot, int x, int y, const char *text, u16 color) {
+    (void)slot; (void)x; (void)y; (void)text; (void)color;
+}
+static inline void backgroundsVBlank(void) {}
+#endif
+
+#endif // BACKGROUNDS_H
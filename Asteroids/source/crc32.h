@@ -0,0 +1,18 @@
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <gba_types.h>
+
+// --- CRC-32 ---
+// The zlib/PNG CRC (reflected polynomial 0xEDB88320), one table lookup per
+// byte from a 1 KB table in ROM. Start with CRC32_INIT, feed the data in
+// any number of pieces, and finish with crc32Final().
+#define CRC32_INIT 0xFFFFFFFFu
+
+u32 crc32Update(u32 crc, const void *data, u32 bytes);
+
+static inline u32 crc32Final(u32 crc) {
+    return crc ^ 0xFFFFFFFFu;
+}
+
+#endif // CRC32_H
@@ -0,0 +1,28 @@
+#include <gba_types.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include "debug_log.h"
+
+// mGBA debug registers
+#define REG_DEBUG_ENABLE (*(vu16*)0x4FFF780)
+#define REG_DEBUG_FLAGS  (*(vu16*)0x4FFF700)
+#define REG_DEBUG_STRING ((char*)0x4FFF600)
+#define DEBUG_STRING_LEN 256
+#define DEBUG_FLAG_SEND  0x100
+
+static bool s_enabled = false;
+
+bool debugLogInit(void) {
+    REG_DEBUG_ENABLE = 0xC0DE;
+    s_enabled = (REG_DEBUG_ENABLE == 0x1DEA);
+    return s_enabled;
+}
+
+void debugLog(int level, const char *fmt, ...) {
+    if (!s_enabled) return;
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(REG_DEBUG_STRING, DEBUG_STRING_LEN, fmt, args);
+    va_end(args);
+    REG_DEBUG_FLAGS = (level & 0x7) | DEBUG_FLAG_SEND;
+}
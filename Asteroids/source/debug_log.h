@@ -0,0 +1,20 @@
+#ifndef DEBUG_LOG_H
+#define DEBUG_LOG_H
+
+#include <stdbool.h>
+
+// --- Emulator Debug Output ---
+// Writes lines to mGBA's debug log (Tools > View Logs, or stdout with -l).
+// On hardware or other emulators the calls are silently ignored.
+
+#define DEBUG_LOG_FATAL 0
+#define DEBUG_LOG_ERROR 1
+#define DEBUG_LOG_WARN  2
+#define DEBUG_LOG_INFO  3
+#define DEBUG_LOG_DEBUG 4
+
+// Returns true if the emulator accepted the debug-output handshake
+bool debugLogInit(void);
+void debugLog(int level, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+#endif // DEBUG_LOG_H
@@ -0,0 +1,203 @@
+#include <stddef.h>
+#include "display_list.h"
+#include "graphics.h"
+#include "mem_ops.h"
+
+#define DL_BANDS        (SCREEN_HEIGHT / DL_BAND_LINES)
+#define DL_MAX_COMMANDS 192
+#define DL_MAX_NODES    512 // Bin entries: a command takes one per band it touches
+#define DL_NIL          0xFFFF
+#define STRIP_BYTES     (sizeof(FRAMELINE) * DL_BAND_LINES)
+
+#if FRAME_ROW_ALIGN > DL_BAND_LINES || DL_BAND_LINES % FRAME_ROW_ALIGN
+#error "display list bands must be whole frame rows"
+#endif
+
+enum { DL_PIXEL, DL_LINE, DL_CIRCLE, DL_GLYPH, DL_STAMP, DL_FILL, DL_ROWS };
+
+typedef struct {
+    u8 op;
+    u8 step;        // DL_CIRCLE
+    u16 color;
+    s16 x, y;
+    s16 a, b;       // Line end, circle radius, stamp handle, fill size, row count
+    const void *glyph;  // Glyph, or DL_ROWS source rows
+} DLCommand;
+
+typedef struct {
+    u16 command;
+    u16 next;
+} DLNode;
+
+bool dl_recording = false;
+
+static DLCommand s_commands[DL_MAX_COMMANDS];
+static DLNode s_nodes[DL_MAX_NODES];
+static int s_commandCount = 0;
+static int s_nodeCount = 0;
+static u16 s_binHead[DL_BANDS];
+static u16 s_binTail[DL_BANDS];
+static bool s_cleared = false; // Strips start zeroed instead of from back_buffer
+
+// The band being rasterized
+static FRAMELINE s_strip[DL_BAND_LINES];
+
+static void resetBins(void) {
+    s_commandCount = 0;
+    s_nodeCount = 0;
+    for (int b = 0; b < DL_BANDS; b++) {
+        s_binHead[b] = DL_NIL;
+        s_binTail[b] = DL_NIL;
+    }
+}
+
+static void executeCommand(const DLCommand *c) {
+    switch (c->op) {
+    case DL_PIXEL:  setPixel(c->x, c->y, c->color); break;
+    case DL_LINE:   drawLine(c->x, c->y, c->a, c->b, c->color); break;
+    case DL_CIRCLE: drawCircleStep(c->x, c->y, c->a, c->color, c->step); break;
+    case DL_GLYPH:  printCharColor(c->glyph, c->x, c->y, c->color); break;
+    case DL_STAMP:  drawStamp(c->a, c->x, c->y, c->color); break;
+    case DL_FILL:   clearRegion(c->x, c->y, c->a, c->b); break;
+    case DL_ROWS:   copyRows(c->glyph, c->y, c->a); break;
+    }
+}
+
+// Rasterizes the recorded bands into back_buffer and empties the bins
+static void rasterize(void) {
+    FRAMELINE *target = back_buffer;
+    dl_recording = false;
+
+    for (int band = 0; band < DL_BANDS; band++) {
+        int top = band * DL_BAND_LINES;
+        if (s_binHead[band] == DL_NIL) {
+            // Nothing drawn here: cleared bands are zero-filled in place
+            if (s_cleared) memDmaFill32(target[top], 0, STRIP_BYTES);
+            continue;
+        }
+        if (s_cleared) memDmaFill32(s_strip, 0, STRIP_BYTES);
+        else           memDmaCopy32(s_strip, target[top], STRIP_BYTES);
+
+        // The drawing functions address rows by screen y: point back_buffer
+        // so row 'top' is the strip's first, and clip to the band
+        back_buffer = s_strip - top;
+        setDrawRows(top, top + DL_BAND_LINES);
+        for (u16 n = s_binHead[band]; n != DL_NIL; n = s_nodes[n].next) {
+            executeCommand(&s_commands[s_nodes[n].command]);
+        }
+        back_buffer = target;
+        memDmaCopy32(target[top], s_strip, STRIP_BYTES);
+    }
+    setDrawRows(0, SCREEN_HEIGHT);
+    resetBins();
+}
+
+// Appends a command covering rows [top, bottom] to its bands; returns NULL
+// for commands entirely off screen. A full list is rasterized first, and
+// later commands draw over the result.
+static DLCommand *addCommand(u8 op, int top, int bottom) {
+    if (top < 0) top = 0;
+    if (bottom >= SCREEN_HEIGHT) bottom = SCREEN_HEIGHT - 1;
+    if (top > bottom) return NULL;
+    int first = top / DL_BAND_LINES;
+    int last = bottom / DL_BAND_LINES;
+
+    if (s_commandCount >= DL_MAX_COMMANDS || s_nodeCount + (last - first + 1) > DL_MAX_NODES) {
+        rasterize();
+        s_cleared = false;
+        dl_recording = true;
+    }
+
+    int index = s_commandCount++;
+    for (int band = first; band <= last; band++) {
+        DLNode *node = &s_nodes[s_nodeCount];
+        node->command = index;
+        node->next = DL_NIL;
+        if (s_binTail[band] == DL_NIL) s_binHead[band] = s_nodeCount;
+        else                           s_nodes[s_binTail[band]].next = s_nodeCount;
+        s_binTail[band] = s_nodeCount++;
+    }
+
+    DLCommand *c = &s_commands[index];
+    c->op = op;
+    return c;
+}
+
+void displayListBegin(void) {
+    resetBins();
+    s_cleared = false;
+    dl_recording = true;
+}
+
+void displayListEnd(void) {
+    if (!dl_recording) return;
+    rasterize();
+}
+
+void displayListClear(void) {
+    resetBins();
+    s_cleared = true;
+}
+
+void displayListPixel(int x, int y, u16 color) {
+    DLCommand *c = addCommand(DL_PIXEL, y, y);
+    if (!c) return;
+    c->color = color;
+    c->x = x;
+    c->y = y;
+}
+
+void displayListLine(int x0, int y0, int x1, int y1, u16 color) {
+    DLCommand *c = addCommand(DL_LINE, (y0 < y1) ? y0 : y1, (y0 < y1) ? y1 : y0);
+    if (!c) return;
+    c->color = color;
+    c->x = x0;
+    c->y = y0;
+    c->a = x1;
+    c->b = y1;
+}
+
+void displayListCircle(int cx, int cy, int radius, u16 color, int step) {
+    DLCommand *c = addCommand(DL_CIRCLE, cy - radius, cy + radius);
+    if (!c) return;
+    c->color = color;
+    c->step = step;
+    c->x = cx;
+    c->y = cy;
+    c->a = radius;
+}
+
+void displayListGlyph(const bool *glyph, int x, int y, u16 color) {
+    DLCommand *c = addCommand(DL_GLYPH, y, y + CHAR_PIX_SIZE - 1);
+    if (!c) return;
+    c->color = color;
+    c->x = x;
+    c->y = y;
+    c->glyph = glyph;
+}
+
+void displayListStamp(int stamp, int cx, int cy, int side, u16 color) {
+    DLCommand *c = addCommand(DL_STAMP, cy - side / 2, cy - side / 2 + side - 1);
+    if (!c) return;
+    c->color = color;
+    c->x = cx;
+    c->y = cy;
+    c->a = stamp;
+}
+
+void displayListFill(int x, int y, int w, int h) {
+    DLCommand *c = addCommand(DL_FILL, y, y + h - 1);
+    if (!c) return;
+    c->x = x;
+    c->y = y;
+    c->a = w;
+    c->b = h;
+}
+
+void displayListRows(const void *rows, int y, int height) {
+    DLCommand *c = addCommand(DL_ROWS, y, y + height - 1);
+    if (!c) return;
+    c->glyph = rows;
+    c->y = y;
+    c->a = height;
+}
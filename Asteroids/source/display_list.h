@@ -0,0 +1,47 @@
+#ifndef DISPLAY_LIST_H
+#define DISPLAY_LIST_H
+
+#include <gba_types.h>
+#include <stdbool.h>
+
+// --- Binned Display List ---
+// Between displayListBegin() and displayListEnd() the drawing functions of
+// graphics.h record commands instead of writing back_buffer. Each command is
+// binned into every DL_BAND_LINES-row band it touches. displayListEnd()
+// then rasterizes band by band into a strip in IWRAM (32-bit, no wait
+// states) and DMAs each finished strip to back_buffer: one write per pixel
+// there, instead of a read-modify-write per primitive.
+//
+// The paletted renderers' back_buffer is the hidden VRAM page, so strips
+// land in VRAM directly. Mode 3 has a single page, which is on screen
+// while the next frame is drawn (frame_pipeline.h), so writing strips to it
+// would tear. Strips go to an EWRAM back buffer instead, and the VBlank
+// handler DMAs the finished frame to VRAM. That adds a read per pixel in
+// EWRAM, but lets drawing run ahead of the display.
+//
+// A recorded clearScreen() drops the commands before it and makes every
+// strip start zeroed, so clearing costs nothing. Without one, bands with
+// commands start from back_buffer's contents and bands without any are
+// left alone, as immediate drawing would.
+#define DL_BAND_LINES   8   // Whole tile rows in the tiled renderer
+
+extern bool dl_recording;
+
+static inline bool displayListRecording(void) {
+    return dl_recording;
+}
+
+void displayListBegin(void);
+void displayListEnd(void);
+
+// Recording (called by graphics.c while displayListRecording())
+void displayListClear(void);
+void displayListPixel(int x, int y, u16 color);
+void displayListLine(int x0, int y0, int x1, int y1, u16 color);
+void displayListCircle(int cx, int cy, int radius, u16 color, int step);
+void displayListGlyph(const bool *glyph, int x, int y, u16 color);
+void displayListStamp(int stamp, int cx, int cy, int side, u16 color);
+void displayListFill(int x, int y, int w, int h); // clearRegion()
+void displayListRows(const void *rows, int y, int height); // copyRows()
+
+#endif // DISPLAY_LIST_H
@@ -0,0 +1,49 @@
+#include <gba_systemcalls.h>
+#include "fixed_math.h"
+
+// Generated: ceil(2^24 / d). With num < 256 * d the product num * r fits in
+// 32 bits and (num * r) >> 24 equals num / d exactly (checked exhaustively).
+const u32 FX_RECIP24[FX_RECIP_MAX + 1] = {
+    0x000000, 0x1000000, 0x800000, 0x555556, 0x400000, 0x333334, 0x2AAAAB, 0x24924A,
+    0x200000, 0x1C71C8, 0x19999A, 0x1745D2, 0x155556, 0x13B13C, 0x124925, 0x111112,
+    0x100000, 0x0F0F10, 0x0E38E4, 0x0D7944, 0x0CCCCD, 0x0C30C4, 0x0BA2E9, 0x0B2165,
+    0x0AAAAB, 0x0A3D71, 0x09D89E, 0x097B43, 0x092493, 0x08D3DD, 0x088889, 0x084211,
+    0x080000, 0x07C1F1, 0x078788, 0x075076, 0x071C72, 0x06EB3F, 0x06BCA2, 0x06906A,
+    0x066667, 0x063E71, 0x061862, 0x05F418, 0x05D175, 0x05B05C, 0x0590B3, 0x057263,
+    0x055556, 0x053979, 0x051EB9, 0x050506, 0x04EC4F, 0x04D488, 0x04BDA2, 0x04A791,
+    0x04924A, 0x047DC2, 0x0469EF, 0x0456C8, 0x044445, 0x04325D, 0x042109, 0x041042,
+    0x040000, 0x03F040, 0x03E0F9, 0x03D227, 0x03C3C4, 0x03B5CD, 0x03A83B, 0x039B0B,
+    0x038E39, 0x0381C1, 0x0375A0, 0x0369D1, 0x035E51, 0x03531E, 0x034835, 0x033D92,
+    0x033334, 0x032917, 0x031F39, 0x031598, 0x030C31, 0x030304, 0x02FA0C, 0x02F14A,
+    0x02E8BB, 0x02E05D, 0x02D82E, 0x02D02E, 0x02C85A, 0x02C0B1, 0x02B932, 0x02B1DB,
+    0x02AAAB, 0x02A3A1, 0x029CBD, 0x0295FB, 0x028F5D, 0x0288E0, 0x028283, 0x027C46,
+    0x027628, 0x027028, 0x026A44, 0x02647D, 0x025ED1, 0x025940, 0x0253C9, 0x024E6B,
+    0x024925, 0x0243F7, 0x023EE1, 0x0239E1, 0x0234F8, 0x023024, 0x022B64, 0x0226BA,
+    0x022223, 0x021D9F, 0x02192F, 0x0214D1, 0x021085, 0x020C4A, 0x020821, 0x020409,
+    0x020000, 0x01FC08, 0x01F820, 0x01F447, 0x01F07D, 0x01ECC1, 0x01E914, 0x01E574,
+    0x01E1E2, 0x01DE5E, 0x01DAE7, 0x01D77C, 0x01D41E, 0x01D0CC, 0x01CD86, 0x01CA4C,
+    0x01C71D, 0x01C3F9, 0x01C0E1, 0x01BDD3, 0x01BAD0, 0x01B7D7, 0x01B4E9, 0x01B204,
+    0x01AF29, 0x01AC58, 0x01A98F, 0x01A6D1, 0x01A41B, 0x01A16E, 0x019EC9, 0x019C2E,
+    0x01999A, 0x01970F, 0x01948C, 0x019210, 0x018F9D, 0x018D31, 0x018ACC, 0x01886F,
+    0x018619, 0x0183CA, 0x018182, 0x017F41, 0x017D06, 0x017AD3, 0x0178A5, 0x01767E,
+    0x01745E, 0x017243, 0x01702F, 0x016E20, 0x016C17, 0x016A14, 0x016817, 0x01661F,
+    0x01642D, 0x016240, 0x016059, 0x015E76, 0x015C99, 0x015AC1, 0x0158EE, 0x01571F,
+    0x015556, 0x015391, 0x0151D1, 0x015016, 0x014E5F, 0x014CAC, 0x014AFE, 0x014954,
+    0x0147AF, 0x01460D, 0x014470, 0x0142D7, 0x014142, 0x013FB1, 0x013E23, 0x013C9A,
+    0x013B14, 0x013992, 0x013814, 0x013699, 0x013522, 0x0133AF, 0x01323F, 0x0130D2,
+    0x012F69, 0x012E03, 0x012CA0, 0x012B41, 0x0129E5, 0x01288C, 0x012736, 0x0125E3,
+    0x012493, 0x012346, 0x0121FC, 0x0120B5, 0x011F71, 0x011E2F, 0x011CF1, 0x011BB5,
+    0x011A7C, 0x011946, 0x011812, 0x0116E1, 0x0115B2, 0x011486, 0x01135D, 0x011236,
+    0x011112, 0x010FF0, 0x010ED0, 0x010DB3, 0x010C98, 0x010B7F, 0x010A69, 0x010954,
+    0x010843, 0x010733, 0x010625, 0x01051A, 0x010411, 0x01030A, 0x010205, 0x010102,
+};
+
+s32 fxDiv(s32 num, s32 den) {
+    if (den == 0) return (num < 0) ? -0x7FFFFFFF : 0x7FFFFFFF;
+    return Div(num, den);
+}
+
+u32 fxDivSlow(u32 num, u32 den) {
+    if (den == 0) return 0xFFFFFFFFu;
+    return (u32)Div((s32)num, (s32)den);
+}
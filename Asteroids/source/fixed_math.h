@@ -0,0 +1,125 @@
+#ifndef FIXED_MATH_H
+#define FIXED_MATH_H
+
+#include <gba_base.h>
+#include <gba_types.h>
+
+// --- Division-Free Fixed-Point Math ---
+// The ARM7TDMI has no divide instruction and Thumb code has no long
+// multiply, so every non-power-of-two '/' or '%' in C becomes a call into
+// libgcc (__aeabi_idiv and friends, 40-150 cycles each). The helpers here
+// keep the per-frame code off those calls: divisions go through a reciprocal
+// table (small divisors) or the BIOS Div SWI, wrapping counters are kept in
+// range by compare-and-subtract, and power-of-two moduli become masks.
+// 'make check-divs' lists any libgcc divide still referenced by the hot
+// modules; 'make FXBENCH=1' builds the timing benchmark in fixed_math_bench.c.
+
+// Q formats. fx8 is the 24.8 format of every position, velocity and
+// trig value (FP_* in game_objects.h); fx16 is 16.16 for ratios that need
+// more fraction bits.
+typedef s32 fx8;
+typedef s32 fx16;
+
+#define FX8_SHIFT   8
+#define FX8_ONE     (1 << FX8_SHIFT)
+#define FX16_SHIFT  16
+#define FX16_ONE    (1 << FX16_SHIFT)
+
+// Largest divisor served by the reciprocal table
+#define FX_RECIP_MAX 255
+
+// ceil(2^24 / d) for d in 1..FX_RECIP_MAX (entry 0 unused)
+extern const u32 FX_RECIP24[FX_RECIP_MAX + 1];
+
+// --- Conversion and rounding ---
+
+static inline fx8 fx8FromInt(int x) { return x << FX8_SHIFT; }
+
+// Truncates towards minus infinity (same as FP_TO_INT)
+static inline int fx8Floor(fx8 x) { return x >> FX8_SHIFT; }
+
+// Rounds to the nearest integer, halves away from zero
+static inline int fx8Round(fx8 x) {
+    return (x >= 0) ? (x + (FX8_ONE >> 1)) >> FX8_SHIFT
+                    : -((-x + (FX8_ONE >> 1)) >> FX8_SHIFT);
+}
+
+static inline s32 fxClamp(s32 x, s32 lo, s32 hi) {
+    return (x < lo) ? lo : (x > hi) ? hi : x;
+}
+
+// Clamps to the s16 range used by OAM affine parameters and sound samples
+static inline s32 fxSat16(s32 x) { return fxClamp(x, -32768, 32767); }
+
+// --- Multiplication ---
+
+// 24.8 product rounded to nearest. The 32-bit intermediate overflows once
+// |a * b| reaches 2^31, i.e. for operands beyond about +-181.0 each.
+static inline fx8 fx8Mul(fx8 a, fx8 b) {
+    return (a * b + (FX8_ONE >> 1)) >> FX8_SHIFT;
+}
+
+// Full-range 24.8 product through a 64-bit smull (ARM code in IWRAM; Thumb
+// would call __aeabi_lmul instead)
+IWRAM_CODE fx8 fx8MulLong(fx8 a, fx8 b);
+
+// Maps a 16-bit value (e.g. random bits) uniformly onto [0, n) with one
+// multiply; n up to 65535
+static inline int fxRange16(u32 bits16, u32 n) {
+    return (int)(((bits16 & 0xFFFF) * n) >> 16);
+}
+
+// --- Division ---
+
+// Signed quotient rounded towards zero, through the BIOS Div SWI (no libgcc)
+s32 fxDiv(s32 num, s32 den);
+
+// Unsigned quotient through the BIOS (operands below 2^31); the slow path
+// of fxDivU
+u32 fxDivSlow(u32 num, u32 den);
+
+// Unsigned quotient num / den. Exact; uses the reciprocal table when
+// den <= FX_RECIP_MAX and the quotient is below 256, the BIOS otherwise.
+static inline u32 fxDivU(u32 num, u32 den) {
+    if (den <= FX_RECIP_MAX && num < (den << 8)) {
+        return (num * FX_RECIP24[den]) >> 24;
+    }
+    return fxDivSlow(num, den);
+}
+
+// 24.8 ratio num / den for 0 <= num <= den, den > 0: 0..FX8_ONE
+static inline fx8 fxRatio8(u32 num, u32 den) {
+    if (num >= den) return FX8_ONE;
+    return (fx8)fxDivU(num << FX8_SHIFT, den);
+}
+
+// 24.8 quotient a / b of two 24.8 values; |a| must stay below 2^23
+static inline fx8 fx8Div(fx8 a, fx8 b) { return fxDiv(a << FX8_SHIFT, b); }
+
+// --- Modulus ---
+
+// x mod n for n a power of two; correct for negative x as well
+#define FX_MOD_POW2(x, n)   ((x) & ((n) - 1))
+
+// Advances a counter kept in [0, n)
+static inline int fxWrapInc(int i, int n) {
+    return (++i >= n) ? 0 : i;
+}
+
+// Adds a step |d| <= n to a value kept in [0, n), e.g. an angle in degrees
+static inline int fxWrapAdd(int x, int d, int n) {
+    x += d;
+    if (x >= n) x -= n;
+    else if (x < 0) x += n;
+    return x;
+}
+
+// Reduces any x to [0, n); loops, so meant for values that are at most a few
+// multiples of n out of range
+static inline int fxWrap(int x, int n) {
+    while (x >= n) x -= n;
+    while (x < 0) x += n;
+    return x;
+}
+
+#endif // FIXED_MATH_H
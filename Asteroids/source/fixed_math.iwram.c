@@ -0,0 +1,8 @@
+#include "fixed_math.h"
+
+// Built as ARM code (the .iwram.c rule), where a 32x32->64 multiply is a
+// single smull instead of a call to __aeabi_lmul.
+
+IWRAM_CODE fx8 fx8MulLong(fx8 a, fx8 b) {
+    return (fx8)(((s64)a * b + (FX8_ONE >> 1)) >> FX8_SHIFT);
+}
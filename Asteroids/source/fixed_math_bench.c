@@ -0,0 +1,162 @@
+#include "fixed_math_bench.h"
+
+#ifdef FIXED_MATH_BENCH
+
+#include <gba_input.h>
+#include <gba_systemcalls.h>
+#include <gba_timers.h>
+#include <stdio.h>
+#include "debug_log.h"
+#include "fixed_math.h"
+#include "graphics.h"
+
+#define BENCH_OPS 1024
+
+// Operands live in EWRAM like the game's entity tables; the divisors stay in
+// the ranges the game divides by (segment lengths, distances, speeds)
+static EWRAM_BSS u32 benchNum[BENCH_OPS];
+static EWRAM_BSS u32 benchDen[BENCH_OPS];
+static EWRAM_BSS s32 benchAngle[BENCH_OPS];
+static EWRAM_BSS u32 benchRef[BENCH_OPS];
+
+static volatile u32 benchSink;
+
+static void timerStart(void) {
+    REG_TM2CNT_H = 0;
+    REG_TM3CNT_H = 0;
+    REG_TM2CNT_L = 0;
+    REG_TM3CNT_L = 0;
+    REG_TM3CNT_H = TIMER_COUNT | TIMER_START; // Counts timer 2 overflows
+    REG_TM2CNT_H = TIMER_START;               // 1 tick per CPU cycle
+}
+
+static u32 timerStop(void) {
+    REG_TM2CNT_H = 0;
+    REG_TM3CNT_H = 0;
+    return REG_TM2CNT_L | ((u32)REG_TM3CNT_L << 16);
+}
+
+static void fillOperands(void) {
+    u32 seed = 0x2545F491;
+    for (int i = 0; i < BENCH_OPS; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        benchDen[i] = 2 + ((seed >> 16) & 0xFF) % 254;      // 2..255
+        benchNum[i] = ((seed >> 8) & 0xFF) * benchDen[i] >> 8; // Quotient < 256
+        benchAngle[i] = (s32)((seed >> 4) & 0xFF) + ((seed >> 12) & 0x67); // 0..358
+    }
+}
+
+typedef struct {
+    const char *name;
+    u32 cycles;
+    bool ok;
+} BenchResult;
+
+static int benchCount;
+static BenchResult benchResults[8];
+
+static void report(const char *name, u32 cycles, u32 baseline, bool ok) {
+    BenchResult *r = &benchResults[benchCount++];
+    r->name = name;
+    r->cycles = (cycles > baseline) ? cycles - baseline : 0;
+    r->ok = ok;
+}
+
+// Loop and load overhead, subtracted from every case
+static u32 benchBaseline(void) {
+    u32 acc = 0;
+    timerStart();
+    for (int i = 0; i < BENCH_OPS; i++) acc += benchNum[i] ^ benchDen[i];
+    u32 t = timerStop();
+    benchSink = acc;
+    return t;
+}
+
+void fixedMathBenchRun(void) {
+    fillOperands();
+    benchCount = 0;
+    u32 base = benchBaseline();
+    u32 t;
+    bool ok;
+
+    // Quotients: libgcc reference first, the others are checked against it
+    timerStart();
+    for (int i = 0; i < BENCH_OPS; i++) benchRef[i] = benchNum[i] / benchDen[i];
+    t = timerStop();
+    report("LIBGCC UIDIV", t, base, true);
+
+    ok = true;
+    timerStart();
+    for (int i = 0; i < BENCH_OPS; i++) {
+        u32 q = fxDivU(benchNum[i], benchDen[i]);
+        if (q != benchRef[i]) ok = false;
+    }
+    t = timerStop();
+    report("FXDIVU TABLE", t, base, ok);
+
+    ok = true;
+    timerStart();
+    for (int i = 0; i < BENCH_OPS; i++) {
+        u32 q = (u32)fxDiv((s32)benchNum[i], (s32)benchDen[i]);
+        if (q != benchRef[i]) ok = false;
+    }
+    t = timerStop();
+    report("FXDIV BIOS", t, base, ok);
+
+    // Angle wrap, as in the old '% 360' rotation code
+    timerStart();
+    for (int i = 0; i < BENCH_OPS; i++) {
+        s32 a = (benchAngle[i] - 18) % 360;
+        benchRef[i] = (u32)(a < 0 ? a + 360 : a);
+    }
+    t = timerStop();
+    report("LIBGCC MOD360", t, base, true);
+
+    ok = true;
+    timerStart();
+    for (int i = 0; i < BENCH_OPS; i++) {
+        if ((u32)fxWrapAdd(benchAngle[i], -18, 360) != benchRef[i]) ok = false;
+    }
+    t = timerStop();
+    report("FXWRAPADD", t, base, ok);
+
+    // 24.8 products that need the full 64-bit intermediate
+    timerStart();
+    for (int i = 0; i < BENCH_OPS; i++) {
+        s64 p = (s64)(s32)(benchNum[i] << 12) * (s32)(benchDen[i] << 12);
+        benchRef[i] = (u32)((p + (FX8_ONE >> 1)) >> FX8_SHIFT);
+    }
+    t = timerStop();
+    report("LIBGCC LMUL", t, base, true);
+
+    ok = true;
+    timerStart();
+    for (int i = 0; i < BENCH_OPS; i++) {
+        fx8 p = fx8MulLong((fx8)(benchNum[i] << 12), (fx8)(benchDen[i] << 12));
+        if ((u32)p != benchRef[i]) ok = false;
+    }
+    t = timerStop();
+    report("FX8MULLONG", t, base, ok);
+
+    // Cycles per operation, in tenths
+    clearScreen();
+    displayText("FIXED MATH BENCH", 8, 8);
+    char line[40];
+    for (int i = 0; i < benchCount; i++) {
+        const BenchResult *r = &benchResults[i];
+        u32 tenths = (r->cycles * 10) / BENCH_OPS;
+        snprintf(line, sizeof(line), "%-13s%4lu.%lu %s", r->name,
+                 (unsigned long)(tenths / 10), (unsigned long)(tenths % 10), r->ok ? "OK" : "BAD");
+        displayText(line, 8, 24 + i * 10);
+        debugLog(r->ok ? DEBUG_LOG_INFO : DEBUG_LOG_ERROR, "fxbench: %s", line);
+    }
+    displayText("CYCLES PER OP  START: GO", 8, 24 + benchCount * 10 + 6);
+    flipBuffer();
+
+    do {
+        VBlankIntrWait();
+        scanKeys();
+    } while (!(keysDown() & KEY_START));
+}
+
+#endif // FIXED_MATH_BENCH
@@ -0,0 +1,16 @@
+#ifndef FIXED_MATH_BENCH_H
+#define FIXED_MATH_BENCH_H
+
+// --- fixed_math Microbenchmark (make FXBENCH=1) ---
+// Times libgcc's divide, modulo and 64-bit multiply against the fixed_math
+// replacements with timers 2+3 cascaded, checks both give the same results,
+// and reports cycles per operation on screen and to the mGBA debug log.
+// 'make check-divs' is the static half: it fails if a hot module still
+// references a libgcc divide routine.
+
+#ifdef FIXED_MATH_BENCH
+// Runs once at boot and waits for START
+void fixedMathBenchRun(void);
+#endif
+
+#endif // FIXED_MATH_BENCH_H
@@ -1,45 +1,59 @@
 #include "fixed_trig.h"
-#include <stdint.h>
+#include "fixed_math.h"
 #include <stdbool.h>
 
-// Pi in Q8 fixed-point (3.14159265 * 256 ~= 804)
-#define PI_FP 804
+// sin(d) in Q8 for d = 0..180 degrees. Generated from the Bhaskara I
+// approximation sin(x) ~ 16x(pi - x) / (5pi^2 - 4x(pi - x)) that used to be
+// evaluated here with 64-bit divides, so results are unchanged.
+static const s16 SIN_HALF_WAVE[181] = {
+      0,   4,   8,  13,  17,  22,  26,  31,  35,  40,  44,  49,
+     53,  57,  61,  66,  70,  74,  79,  82,  87,  91,  95,  99,
+    104, 107, 112, 115, 120, 123, 128, 131, 134, 139, 142, 146,
+    149, 153, 156, 160, 163, 167, 170, 174, 177, 180, 183, 186,
+    189, 192, 195, 198, 201, 203, 206, 208, 211, 214, 216, 218,
+    221, 223, 225, 227, 229, 231, 233, 235, 236, 238, 240, 241,
+    243, 244, 245, 247, 248, 249, 250, 251, 252, 252, 253, 253,
+    254, 254, 255, 255, 255, 255, 256, 255, 255, 255, 255, 255,
+    254, 254, 253, 252, 252, 251, 250, 249, 248, 247, 246, 244,
+    243, 242, 240, 239, 237, 235, 233, 232, 229, 228, 225, 223,
+    221, 219, 217, 214, 212, 209, 207, 204, 201, 198, 196, 192,
+    190, 186, 184, 180, 177, 174, 171, 168, 164, 161, 157, 154,
+    150, 147, 143, 139, 135, 132, 128, 124, 121, 116, 113, 108,
+    105, 100,  96,  92,  88,  83,  80,  75,  71,  66,  62,  58,
+     54,  50,  45,  41,  36,  32,  27,  23,  18,  14,   9,   5,
+      0,
+};
 
-// Bhaskara I sine approximation on [0, pi]
-// sin(x) ≈ (16 x (π - x)) / (5 π^2 - 4 x (π - x))
-// All values are in Q8; intermediate math uses 64-bit.
 int sin_fp_deg(int deg) {
-    // Normalize angle to [0,359]
-    deg %= 360;
-    if (deg < 0) deg += 360;
-
-    bool neg = false;
-    int d = deg;
-    if (d > 180) { d = 360 - d; neg = true; }
-
-    // x in radians, Q8: x_fp = d * PI / 180
-    long long x_fp = ((long long)d * PI_FP) / 180; // Q8
-    long long pi = PI_FP; // Q8
-
-    long long x_pi_x = x_fp * (pi - x_fp); // Q8 * Q8 => Q16
-    long long num = 16LL * x_pi_x; // Q16
-    long long pi_sq = pi * pi; // Q8 * Q8 => Q16
-    long long den = 5LL * pi_sq - 4LL * x_pi_x; // Q16
-
-    // sin_fp = (num * S) / den, where S = 1<<FP_SHIFT (to get Q8 result)
-    long long S = 1LL << FP_SHIFT;
-    long long sin_fp = 0;
-    if (den != 0) {
-        sin_fp = (num * S) / den; // result in Q8
-    }
-
-    int res = (int)sin_fp;
-    if (neg) res = -res;
-    return res;
+    // Normalize angle to [0,359]; callers pass headings a step or two out of range
+    deg = fxWrap(deg, 360);
+    if (deg > 180) return -SIN_HALF_WAVE[360 - deg];
+    return SIN_HALF_WAVE[deg];
 }
 
 int cos_fp_deg(int deg) {
     // cos(theta) = sin(theta + 90)
-    int a = (deg + 90) % 360;
-    return sin_fp_deg(a);
+    return sin_fp_deg(deg + 90);
+}
+
+// Angle of the vector (x, y) in integer degrees [0, 359], using the same
+// orientation as sin/cos above (0 = +X, 90 = +Y).
+// First-octant approximation: atan(z) ~ 45z + 16z(1 - z) degrees, z in [0, 1].
+int atan2_deg(int y, int x) {
+    if (x == 0 && y == 0) return 0;
+
+    int ax = (x < 0) ? -x : x;
+    int ay = (y < 0) ? -y : y;
+    bool swap = ay > ax;
+    int num = swap ? ax : ay;
+    int den = swap ? ay : ax;
+
+    int z = fxRatio8(num, den); // Q8, 0..256
+    int deg = ((45 * z) + ((16 * z * (256 - z)) >> FP_SHIFT)) >> FP_SHIFT;
+
+    if (swap) deg = 90 - deg;   // Octant mirrored about 45 degrees
+    if (x < 0) deg = 180 - deg; // Left half-plane
+    if (y < 0) deg = 360 - deg; // Lower half-plane
+    if (deg >= 360) deg -= 360;
+    return deg;
 }
@@ -9,4 +9,7 @@ int sin_fp_deg(int deg);
 // Returns cosine of angle (degrees) as fixed-point 16.8 (Q8)
 int cos_fp_deg(int deg);
 
+// Returns the angle of vector (x, y) in integer degrees [0, 359]
+int atan2_deg(int y, int x);
+
 #endif // FIXED_TRIG_H
@@ -0,0 +1,137 @@
+#include <gba_interrupt.h>
+#include <gba_systemcalls.h>
+#include <gba_video.h>
+#include "audio_mixer.h"
+#include "backgrounds.h"
+#include "frame_pipeline.h"
+#include "graphics.h"
+#include "mem_ops.h"
+#include "oam_manager.h"
+#include "palette_anim.h"
+#include "perf.h"
+#include "sound.h"
+
+#define FRAME_BYTES (sizeof(FRAMELINE) * SCREEN_HEIGHT)
+#define NO_BUFFER   (-1)
+
+#ifdef RENDER_PALETTED
+// The two VRAM pages (Mode 4 pages, or BG2 char blocks 0 and 2 in the tiled
+// renderer); the one not shown is drawn into directly
+static FRAMELINE *const s_buffers[FRAME_BACK_BUFFERS] = {
+    (FRAMELINE *)MEM_VRAM, (FRAMELINE *)MEM_VRAM_PAGE1
+};
+#else
+static FRAMELINE s_buffers[FRAME_BACK_BUFFERS][SCREEN_HEIGHT] EWRAM_BSS;
+#endif
+
+static int s_drawIndex = 0;                   // Buffer back_buffer points at
+static volatile int s_pendingIndex = NO_BUFFER; // Finished, waiting for VBlank
+static int s_lastIndex = NO_BUFFER;           // Most recently finished frame
+static u32 s_tick = 0;                        // VBlank count when the current frame started
+static volatile FrameStats s_stats;
+
+// Shows the frame waiting for VBlank, if any. The paletted renderers just
+// flip the displayed page; the Mode 3 framebuffer copy takes ~125 scanlines
+// but stays ahead of the beam, so it never tears.
+static void presentPending(void) {
+    int index = s_pendingIndex;
+    if (index == NO_BUFFER) {
+        s_stats.repeats++;
+        return;
+    }
+#if defined(RENDER_TILED)
+    // BG2's tiles are the frame: point it at the other char block
+    REG_BG2CNT = (REG_BG2CNT & ~CHAR_BASE(3)) | CHAR_BASE(index ? 2 : 0);
+#elif defined(RENDER_MODE4)
+    REG_DISPCNT = index ? (REG_DISPCNT | BACKBUFFER) : (REG_DISPCNT & ~BACKBUFFER);
+#else
+    memDmaCopy32((void *)MEM_VRAM, s_buffers[index], FRAME_BYTES);
+#endif
+    s_pendingIndex = NO_BUFFER;
+    s_stats.presented++;
+}
+
+// Runs at the start of VBlank. The audio halves swap on the refresh
+// boundary, and palette and OAM writes need blanking to land cleanly, so
+// they go first; the next audio half is mixed last.
+static void frameVBlankHandler(void) {
+    audioVBlank();
+    perfVBlankHandler();
+    soundVBlank();
+    paletteAnimVBlank();
+    backgroundsVBlank();
+    oamCommit(); // Sprites latched with the pending frame, or by updateOAM()
+    presentPending();
+    audioMix();
+}
+
+void framePipelineInit(void) {
+    // The paletted renderers show page 0 after initGraphics(), so drawing
+    // starts on page 1
+#ifdef RENDER_PALETTED
+    s_drawIndex = 1;
+#else
+    s_drawIndex = 0;
+#endif
+    s_pendingIndex = NO_BUFFER;
+    s_lastIndex = NO_BUFFER;
+    back_buffer = s_buffers[s_drawIndex];
+    s_tick = perfVBlankCount();
+
+    irqSet(IRQ_VBLANK, frameVBlankHandler);
+    irqEnable(IRQ_VBLANK);
+}
+
+void frameWaitTick(void) {
+    u32 now = perfVBlankCount();
+    if (now == s_tick) {
+        VBlankIntrWait();
+        now = perfVBlankCount();
+    } else if (now - s_tick > 1) {
+        // The last frame spanned more than one refresh; start this one now
+        // instead of idling until the next VBlank
+        s_stats.late++;
+    }
+#ifdef RENDER_PALETTED
+    // With two pages, back_buffer is still on screen until the flip of the
+    // last frame; that only waits when the last frame overran
+    while (s_pendingIndex != NO_BUFFER) {
+        VBlankIntrWait();
+        now = perfVBlankCount();
+    }
+#endif
+    s_tick = now;
+}
+
+void frameSubmit(void) {
+    // The handler reads s_pendingIndex, so switch with interrupts off
+    u16 ime = REG_IME;
+    REG_IME = 0;
+    oamLatch();
+    if (s_pendingIndex != NO_BUFFER) s_stats.dropped++;
+    s_pendingIndex = s_drawIndex;
+    s_lastIndex = s_drawIndex;
+    s_drawIndex ^= 1;
+    s_stats.submitted++;
+    REG_IME = ime;
+
+    // Mode 3: the other buffer is never the pending one now, so it is free
+    // to draw. Paletted: it is free once frameWaitTick() has seen the flip.
+    back_buffer = s_buffers[s_drawIndex];
+}
+
+void frameRetain(void) {
+    if (s_lastIndex == NO_BUFFER) return;
+    memDmaCopy32(back_buffer, s_buffers[s_lastIndex], FRAME_BYTES);
+}
+
+void frameGetStats(FrameStats *stats) {
+    u16 ime = REG_IME;
+    REG_IME = 0;
+    stats->submitted = s_stats.submitted;
+    stats->presented = s_stats.presented;
+    stats->dropped = s_stats.dropped;
+    stats->late = s_stats.late;
+    stats->repeats = s_stats.repeats;
+    REG_IME = ime;
+}
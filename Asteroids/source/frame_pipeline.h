@@ -0,0 +1,46 @@
+#ifndef FRAME_PIPELINE_H
+#define FRAME_PIPELINE_H
+
+#include <gba_types.h>
+
+// --- Frame Pipeline ---
+// Frames are drawn into one of two back buffers while the VBlank interrupt
+// presents the other: it commits the latched OAM, ticks sound effects,
+// shows the newest finished frame and mixes the next audio frame.
+// Mode 3: the buffers are in EWRAM and the newest one is DMAed to the VRAM
+// page. With that page as the third buffer, rendering never waits for the
+// display; a frame finished before the previous one was shown replaces it
+// (dropped).
+// Mode 4 (RENDERER=mode4): the buffers are the two VRAM pages and
+// presenting is a page flip, with no copy. Drawing waits for the flip
+// when the previous frame overran its refresh.
+// Tiled (RENDERER=tiled): the same, with two char blocks of BG2 tiles as
+// the pages.
+#define FRAME_BACK_BUFFERS 2
+
+typedef struct {
+    u32 submitted;  // Frames finished by the main loop
+    u32 presented;  // Frames copied to the screen
+    u32 dropped;    // Finished frames replaced by a newer one before being shown
+    u32 late;       // Frames that overran their refresh (the next one started without waiting)
+    u32 repeats;    // Refreshes that had no new frame and showed the last one again
+} FrameStats;
+
+// Installs the VBlank handler and points back_buffer at the first buffer
+void framePipelineInit(void);
+
+// Start of a frame: waits for the next refresh, unless the last frame
+// overran and that refresh has already passed
+void frameWaitTick(void);
+
+// End of a frame: queues back_buffer for the next VBlank and switches
+// drawing to the other buffer (flipBuffer() calls this)
+void frameSubmit(void);
+
+// Copies the last finished frame into back_buffer, for screens that draw
+// an overlay on top of it (the two buffers otherwise hold different frames)
+void frameRetain(void);
+
+void frameGetStats(FrameStats *stats);
+
+#endif // FRAME_PIPELINE_H
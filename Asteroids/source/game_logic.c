@@ -1,10 +1,11 @@
 #include <gba_video.h>
 #include <gba_input.h>
 #include <gba_types.h>
-#include <stdlib.h>
 #include "fixed_trig.h"
 #include "game_objects.h"
+#include "object_pool.h"
 #include "graphics.h"
+#include "perf.h"
 #include "sound.h"
 
 // Constants
@@ -19,6 +20,7 @@
 #define ACCEL_FACTOR_FP 26 
 
 // --- DYNAMIC ASTEROID SPAWN LOGIC VARIABLES (RESTORED TO ORIGINAL VALUES) ---
+// Defaults for MatchContext tuning; see matchContextInit()
 // Initial spawn interval: 60 frames (assuming 60 FPS)
 #define INITIAL_SPAWN_INTERVAL 60
 // Interval to decrease the spawn time
@@ -28,10 +30,62 @@
 // Minimum spawn interval to prevent overwhelming the player (e.g., 20 frames)
 #define MIN_SPAWN_INTERVAL 20
 
-// Static variables to manage spawn timing
-static int s_spawnTimer = INITIAL_SPAWN_INTERVAL; // Countdown to next spawn
-static int s_currentSpawnInterval = INITIAL_SPAWN_INTERVAL; // Current delay between spawns
-static int s_decreaseTimer = DECREASE_INTERVAL; // Countdown until spawn interval decreases
+// --- SPAWN SCHEDULER LIMITS ---
+// Most slots an asteroid of each size can need at once once fully split
+// (L -> 2 M -> 4 S). Timed spawns only happen while the footprint of every
+// live asteroid plus the new one fits the table, so splits never fail.
+#define FOOTPRINT_L 4
+#define FOOTPRINT_M 2
+#define FOOTPRINT_S 1
+// Spawns are deferred unless the smoothed frame cost plus that of the new
+// asteroid family leaves this much of the frame budget (perfBudgetLines(),
+// the lines before VBlank) free.
+#define SPAWN_HEADROOM_LINES 8
+// Per-asteroid frame cost (update, collision tests, draw) is measured while
+// matches run (perfLoadCost8(); AUTOPLAY builds log it); this stands in
+// until the fit has settled, in lines x256.
+#define ASTEROID_COST_LINES8 (3 << 8)
+// Due spawns that could not happen are coalesced into at most this many
+#define MAX_PENDING_SPAWNS 2
+
+// All per-match state lives in a MatchContext (see game_objects.h), so the
+// simulation is re-entrant and several matches can run side by side.
+
+void matchContextInit(MatchContext *ctx, u32 seed) {
+    ctx->tuning.initialSpawnInterval = INITIAL_SPAWN_INTERVAL;
+    ctx->tuning.decreaseInterval = DECREASE_INTERVAL;
+    ctx->tuning.decreaseAmount = DECREASE_AMOUNT;
+    ctx->tuning.minSpawnInterval = MIN_SPAWN_INTERVAL;
+    ctx->spawnTimer = INITIAL_SPAWN_INTERVAL;
+    ctx->currentSpawnInterval = INITIAL_SPAWN_INTERVAL;
+    ctx->decreaseTimer = DECREASE_INTERVAL;
+    ctx->pendingSpawns = 0;
+    ctx->bulletColorTick = 0;
+    ctx->thrusterActive = false;
+    poolInit(&ctx->asteroidPool, MAX_ASTEROIDS);
+    poolInit(&ctx->bulletPool, MAX_BULLETS);
+    matchSeed(ctx, seed);
+}
+
+void matchSeed(MatchContext *ctx, u32 seed) {
+    // xorshift32 must never hold zero
+    ctx->rngState = seed ? seed : 0x2545F491u;
+}
+
+// xorshift32: a few shifts per number and no shared state, unlike rand()
+int matchRand(MatchContext *ctx) {
+    u32 x = ctx->rngState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    ctx->rngState = x;
+    return (int)(x >> 1);
+}
+
+int matchRandRange(MatchContext *ctx, int n) {
+    // Top 16 bits of the generator, scaled rather than taken modulo n
+    return fxRange16((u32)matchRand(ctx) >> 15, (u32)n);
+}
 
 // --- FIXED-POINT LOOKUP TABLES FOR 8-WAY ROTATION ---
     // The index corresponds to the angle (angle / 45) for 0, 45, 90, 135, 180, 225, 270, 315 degrees.
@@ -64,7 +118,7 @@ const int ROTATION_SIN[8] = {
 // --- Game Logic Implementations (Externally declared in main.c) ---
 
 // Helper: Get the visual collision radius for an asteroid
-static int getAsteroidRadius(int sizeType) {
+int getAsteroidRadius(int sizeType) {
     if (sizeType == ASTEROID_SIZE_L) return 10;  // Large asteroid drawn with radius 10
     if (sizeType == ASTEROID_SIZE_M) return 6;   // Medium asteroid drawn with radius 6
     if (sizeType == ASTEROID_SIZE_S) return 3;   // Small asteroid drawn with radius 3
@@ -84,12 +138,10 @@ static int distanceToSegmentSq(int px, int py, int x1, int y1, int x2, int y2) {
         return dpx * dpx + dpy * dpy;
     }
     
-    // Parameter t for closest point on segment
+    // Parameter t for closest point on segment, scaled by 256 and clamped
+    // to the segment before dividing
     int dot = (px - x1) * dx + (py - y1) * dy;
-    int t = (dot * 256) / lenSq; // scaled by 256 for precision
-    
-    if (t < 0) t = 0;
-    if (t > 256) t = 256;
+    int t = (dot <= 0) ? 0 : fxRatio8(dot, lenSq);
     
     // Closest point on segment
     int closestX = x1 + ((dx * t) >> 8);
@@ -128,9 +180,10 @@ static bool pointNearShipTriangle(int px, int py, GameObject *ship, int threshol
     }
     
     // Check distance to each edge of the triangle
+    static const u8 NEXT_VERTEX[3] = { 1, 2, 0 };
     int thresholdSq = threshold * threshold;
     for (int i = 0; i < 3; i++) {
-        int next = (i + 1) % 3;
+        int next = NEXT_VERTEX[i];
         int distSq = distanceToSegmentSq(px, py, vertices[i][0], vertices[i][1],
                                           vertices[next][0], vertices[next][1]);
         if (distSq <= thresholdSq) return true;
@@ -186,7 +239,7 @@ bool collision(GameObject *obj1, GameObject *obj2) {
     return distSq <= radiusSumSq;
 }
 
-void initGameObject(GameObject *obj, int width, int height, int x, int y) {
+void initGameObject(MatchContext *ctx, GameObject *obj, int width, int height, int x, int y) {
     obj->width = width;
     obj->height = height;
     obj->x = INT_TO_FP(x);
@@ -199,23 +252,54 @@ void initGameObject(GameObject *obj, int width, int height, int x, int y) {
     obj->isAlive = 1; // Always set alive upon initialization
     // Initialize color index to a small random offset so bullets/objects
     // don't all share the same starting color phase.
-    obj->colorIdx = rand() & 0xFF;
+    obj->colorIdx = matchRandRange(ctx, BULLET_COLOR_COUNT);
+}
+
+/**
+ * Rebuilds the bullet/asteroid pools from the isAlive flags of the tables.
+ * Must be called after anything rewrites the tables wholesale (match setup, loading a save).
+ */
+void syncObjectPools(MatchContext *ctx, Asteroid asteroids[], GameObject bullets[]) {
+
+    poolBeginRebuild(&ctx->asteroidPool);
+    for (int i = 0; i < MAX_ASTEROIDS; i++) {
+        if (asteroids[i].obj.isAlive) poolMarkLive(&ctx->asteroidPool, i);
+    }
+    poolEndRebuild(&ctx->asteroidPool);
+
+    poolBeginRebuild(&ctx->bulletPool);
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        if (bullets[i].isAlive) poolMarkLive(&ctx->bulletPool, i);
+    }
+    poolEndRebuild(&ctx->bulletPool);
+}
+
+// Removes an asteroid from play and returns its slot to the pool
+void killAsteroid(MatchContext *ctx, Asteroid asteroids[], int index) {
+    asteroids[index].obj.isAlive = 0;
+    poolFreeIndex(&ctx->asteroidPool, index);
+}
+
+static void killBullet(MatchContext *ctx, GameObject bullets[], int index) {
+    bullets[index].isAlive = 0;
+    poolFreeIndex(&ctx->bulletPool, index);
 }
 
-void setupMatch(GameObject *ship, Asteroid asteroids[], GameObject bullets[], 
+void setupMatch(MatchContext *ctx, GameObject *ship, Asteroid asteroids[], GameObject bullets[], 
     int *score, int *lives) {
     
     // Player Ship Setup
-    initGameObject(ship, PLAYER_SIZE, PLAYER_SIZE, 
+    initGameObject(ctx, ship, PLAYER_SIZE, PLAYER_SIZE, 
                    SCREEN_WIDTH/2 - PLAYER_SIZE/2, 
                    SCREEN_HEIGHT/2 - PLAYER_SIZE/2);
     *lives = 3;
     *score = 0;
 
     // Reset spawn timers for a new match
-    s_currentSpawnInterval = INITIAL_SPAWN_INTERVAL;
-    s_spawnTimer = s_currentSpawnInterval;
-    s_decreaseTimer = DECREASE_INTERVAL;
+    ctx->currentSpawnInterval = ctx->tuning.initialSpawnInterval;
+    ctx->spawnTimer = ctx->currentSpawnInterval;
+    ctx->decreaseTimer = ctx->tuning.decreaseInterval;
+    ctx->pendingSpawns = 0;
 
     // Asteroids Setup (Start with 4 large asteroids)
     for (int i = 0; i < MAX_ASTEROIDS; i++) {
@@ -223,7 +307,7 @@ void setupMatch(GameObject *ship, Asteroid asteroids[], GameObject bullets[],
         asteroids[i].obj.isAlive = 0; 
 
         if (i < 4) {
-            initGameObject(&asteroids[i].obj, ASTEROID_SIZE_L, ASTEROID_SIZE_L, 
+            initGameObject(ctx, &asteroids[i].obj, ASTEROID_SIZE_L, ASTEROID_SIZE_L, 
                            (i % 2) ? 10 : SCREEN_WIDTH - ASTEROID_SIZE_L - 10, 
                            (i / 2) * 40 + 20);
             asteroids[i].sizeType = ASTEROID_SIZE_L;
@@ -238,29 +322,30 @@ void setupMatch(GameObject *ship, Asteroid asteroids[], GameObject bullets[],
     for (int i = 0; i < MAX_BULLETS; i++) {
         bullets[i].isAlive = 0;
     }
+
+    // Fresh pools each match so the high-water stats describe this match only
+    poolInit(&ctx->asteroidPool, MAX_ASTEROIDS);
+    poolInit(&ctx->bulletPool, MAX_BULLETS);
+    syncObjectPools(ctx, asteroids, bullets);
 }
 
-void updatePlayer(GameObject *ship, u16 keys) {
-    static bool thrusterActive = false;
-    
+void updatePlayer(MatchContext *ctx, GameObject *ship, u16 keys) {
     // --- Continuous rotation (360-degree) ---
     if (keys & KEY_LEFT) {
         // Rotate left smoothly by ROTATION_SPEED_DEG
-        ship->angle = (ship->angle - ROTATION_SPEED_DEG) % 360;
-        if (ship->angle < 0) ship->angle += 360;
+        ship->angle = fxWrapAdd(ship->angle, -ROTATION_SPEED_DEG, 360);
     }
     if (keys & KEY_RIGHT) {
         // Rotate right smoothly by ROTATION_SPEED_DEG
-        ship->angle = (ship->angle + ROTATION_SPEED_DEG) % 360;
-        if (ship->angle < 0) ship->angle += 360;
+        ship->angle = fxWrapAdd(ship->angle, ROTATION_SPEED_DEG, 360);
     }
 
     // Thrust
     if (keys & KEY_UP || keys & KEY_B) {
         // Start thruster sound only once
-        if (!thrusterActive) {
+        if (!ctx->thrusterActive) {
             playThrusterSound();
-            thrusterActive = true;
+            ctx->thrusterActive = true;
         }
         
         // Calculate exact angle using integer fixed-point trig
@@ -282,9 +367,9 @@ void updatePlayer(GameObject *ship, u16 keys) {
             ship->velocityY = INT_TO_FP(-PLAYER_MAX_VELOCITY);
     } else {
         // Stop thruster sound when not accelerating
-        if (thrusterActive) {
+        if (ctx->thrusterActive) {
             stopThrusterSound();
-            thrusterActive = false;
+            ctx->thrusterActive = false;
         }
     }
 
@@ -309,227 +394,442 @@ void updatePlayer(GameObject *ship, u16 keys) {
     ship->velocityY = ship->velocityY * 253 / 256;
 }
 
-void spawnBullet(GameObject bullets[], GameObject *ship) {
-    for (int i = 0; i < MAX_BULLETS; i++) {
-        if (!bullets[i].isAlive) {
-            // Play laser sound
-            playShootSound();
-            
-            // Compute exact direction using the ship's angle (integer fixed-point trig)
-            int cosA_fp = cos_fp_deg(ship->angle);
-            int sinA_fp = sin_fp_deg(ship->angle);
-
-            int offset = ship->width / 2;
-            int front_offset = offset + PLAYER_FRONT_EXTEND;
-            int startX = FP_TO_INT(ship->x) + offset + ((front_offset * cosA_fp) >> FP_SHIFT);
-            int startY = FP_TO_INT(ship->y) + offset + ((front_offset * sinA_fp) >> FP_SHIFT);
-            
-            initGameObject(&bullets[i], BULLET_SIZE, BULLET_SIZE, startX, startY);
-
-            int speed_fp = INT_TO_FP(BULLET_SPEED);
-            
-            bullets[i].velocityX = (speed_fp * cosA_fp) >> FP_SHIFT;
-            bullets[i].velocityY = (speed_fp * sinA_fp) >> FP_SHIFT;
-            
-            // initGameObject set isAlive = 1
-            break;
-        }
-    }
+void spawnBullet(MatchContext *ctx, GameObject bullets[], GameObject *ship) {
+    int i = poolAllocIndex(&ctx->bulletPool);
+    if (i < 0) return; // All bullets in flight
+
+    // Play laser sound
+    playShootSound();
+
+    // Compute exact direction using the ship's angle (integer fixed-point trig)
+    int cosA_fp = cos_fp_deg(ship->angle);
+    int sinA_fp = sin_fp_deg(ship->angle);
+
+    int offset = ship->width / 2;
+    int front_offset = offset + PLAYER_FRONT_EXTEND;
+    int startX = FP_TO_INT(ship->x) + offset + ((front_offset * cosA_fp) >> FP_SHIFT);
+    int startY = FP_TO_INT(ship->y) + offset + ((front_offset * sinA_fp) >> FP_SHIFT);
+
+    initGameObject(ctx, &bullets[i], BULLET_SIZE, BULLET_SIZE, startX, startY);
+
+    int speed_fp = INT_TO_FP(BULLET_SPEED);
+
+    bullets[i].velocityX = (speed_fp * cosA_fp) >> FP_SHIFT;
+    bullets[i].velocityY = (speed_fp * sinA_fp) >> FP_SHIFT;
+
+    // initGameObject set isAlive = 1
 }
 
-void updateBullets(GameObject bullets[]) {
-    // Tick used to slow bullet color cycling (advance color every N updates)
-    #define BULLET_COLOR_TICK 3
-    static int s_bullet_color_tick = 0;
-    s_bullet_color_tick = (s_bullet_color_tick + 1) % BULLET_COLOR_TICK;
-    for (int i = 0; i < MAX_BULLETS; i++) {
-        if (bullets[i].isAlive) {
-            bullets[i].prevX = FP_TO_INT(bullets[i].x);
-            bullets[i].prevY = FP_TO_INT(bullets[i].y);
-            bullets[i].x += bullets[i].velocityX;
-            bullets[i].y += bullets[i].velocityY;
-            // Advance color index only every BULLET_COLOR_TICK updates to slow cycling
-            if (s_bullet_color_tick == 0) {
-                bullets[i].colorIdx++;
-            }
-            
-            // Deactivate bullets that go off-screen
-            if (FP_TO_INT(bullets[i].x) < -bullets[i].width ||
-                FP_TO_INT(bullets[i].x) > SCREEN_WIDTH ||
-                FP_TO_INT(bullets[i].y) < -bullets[i].height ||
-                FP_TO_INT(bullets[i].y) > SCREEN_HEIGHT) {
-                bullets[i].isAlive = 0;
-            }
+void updateBullets(MatchContext *ctx, GameObject bullets[]) {
+    ctx->bulletColorTick = fxWrapInc(ctx->bulletColorTick, BULLET_COLOR_TICK);
+    POOL_FOR_EACH(&ctx->bulletPool, i) {
+        bullets[i].prevX = FP_TO_INT(bullets[i].x);
+        bullets[i].prevY = FP_TO_INT(bullets[i].y);
+        bullets[i].x += bullets[i].velocityX;
+        bullets[i].y += bullets[i].velocityY;
+#if !defined(RENDER_PALETTED) || defined(RENDER_TILED)
+        // Advance color index only every BULLET_COLOR_TICK updates to slow cycling
+        // (Mode 4 cycles the colors in the palette instead; the tiled
+        // renderer's bullet sprites pick a palette bank by it)
+        if (ctx->bulletColorTick == 0) {
+            bullets[i].colorIdx = fxWrapInc(bullets[i].colorIdx, BULLET_COLOR_COUNT);
+        }
+#endif
+
+        // Deactivate bullets that go off-screen
+        if (FP_TO_INT(bullets[i].x) < -bullets[i].width ||
+            FP_TO_INT(bullets[i].x) > SCREEN_WIDTH ||
+            FP_TO_INT(bullets[i].y) < -bullets[i].height ||
+            FP_TO_INT(bullets[i].y) > SCREEN_HEIGHT) {
+            killBullet(ctx, bullets, i);
         }
     }
 }
 
-void updateAsteroids(Asteroid asteroids[]) {
-    for (int i = 0; i < MAX_ASTEROIDS; i++) {
-        if (asteroids[i].obj.isAlive) {
-            GameObject *obj = &asteroids[i].obj;
-            obj->prevX = FP_TO_INT(obj->x);
-            obj->prevY = FP_TO_INT(obj->y);
-            obj->x += obj->velocityX;
-            obj->y += obj->velocityY;
-
-            // Wrap-around screen bounds
-            if (FP_TO_INT(obj->x) < -obj->width) 
-                obj->x = INT_TO_FP(SCREEN_WIDTH);
-            if (FP_TO_INT(obj->x) > SCREEN_WIDTH) 
-                obj->x = INT_TO_FP(-obj->width);
-            if (FP_TO_INT(obj->y) < -obj->height) 
-                obj->y = INT_TO_FP(SCREEN_HEIGHT);
-            if (FP_TO_INT(obj->y) > SCREEN_HEIGHT) 
-                obj->y = INT_TO_FP(-obj->height);
-        }
+void updateAsteroids(MatchContext *ctx, Asteroid asteroids[]) {
+    POOL_FOR_EACH(&ctx->asteroidPool, i) {
+        GameObject *obj = &asteroids[i].obj;
+        obj->prevX = FP_TO_INT(obj->x);
+        obj->prevY = FP_TO_INT(obj->y);
+        obj->x += obj->velocityX;
+        obj->y += obj->velocityY;
+
+        // Wrap-around screen bounds
+        if (FP_TO_INT(obj->x) < -obj->width) 
+            obj->x = INT_TO_FP(SCREEN_WIDTH);
+        if (FP_TO_INT(obj->x) > SCREEN_WIDTH) 
+            obj->x = INT_TO_FP(-obj->width);
+        if (FP_TO_INT(obj->y) < -obj->height) 
+            obj->y = INT_TO_FP(SCREEN_HEIGHT);
+        if (FP_TO_INT(obj->y) > SCREEN_HEIGHT) 
+            obj->y = INT_TO_FP(-obj->height);
     }
 }
 
 /**
  * Helper to spawn a new, smaller asteroid.
+ * Returns the slot used, or -1 if the asteroid table is full.
  */
-void spawnNewAsteroid(Asteroid asteroids[], int size, int x, int y, int velX_int, int velY_int) {
-    for (int i = 0; i < MAX_ASTEROIDS; i++) {
-        // Find the first inactive slot
-        if (!asteroids[i].obj.isAlive) { 
-            initGameObject(&asteroids[i].obj, size, size, x, y);
-            asteroids[i].sizeType = size;
-            asteroids[i].obj.velocityX = INT_TO_FP(velX_int);
-            asteroids[i].obj.velocityY = INT_TO_FP(velY_int);
-            
-            // initGameObject set isAlive = 1, so no need to repeat
-            break;
-        }
+int spawnNewAsteroid(MatchContext *ctx, Asteroid asteroids[], int size, int x, int y, int velX_int, int velY_int) {
+    int i = poolAllocIndex(&ctx->asteroidPool);
+    if (i < 0) return -1;
+
+    initGameObject(ctx, &asteroids[i].obj, size, size, x, y);
+    asteroids[i].sizeType = size;
+    asteroids[i].obj.velocityX = INT_TO_FP(velX_int);
+    asteroids[i].obj.velocityY = INT_TO_FP(velY_int);
+
+    // initGameObject set isAlive = 1, so no need to repeat
+    return i;
+}
+
+static int asteroidFootprint(int sizeType) {
+    if (sizeType == ASTEROID_SIZE_L) return FOOTPRINT_L;
+    if (sizeType == ASTEROID_SIZE_M) return FOOTPRINT_M;
+    return FOOTPRINT_S;
+}
+
+/**
+ * Slots reserved by the live asteroids, counting the children they may still split into.
+ */
+static int reservedAsteroidSlots(MatchContext *ctx, Asteroid asteroids[]) {
+    int reserved = 0;
+    POOL_FOR_EACH(&ctx->asteroidPool, i) {
+        reserved += asteroidFootprint(asteroids[i].sizeType);
     }
+    return reserved;
+}
+
+/**
+ * Returns non-zero if a new large asteroid fits both the table (including
+ * its future split fragments) and the frame budget.
+ */
+static int canSpawnLargeAsteroid(MatchContext *ctx, Asteroid asteroids[]) {
+    if (reservedAsteroidSlots(ctx, asteroids) + FOOTPRINT_L > MAX_ASTEROIDS) return 0;
+
+    int cost8 = perfLoadCost8();
+    if (cost8 < 0) cost8 = ASTEROID_COST_LINES8;
+    int projectedLines = perfAvgFrameLines() + ((FOOTPRINT_L * cost8) >> 8);
+    return projectedLines + SPAWN_HEADROOM_LINES <= perfBudgetLines();
+}
+
+/**
+ * Spawns one large asteroid just outside a random screen edge.
+ */
+static void spawnEdgeAsteroid(MatchContext *ctx, Asteroid asteroids[]) {
+    // Randomly choose an edge to spawn from (0=Top, 1=Right, 2=Bottom, 3=Left)
+    int edge = FX_MOD_POW2(matchRand(ctx), 4);
+    int startX, startY, velX, velY;
+
+    // Ensure starting position is outside the screen boundary
+    int size = ASTEROID_SIZE_L;
+
+    if (edge == 0) { // Top
+        startX = matchRandRange(ctx, SCREEN_WIDTH);
+        startY = -size; // Start fully off-screen
+        velX = matchRandRange(ctx, 3) - 1; // -1, 0, or 1
+        velY = matchRandRange(ctx, 2) + 1; // 1 or 2 (must move down)
+    } else if (edge == 1) { // Right
+        startX = SCREEN_WIDTH; // Start fully off-screen
+        startY = matchRandRange(ctx, SCREEN_HEIGHT);
+        velX = matchRandRange(ctx, 2) - 2; // -2 or -1 (must move left)
+        velY = matchRandRange(ctx, 3) - 1; // -1, 0, or 1
+    } else if (edge == 2) { // Bottom
+        startX = matchRandRange(ctx, SCREEN_WIDTH);
+        startY = SCREEN_HEIGHT; // Start fully off-screen
+        velX = matchRandRange(ctx, 3) - 1; // -1, 0, or 1
+        velY = matchRandRange(ctx, 2) - 2; // -2 or -1 (must move up)
+    } else { // Left
+        startX = -size; // Start fully off-screen
+        startY = matchRandRange(ctx, SCREEN_HEIGHT);
+        velX = matchRandRange(ctx, 2) + 1; // 1 or 2 (must move right)
+        velY = matchRandRange(ctx, 3) - 1; // -1, 0, or 1
+    }
+
+    spawnNewAsteroid(ctx, asteroids, ASTEROID_SIZE_L, startX, startY, velX, velY);
 }
 
 /**
  * Manages the time-based spawning of new large asteroids.
+ * Difficulty keeps ramping on schedule; the spawns themselves are deferred
+ * (and coalesced) while the table or the frame budget has no room for them.
  */
-void manageAsteroidSpawning(GameObject *ship, Asteroid asteroids[]) {
+void manageAsteroidSpawning(MatchContext *ctx, GameObject *ship, Asteroid asteroids[]) {
     // Only spawn if the player is alive
     if (!ship->isAlive) return;
 
     // --- 1. Decrease Spawn Interval Timer (Time Difficulty) ---
-    s_decreaseTimer--;
-    if (s_decreaseTimer <= 0) {
+    ctx->decreaseTimer--;
+    if (ctx->decreaseTimer <= 0) {
         // Time to decrease the spawn interval
-        if (s_currentSpawnInterval > MIN_SPAWN_INTERVAL) {
-            s_currentSpawnInterval -= DECREASE_AMOUNT;
+        if (ctx->currentSpawnInterval > ctx->tuning.minSpawnInterval) {
+            ctx->currentSpawnInterval -= ctx->tuning.decreaseAmount;
             // Ensure we don't drop below the minimum interval
-            if (s_currentSpawnInterval < MIN_SPAWN_INTERVAL) {
-                s_currentSpawnInterval = MIN_SPAWN_INTERVAL;
+            if (ctx->currentSpawnInterval < ctx->tuning.minSpawnInterval) {
+                ctx->currentSpawnInterval = ctx->tuning.minSpawnInterval;
             }
         }
         // Reset the decrease timer
-        s_decreaseTimer = DECREASE_INTERVAL;
+        ctx->decreaseTimer = ctx->tuning.decreaseInterval;
     }
 
     // --- 2. Spawn Asteroid Timer (The 60-frame trigger) ---
-    s_spawnTimer--;
-    if (s_spawnTimer <= 0) {
-        // Time to spawn a new asteroid
-        
-        // Randomly choose an edge to spawn from (0=Top, 1=Right, 2=Bottom, 3=Left)
-        int edge = rand() % 4;
-        int startX, startY, velX, velY;
-        
-        // Ensure starting position is outside the screen boundary
-        int size = ASTEROID_SIZE_L;
-        
-        if (edge == 0) { // Top
-            startX = rand() % SCREEN_WIDTH;
-            startY = -size; // Start fully off-screen
-            velX = (rand() % 3) - 1; // -1, 0, or 1
-            velY = (rand() % 2) + 1; // 1 or 2 (must move down)
-        } else if (edge == 1) { // Right
-            startX = SCREEN_WIDTH; // Start fully off-screen
-            startY = rand() % SCREEN_HEIGHT;
-            velX = (rand() % 2) - 2; // -2 or -1 (must move left)
-            velY = (rand() % 3) - 1; // -1, 0, or 1
-        } else if (edge == 2) { // Bottom
-            startX = rand() % SCREEN_WIDTH;
-            startY = SCREEN_HEIGHT; // Start fully off-screen
-            velX = (rand() % 3) - 1; // -1, 0, or 1
-            velY = (rand() % 2) - 2; // -2 or -1 (must move up)
-        } else { // Left
-            startX = -size; // Start fully off-screen
-            startY = rand() % SCREEN_HEIGHT;
-            velX = (rand() % 2) + 1; // 1 or 2 (must move right)
-            velY = (rand() % 3) - 1; // -1, 0, or 1
-        }
+    ctx->spawnTimer--;
+    if (ctx->spawnTimer <= 0) {
+        // Queue the spawn; while earlier ones are still waiting, extra due
+        // spawns collapse into the capped backlog instead of piling up.
+        if (ctx->pendingSpawns < MAX_PENDING_SPAWNS) ctx->pendingSpawns++;
 
-        spawnNewAsteroid(asteroids, ASTEROID_SIZE_L, startX, startY, velX, velY);
-        
         // Reset the spawn timer to the current interval (starts at 60 and decreases)
-        s_spawnTimer = s_currentSpawnInterval;
+        ctx->spawnTimer = ctx->currentSpawnInterval;
+    }
+
+    // --- 3. Release at most one queued spawn per frame when there is room ---
+    if (ctx->pendingSpawns > 0 && canSpawnLargeAsteroid(ctx, asteroids)) {
+        spawnEdgeAsteroid(ctx, asteroids);
+        ctx->pendingSpawns--;
     }
 }
 
-void handleCollisions(GameObject *ship, Asteroid asteroids[], GameObject bullets[], int *lives, int *score) {
+void handleCollisions(MatchContext *ctx, GameObject *ship, Asteroid asteroids[], GameObject bullets[], int *lives, int *score) {
     // Bullet-Asteroid Collisions
-    for (int i = 0; i < MAX_BULLETS; i++) {
-        if (bullets[i].isAlive) {
-            for (int j = 0; j < MAX_ASTEROIDS; j++) {
-                Asteroid *a = &asteroids[j];
-                if (a->obj.isAlive && collisionWithAsteroid(&bullets[i], a)) {
-                    // Collision detected! Destroy both.
-                    bullets[i].isAlive = 0;
-                    playExplosionSound(); // Play explosion sound
-                    
-                    // Award points
-                    if (a->sizeType == ASTEROID_SIZE_L) *score += 20;
-                    else if (a->sizeType == ASTEROID_SIZE_M) *score += 50;
-                    else *score += 100;
-
-                    // If it was a small asteroid, simply destroy it.
-                    if (a->sizeType == ASTEROID_SIZE_S) {
-                        a->obj.isAlive = 0;
-                    } else {
-                        // Split into smaller asteroids (2 of next size down)
-                        a->obj.isAlive = 0;
-                        
-                        int velX_base = FP_TO_INT(a->obj.velocityX);
-                        int velY_base = FP_TO_INT(a->obj.velocityY);
-                        
-                        if (a->sizeType == ASTEROID_SIZE_L) {
-                            spawnNewAsteroid(asteroids, ASTEROID_SIZE_M, FP_TO_INT(a->obj.x), FP_TO_INT(a->obj.y), 
-                                             velX_base + 1, velY_base);
-                            spawnNewAsteroid(asteroids, ASTEROID_SIZE_M, FP_TO_INT(a->obj.x), FP_TO_INT(a->obj.y), 
-                                             velX_base - 1, velY_base);
-                        } else if (a->sizeType == ASTEROID_SIZE_M) {
-                            spawnNewAsteroid(asteroids, ASTEROID_SIZE_S, FP_TO_INT(a->obj.x), FP_TO_INT(a->obj.y), 
-                                             velX_base, velY_base + 1);
-                            spawnNewAsteroid(asteroids, ASTEROID_SIZE_S, FP_TO_INT(a->obj.x), FP_TO_INT(a->obj.y), 
-                                             velX_base, velY_base - 1);
-                        }
-                    }
-                    break; // Move to the next bullet after one successful collision
+    POOL_FOR_EACH(&ctx->bulletPool, i) {
+        POOL_FOR_EACH(&ctx->asteroidPool, j) {
+            Asteroid *a = &asteroids[j];
+            if (collisionWithAsteroid(&bullets[i], a)) {
+                // Collision detected! Destroy both.
+                killBullet(ctx, bullets, i);
+                playExplosionSound(); // Play explosion sound
+
+                // Award points
+                if (a->sizeType == ASTEROID_SIZE_L) *score += 20;
+                else if (a->sizeType == ASTEROID_SIZE_M) *score += 50;
+                else *score += 100;
+
+                // Capture what the split needs before the slot is released:
+                // the free list is LIFO, so a child may reuse this very slot.
+                int sizeType = a->sizeType;
+                int ax = FP_TO_INT(a->obj.x);
+                int ay = FP_TO_INT(a->obj.y);
+                int velX_base = FP_TO_INT(a->obj.velocityX);
+                int velY_base = FP_TO_INT(a->obj.velocityY);
+                killAsteroid(ctx, asteroids, j);
+
+                // Fragments start on-screen: one born in the wrap margin with no
+                // velocity along that axis would otherwise sit there unreachable
+                if (ax < 0) ax = 0;
+                else if (ax >= SCREEN_WIDTH) ax = SCREEN_WIDTH - 1;
+                if (ay < 0) ay = 0;
+                else if (ay >= SCREEN_HEIGHT) ay = SCREEN_HEIGHT - 1;
+
+                // Small asteroids are simply destroyed; others split into 2 of the next size down
+                if (sizeType == ASTEROID_SIZE_L) {
+                    spawnNewAsteroid(ctx, asteroids, ASTEROID_SIZE_M, ax, ay, velX_base + 1, velY_base);
+                    spawnNewAsteroid(ctx, asteroids, ASTEROID_SIZE_M, ax, ay, velX_base - 1, velY_base);
+                } else if (sizeType == ASTEROID_SIZE_M) {
+                    spawnNewAsteroid(ctx, asteroids, ASTEROID_SIZE_S, ax, ay, velX_base, velY_base + 1);
+                    spawnNewAsteroid(ctx, asteroids, ASTEROID_SIZE_S, ax, ay, velX_base, velY_base - 1);
                 }
+                break; // Move to the next bullet after one successful collision
             }
         }
     }
     
     // Ship-Asteroid Collisions
-    for (int j = 0; j < MAX_ASTEROIDS; j++) {
-        if (asteroids[j].obj.isAlive && ship->isAlive) {
-            if (collisionWithAsteroid(ship, &asteroids[j])) {
-                *lives -= 1;
-                
-                // Play hit sound (high-pitched sweep repeated 3 times)
-                playPlayerHitSound();
-                
-                // Ship is destroyed, triggering the RESET_MODE transition in main.c.
-                ship->isAlive = 0;
-                
-                // Reset position and velocity
-                ship->x = INT_TO_FP(SCREEN_WIDTH/2 - PLAYER_SIZE/2);
-                ship->y = INT_TO_FP(SCREEN_HEIGHT/2 - PLAYER_SIZE/2);
-                ship->velocityX = 0;
-                ship->velocityY = 0;
-                ship->angle = 270;
+    POOL_FOR_EACH(&ctx->asteroidPool, j) {
+        if (ship->isAlive && collisionWithAsteroid(ship, &asteroids[j])) {
+            *lives -= 1;
+
+            // Play hit sound (high-pitched sweep repeated 3 times)
+            playPlayerHitSound();
+
+            // Ship is destroyed, triggering the RESET_MODE transition in main.c.
+            ship->isAlive = 0;
+
+            // Reset position and velocity
+            ship->x = INT_TO_FP(SCREEN_WIDTH/2 - PLAYER_SIZE/2);
+            ship->y = INT_TO_FP(SCREEN_HEIGHT/2 - PLAYER_SIZE/2);
+            ship->velocityX = 0;
+            ship->velocityY = 0;
+            ship->angle = 270;
+        }
+    }
+}
+
+/**
+ * Advances a match by one frame of input: movement, spawning and collisions.
+ * Shared by matchMode and the host-side harnesses so both simulate the same game.
+ */
+void stepMatch(MatchContext *ctx, GameObject *ship, Asteroid asteroids[], GameObject bullets[],
+               int *score, int *lives, u16 keys_held, u16 keys_down) {
+    // 1. INPUT & LOGIC UPDATES
+    updatePlayer(ctx, ship, keys_held);
+
+    if (keys_down & KEY_A) {
+        spawnBullet(ctx, bullets, ship);
+    }
+
+    // 2. APPLY MOVEMENT (Ship wrapping is handled here for screen boundaries)
+    ship->prevX = FP_TO_INT(ship->x);
+    ship->prevY = FP_TO_INT(ship->y);
+
+    // Apply Player Movement
+    ship->x += ship->velocityX;
+    ship->y += ship->velocityY;
+
+    // Wrap Player around screen
+    int x = FP_TO_INT(ship->x);
+    int y = FP_TO_INT(ship->y);
+
+    if (x < -ship->width) ship->x = INT_TO_FP(SCREEN_WIDTH);
+    else if (x > SCREEN_WIDTH) ship->x = INT_TO_FP(-ship->width);
+
+    if (y < -ship->height) ship->y = INT_TO_FP(SCREEN_HEIGHT);
+    else if (y > SCREEN_HEIGHT) ship->y = INT_TO_FP(-ship->height);
+
+    // Update Bullets and Asteroids
+    updateBullets(ctx, bullets);
+    updateAsteroids(ctx, asteroids);
+
+    // Spawn new asteroids over time
+    manageAsteroidSpawning(ctx, ship, asteroids);
+
+    // 3. COLLISION DETECTION
+    handleCollisions(ctx, ship, asteroids, bullets, lives, score);
+}
+
+/**
+ * Destroys asteroids within RESPAWN_CLEAR_RADIUS of the spawn center and
+ * brings the ship back to life.
+ */
+void respawnShip(MatchContext *ctx, GameObject *ship, Asteroid asteroids[]) {
+    int spawnCenterX = SCREEN_WIDTH / 2;
+    int spawnCenterY = SCREEN_HEIGHT / 2;
+    int r2 = RESPAWN_CLEAR_RADIUS * RESPAWN_CLEAR_RADIUS;
+
+    POOL_FOR_EACH(&ctx->asteroidPool, a) {
+        int ax = FP_TO_INT(asteroids[a].obj.x) + (asteroids[a].obj.width / 2);
+        int ay = FP_TO_INT(asteroids[a].obj.y) + (asteroids[a].obj.height / 2);
+        int dx = ax - spawnCenterX;
+        int dy = ay - spawnCenterY;
+        if (dx*dx + dy*dy <= r2) {
+            killAsteroid(ctx, asteroids, a); // destroy asteroid near spawn
+        }
+    }
+    // SHIP REAPPEARS
+    ship->isAlive = 1;
+}
+
+// Integer square root (bit-by-bit, no division)
+static int isqrt(unsigned int v) {
+    unsigned int res = 0;
+    unsigned int bit = 1u << 30;
+    while (bit > v) bit >>= 2;
+    while (bit) {
+        if (v >= res + bit) {
+            v -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (int)res;
+}
+
+// Wrapped ship-to-asteroid vector in pixels (both wrap around the edges)
+static void wrappedDelta(int shipX, int shipY, const Asteroid *asteroid, int *ax, int *ay) {
+    int x = FP_TO_INT(asteroid->obj.x) - shipX;
+    int y = FP_TO_INT(asteroid->obj.y) - shipY;
+    if (x > SCREEN_WIDTH / 2) x -= SCREEN_WIDTH;
+    else if (x < -SCREEN_WIDTH / 2) x += SCREEN_WIDTH;
+    if (y > SCREEN_HEIGHT / 2) y -= SCREEN_HEIGHT;
+    else if (y < -SCREEN_HEIGHT / 2) y += SCREEN_HEIGHT;
+    *ax = x;
+    *ay = y;
+}
+
+/**
+ * Nearest-target query: finds the live asteroid whose edge is closest to the
+ * ship's center. Bullets do not wrap and are removed at the screen edge, so
+ * the vector is taken straight across the screen and asteroids drifting
+ * entirely off-screen are skipped.
+ */
+int findNearestAsteroid(const MatchContext *ctx, const GameObject *ship, const Asteroid asteroids[],
+                        int *dx, int *dy, int *edgeDist) {
+    int shipX = FP_TO_INT(ship->x) + (ship->width / 2);
+    int shipY = FP_TO_INT(ship->y) + (ship->height / 2);
+    int best = -1;
+    int bestDist = 0x7FFFFFFF;
+
+    POOL_FOR_EACH(&ctx->asteroidPool, i) {
+        int r = getAsteroidRadius(asteroids[i].sizeType);
+        int x = FP_TO_INT(asteroids[i].obj.x);
+        int y = FP_TO_INT(asteroids[i].obj.y);
+        if (x < -r || x > SCREEN_WIDTH + r || y < -r || y > SCREEN_HEIGHT + r) continue;
+
+        int ax = x - shipX;
+        int ay = y - shipY;
+        int dist = isqrt(ax * ax + ay * ay) - r;
+        if (dist < bestDist) {
+            bestDist = dist;
+            best = i;
+            if (dx) *dx = ax;
+            if (dy) *dy = ay;
+        }
+    }
+    if (edgeDist) *edgeDist = bestDist;
+    return best;
+}
+
+/**
+ * Nearest-threat query: of the asteroids on a collision course (closest
+ * approach within their radius plus `margin` pixels), returns the one that
+ * arrives first within `horizon` frames, or -1. Motion is extrapolated in a
+ * straight line; the ship covers its velocity twice per frame (see stepMatch).
+ */
+int findNearestThreat(const MatchContext *ctx, const GameObject *ship, const Asteroid asteroids[],
+                      int horizon, int margin, int *dx, int *dy, int *frames) {
+    int shipX = FP_TO_INT(ship->x) + (ship->width / 2);
+    int shipY = FP_TO_INT(ship->y) + (ship->height / 2);
+    int best = -1;
+    int bestTime = horizon + 1;
+
+    POOL_FOR_EACH(&ctx->asteroidPool, i) {
+        int px, py;
+        wrappedDelta(shipX, shipY, &asteroids[i], &px, &py);
+
+        // Relative velocity in 1/16 pixel per frame keeps the products below in range
+        s64 vx = (asteroids[i].obj.velocityX - 2 * ship->velocityX) >> 4;
+        s64 vy = (asteroids[i].obj.velocityY - 2 * ship->velocityY) >> 4;
+        s64 pv = px * vx + py * vy;
+        s64 vv = vx * vx + vy * vy;
+        s64 pp = (s64)px * px + (s64)py * py;
+        int reach = getAsteroidRadius(asteroids[i].sizeType) + margin;
+
+        if (pp <= (s64)reach * reach) {
+            // Already overlapping the danger zone
+            if (best < 0 || bestTime > 0) {
+                best = i;
+                bestTime = 0;
+                *dx = px;
+                *dy = py;
             }
+            continue;
+        }
+        if (pv >= 0 || vv == 0) continue;                    // Moving apart
+        if (-16 * pv > (s64)horizon * vv) continue;           // Closest approach too late
+        if (pp * vv - pv * pv > (s64)reach * reach * vv) continue; // Passes wide
+
+        // Both terms fit in 32 bits once the horizon test has passed
+        int t = fxDiv((s32)(-16 * pv), (s32)vv);
+        if (t < bestTime) {
+            best = i;
+            bestTime = t;
+            *dx = px;
+            *dy = py;
         }
     }
-}
\ No newline at end of file
+    if (frames) *frames = bestTime;
+    return best;
+}
@@ -2,9 +2,13 @@
 #define GAME_OBJECTS_H
 
 #include <gba_types.h>
+#include <stdbool.h>
+#include "object_pool.h"
+#include "fixed_math.h"
 
-// Fixed Point Math Macros (16.8 fixed point format)
-#define FP_SHIFT 8
+// Fixed Point Math Macros (16.8 fixed point format, fx8 in fixed_math.h,
+// which also has the rounding, saturating and division-free helpers)
+#define FP_SHIFT FX8_SHIFT
 #define INT_TO_FP(x) ((x) << FP_SHIFT)
 #define FP_TO_INT(x) ((x) >> FP_SHIFT)
 #define FLOAT_TO_FP(x) ((int)((x) * (1 << FP_SHIFT)))
@@ -29,13 +33,18 @@ extern const int ROTATION_SIN[8];
 #define PLAYER_BACK_INSET 2
 #define BULLET_SIZE 2
 #define BULLET_SPEED 6
+// Bullets cycle through this many colors (bullet_colors in graphics.c),
+// advancing every BULLET_COLOR_TICK updates
+#define BULLET_COLOR_COUNT 6
+#define BULLET_COLOR_TICK 3
 #define ASTEROID_SIZE_L 16
 #define ASTEROID_SIZE_M 12
 #define ASTEROID_SIZE_S 8
 
 // --- Max Counts ---
 #define MAX_BULLETS 10
-#define MAX_ASTEROIDS 16
+// Room for six fully split large asteroids (see FOOTPRINT_* in game_logic.c)
+#define MAX_ASTEROIDS 24
 
 // --- Structures ---
 
@@ -60,6 +69,69 @@ typedef struct {
     int oam_index; // OAM sprite index
 } Asteroid;
 
-void manageAsteroidSpawning(GameObject *ship, Asteroid asteroids[]);
+// Radius (in pixels) around the player spawn center to clear asteroids on respawn
+#define RESPAWN_CLEAR_RADIUS 24
+
+// --- Match Context ---
+// Everything the simulation keeps between frames apart from the entity tables,
+// so matches are independent and several can run at once (tools/hostsim).
+typedef struct {
+    int initialSpawnInterval; // Frames between spawns at match start
+    int decreaseInterval;     // Frames between difficulty steps
+    int decreaseAmount;       // Spawn interval reduction per step
+    int minSpawnInterval;     // Spawn interval floor
+} MatchTuning;
+
+typedef struct {
+    MatchTuning tuning;       // Read by setupMatch() and the spawn scheduler
+    int spawnTimer;           // Countdown to next spawn
+    int currentSpawnInterval; // Current delay between spawns
+    int decreaseTimer;        // Countdown until spawn interval decreases
+    int pendingSpawns;        // Spawns that came due but were deferred
+    int bulletColorTick;      // Slows bullet color cycling
+    bool thrusterActive;      // Thruster sound is playing
+    u32 rngState;             // xorshift32 state
+    // Slot pools mirroring the isAlive flags of the bullet/asteroid tables so
+    // spawning is O(1) and per-frame loops only visit live objects.
+    ObjectPool bulletPool;
+    ObjectPool asteroidPool;
+} MatchContext;
+
+// Default tuning, empty pools and the given random seed
+void matchContextInit(MatchContext *ctx, u32 seed);
+void matchSeed(MatchContext *ctx, u32 seed);
+int matchRand(MatchContext *ctx); // 0 to 0x7FFFFFFF, from the match's own generator
+int matchRandRange(MatchContext *ctx, int n); // 0 to n - 1 (n <= 65535), without a divide
+
+// --- Game Logic (Defined in game_logic.c) ---
+void setupMatch(MatchContext *ctx, GameObject *ship, Asteroid asteroids[], GameObject bullets[], int *score, int *lives);
+void updatePlayer(MatchContext *ctx, GameObject *ship, u16 keys);
+void spawnBullet(MatchContext *ctx, GameObject bullets[], GameObject *ship);
+void updateBullets(MatchContext *ctx, GameObject bullets[]);
+void updateAsteroids(MatchContext *ctx, Asteroid asteroids[]);
+void manageAsteroidSpawning(MatchContext *ctx, GameObject *ship, Asteroid asteroids[]);
+void handleCollisions(MatchContext *ctx, GameObject *ship, Asteroid asteroids[], GameObject bullets[], int *lives, int *score);
+
+// One full frame of match simulation (input, movement, spawning, collisions)
+void stepMatch(MatchContext *ctx, GameObject *ship, Asteroid asteroids[], GameObject bullets[],
+               int *score, int *lives, u16 keys_held, u16 keys_down);
+// Clears asteroids around the spawn point and brings the ship back
+void respawnShip(MatchContext *ctx, GameObject *ship, Asteroid asteroids[]);
+
+// Object pools mirroring the isAlive flags (see object_pool.h)
+void syncObjectPools(MatchContext *ctx, Asteroid asteroids[], GameObject bullets[]);
+void killAsteroid(MatchContext *ctx, Asteroid asteroids[], int index);
+
+// Nearest on-screen asteroid to the ship's center, measured to the asteroid's edge.
+// Returns its index (or -1) and the ship-to-asteroid vector in pixels (not
+// wrapped, since bullets do not wrap).
+int findNearestAsteroid(const MatchContext *ctx, const GameObject *ship, const Asteroid asteroids[],
+                        int *dx, int *dy, int *edgeDist);
+// First asteroid due to come within its radius plus `margin` pixels of the
+// ship's center in the next `horizon` frames. Returns its index (or -1), the
+// wrapped vector and the frames until closest approach.
+int findNearestThreat(const MatchContext *ctx, const GameObject *ship, const Asteroid asteroids[],
+                      int horizon, int margin, int *dx, int *dy, int *frames);
+int getAsteroidRadius(int sizeType);
 
 #endif // GAME_OBJECTS_H
\ No newline at end of file
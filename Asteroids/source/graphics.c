@@ -4,11 +4,21 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include "backgrounds.h"
+#include "display_list.h"
 #include "fixed_trig.h"
 
 #include "graphics.h"
+#include "palette_anim.h"
+#include "stamp_cache.h"
+#include "vector_sprites.h"
 #include "game_objects.h" // For GameObject structure and lookup tables
 #include "characters.h"
+#include "frame_pipeline.h"
+#include "mem_ops.h"
+#include "object_sprites.h"
+#include "quality.h"
+#include "sprite_tiles.h"
 #include <gba_input.h> // ADDED: Needed for keysHeld() and KEY_UP
 
 // NOTE: EWRAM_DATA is for initialized data (like the char arrays).
@@ -496,55 +506,166 @@ const bool selector[2][64] EWRAM_DATA = {
 
 // --- Double Buffering Implementation ---
 
-// 1. Define and allocate the back buffer memory in the .c file.
-// FIX: Use EWRAM_BSS for the uninitialized buffer to avoid section conflict.
-M3LINE back_buffer[SCREEN_HEIGHT] EWRAM_BSS; 
+// Points at the frame the frame pipeline is drawing into: an EWRAM buffer
+// in Mode 3, the hidden VRAM page in the paletted renderers
+FRAMELINE *back_buffer;
+
+// Rows drawing is clipped to: the screen, or the band the display list is
+// rasterizing
+static int clip_top = 0;
+static int clip_bottom = SCREEN_HEIGHT;
+
+#ifdef RENDER_PALETTED
+// BG palette behind the CLR_* indices in graphics.h
+static const u16 PALETTE_RGB[CLR_COUNT] = {
+    RGB5( 0,  0,  0), // CLR_BLACK
+    RGB5(31,  0,  0), // CLR_RED
+    RGB5( 0, 31,  0), // CLR_LIME
+    RGB5(31, 31,  0), // CLR_YELLOW
+    RGB5( 0,  0, 31), // CLR_BLUE
+    RGB5(31,  0, 31), // CLR_MAG
+    RGB5( 0, 31, 31), // CLR_CYAN
+    RGB5(31, 31, 31), // CLR_WHITE
+};
+
+// Red, yellow, lime, cyan, blue, magenta: the Mode 3 bullet_colors and
+// main.c rainbow_colors order
+static const u16 RAINBOW_RGB[BULLET_COLOR_COUNT] = {
+    RGB5(31,  0,  0), RGB5(31, 31,  0), RGB5( 0, 31,  0),
+    RGB5( 0, 31, 31), RGB5( 0,  0, 31), RGB5(31,  0, 31),
+};
+
+// The CLR_ANIM_* cycles; each entry starts one color further on, like the
+// staggered color indices they replace
+static void initPaletteCycles(void) {
+    static const PaletteCycle cycles[] = {
+        // Bullets step at the game logic's old colorIdx pace
+        { RAINBOW_RGB, BULLET_COLOR_COUNT, CLR_ANIM_BULLET, BULLET_COLOR_COUNT, BULLET_COLOR_TICK, 0 },
+        // The ring and circles stepped once per frame
+        { RAINBOW_RGB, BULLET_COLOR_COUNT, CLR_ANIM_RING, 1, 1, 0 },
+#ifndef RENDER_TILED // The tiled renderer's circles use the bullet entries
+        { RAINBOW_RGB, BULLET_COLOR_COUNT, CLR_ANIM_CIRCLES, CLR_ANIM_CIRCLE_COUNT, 1, 0 },
+#endif
+    };
+    paletteAnimReset();
+    for (unsigned i = 0; i < sizeof(cycles) / sizeof(cycles[0]); i++) {
+        paletteCycleAdd(&cycles[i]);
+    }
+}
+#endif
+
+#ifdef RENDER_TILED
+#define FRAME_TILE_COLS     (SCREEN_WIDTH / 8)
+#define FRAME_MAP_BLOCK     31 // Screen block of the BG2 map
+#endif
 
 /**
- * Copies the completed frame from the RAM back buffer to the visible VRAM.
- * Optimized: Use memcpy for faster bulk copy (faster than pixel-by-pixel loop).
+ * Sets up the display mode of the selected renderer (and its palette).
  */
-void flipBuffer() {
-    // This is the actual VRAM address (visible buffer)
-    volatile u32 *vram_ptr = (volatile u32*)MEM_VRAM; 
-    // This is the RAM buffer pointer (hidden buffer)
-    u32 *back_ptr = (u32*)back_buffer;
-    
-    // Use u32 copies (4 bytes at a time, 2 pixels per write) for maximum efficiency
-    // Total pixels: 240 * 160 = 38400; in u32: 38400 / 2 = 19200
-    for (int i = 0; i < (SCREEN_WIDTH * SCREEN_HEIGHT / 2); i++) {
-        vram_ptr[i] = back_ptr[i];
+void initGraphics() {
+    stampCacheInit();
+#ifdef RENDER_PALETTED
+    for (int i = 0; i < CLR_COUNT; i++) {
+        BG_PALETTE[i] = PALETTE_RGB[i];
     }
+    initPaletteCycles();
+#endif
+#if defined(RENDER_TILED)
+    // BG2 shows the frame's tiles in order, so tile n of a page is the
+    // n-th 8x8 block of the screen in reading order
+    u16 *map = (u16 *)SCREEN_BASE_BLOCK(FRAME_MAP_BLOCK);
+    for (int ty = 0; ty < SCREEN_HEIGHT / 8; ty++) {
+        for (int tx = 0; tx < FRAME_TILE_COLS; tx++) {
+            map[ty * 32 + tx] = ty * FRAME_TILE_COLS + tx;
+        }
+    }
+    REG_BG2CNT = CHAR_BASE(0) | SCREEN_BASE(FRAME_MAP_BLOCK) | BG_16_COLOR | BG_PRIORITY(0); // Page 0 shown first
+    SetMode(MODE_0 | BG2_ON);
+    initBackgrounds();
+#elif defined(RENDER_MODE4)
+    SetMode(MODE_4 | BG2_ON); // Page 0 shown first
+#else
+    SetMode(MODE_3 | BG2_ON);
+#endif
+}
+
+/**
+ * Hands the completed frame to the frame pipeline, which presents it at the
+ * next VBlank, and switches drawing to the other buffer.
+ * Drawing code must not assume the new back buffer holds the frame just
+ * finished (see frameRetain()).
+ */
+void flipBuffer() {
+    frameSubmit();
 }
 
 // --- Graphics Implementation ---
 
-// Get a pointer to the DRAWING buffer (now the RAM back_buffer)
-volatile u16* videoBuffer = (u16*)back_buffer;
+#if defined(RENDER_TILED)
+// Tiled pixels are nibbles (even x in the low one), four to the u16; tile
+// rows are 4 bytes, tiles 32 bytes in screen reading order
+static inline vu16 *pixelQuad(int x, int y) {
+    return (vu16 *)back_buffer + ((y >> 3) * FRAME_TILE_COLS + (x >> 3)) * 16
+                               + (y & 7) * 2 + ((x & 7) >> 2);
+}
+
+static inline void plotPixel(int x, int y, u16 color) {
+    vu16 *quad = pixelQuad(x, y);
+    int shift = (x & 3) * 4;
+    *quad = (*quad & ~(0xF << shift)) | (color << shift);
+}
+#elif defined(RENDER_MODE4)
+// VRAM takes no byte writes, so Mode 4 pixels are written as the u16 that
+// holds them and their neighbor (even x in the low byte)
+static inline vu16 *pixelPair(int x, int y) {
+    return (vu16 *)&back_buffer[y][x & ~1];
+}
+
+static inline void plotPixel(int x, int y, u16 color) {
+    vu16 *pair = pixelPair(x, y);
+    if (x & 1) *pair = (*pair & 0x00FF) | (color << 8);
+    else       *pair = (*pair & 0xFF00) | color;
+}
+#else
+static inline void plotPixel(int x, int y, u16 color) {
+    back_buffer[y][x] = color;
+}
+#endif
+
+void setDrawRows(int top, int bottom) {
+    clip_top = top;
+    clip_bottom = bottom;
+}
 
 // Sets the color of a single pixel
 void setPixel(int x, int y, u16 color) {
+    if (displayListRecording()) {
+        displayListPixel(x, y, color);
+        return;
+    }
     // Check boundaries
-    if (x >= 0 && x < SCREEN_WIDTH && y >= 0 && y < SCREEN_HEIGHT) {
-        // videoBuffer now points to the RAM buffer.
-        videoBuffer[y * SCREEN_WIDTH + x] = color; 
+    if (x >= 0 && x < SCREEN_WIDTH && y >= clip_top && y < clip_bottom) {
+        plotPixel(x, y, color);
     }
 }
 
 // Draws a line between two points (a simple DDA-like implementation)
 // This is required for drawing the ship's triangle outline.
 void drawLine(int x0, int y0, int x1, int y1, u16 color) {
+    if (displayListRecording()) {
+        displayListLine(x0, y0, x1, y1, color);
+        return;
+    }
     int dx = abs(x1 - x0);
     int dy = abs(y1 - y0);
     int sx = (x0 < x1) ? 1 : -1;
     int sy = (y0 < y1) ? 1 : -1;
     int err = dx - dy;
     int e2;
-    volatile u16* vram = (u16*)back_buffer;
     
     for (;;) {
-        if (x0 >= 0 && x0 < SCREEN_WIDTH && y0 >= 0 && y0 < SCREEN_HEIGHT) {
-            vram[y0 * SCREEN_WIDTH + x0] = color;
+        if (x0 >= 0 && x0 < SCREEN_WIDTH && y0 >= clip_top && y0 < clip_bottom) {
+            plotPixel(x0, y0, color);
         }
         if (x0 == x1 && y0 == y1) break;
         e2 = 2 * err;
@@ -559,37 +680,102 @@ void drawLine(int x0, int y0, int x1, int y1, u16 color) {
     }
 }
 
-// Clears the entire screen (optimized: direct buffer writes)
+// Clears the entire screen (a block fill, mem_ops.h)
 void clearScreen() {
-    volatile u16* vram = (u16*)back_buffer;
-    for (int i = 0; i < SCREEN_WIDTH * SCREEN_HEIGHT; i++) {
-        vram[i] = CLR_BLACK;
+    if (displayListRecording()) {
+        displayListClear();
+        return;
     }
+    memFill32(back_buffer, 0, sizeof(FRAMELINE) * SCREEN_HEIGHT);
 }
 
-// Clears a rectangular region to black (optimized with u32 chunk writes where aligned)
+// Fills pixels [x0, x1) of row y with whole words where the renderer's
+// pixels allow; only the partial words at the ends are read back
+static inline void fillSpan(int y, int x0, int x1, u16 color) {
+    int i = x0;
+#if defined(RENDER_TILED)
+    u16 quad = color * 0x1111;
+    for (; (i & 3) && i < x1; i++) plotPixel(i, y, color);
+    for (; i + 3 < x1; i += 4) *pixelQuad(i, y) = quad;
+    for (; i < x1; i++) plotPixel(i, y, color);
+#elif defined(RENDER_MODE4)
+    // Odd edge pixels share a u16 with a pixel outside the span
+    if (i >= x1) return;
+    if (i & 1) plotPixel(i++, y, color);
+    vu16 *pair = pixelPair(i, y);
+    u16 both = color | (color << 8);
+    for (; i + 1 < x1; i += 2) {
+        *pair++ = both;
+    }
+    if (i < x1) plotPixel(i, y, color);
+#else
+    // u32 chunks (2 pixels per write) from the first even x
+    if (i >= x1) return;
+    if (i & 1) back_buffer[y][i++] = color;
+    vu32 *row32 = (vu32 *)&back_buffer[y][i];
+    u32 both = color | (color << 16);
+    for (; i + 1 < x1; i += 2) {
+        *row32++ = both;
+    }
+    if (i < x1) back_buffer[y][i] = color;
+#endif
+}
+
+// Clears a rectangular region to black (optimized with word writes where aligned)
 void clearRegion(int x, int y, int width, int height) {
-    volatile u16* vram = (u16*)back_buffer;
+    if (displayListRecording()) {
+        displayListFill(x, y, width, height);
+        return;
+    }
+    int start_x = (x >= 0) ? x : 0;
+    int end_x = (x + width <= SCREEN_WIDTH) ? (x + width) : SCREEN_WIDTH;
+    if (start_x >= end_x) return;
+
+    // Full-width rows are one block in memory (tiled: whole rows of tiles)
+    int top = (y > clip_top) ? y : clip_top;
+    int bottom = (y + height < clip_bottom) ? (y + height) : clip_bottom;
+    if (start_x == 0 && end_x == SCREEN_WIDTH && top < bottom &&
+        top % FRAME_ROW_ALIGN == 0 && bottom % FRAME_ROW_ALIGN == 0) {
+        memFill32(back_buffer[top], 0, (bottom - top) * sizeof(FRAMELINE));
+        return;
+    }
+
     for (int j = 0; j < height; j++) {
         int py = y + j;
-        if (py >= 0 && py < SCREEN_HEIGHT) {
-            int start_x = (x >= 0) ? x : 0;
-            int end_x = (x + width <= SCREEN_WIDTH) ? (x + width) : SCREEN_WIDTH;
-            
-            // Write u32 chunks (2 pixels per write) where properly aligned for speed
-            if ((start_x & 1) == 0 && ((end_x - start_x) & 1) == 0) {
-                volatile u32* vram32 = (volatile u32*)back_buffer;
-                int pairs = (end_x - start_x) / 2;
-                int offset = (py * SCREEN_WIDTH + start_x) / 2;
-                for (int p = 0; p < pairs; p++) {
-                    vram32[offset + p] = 0; // 0 = two u16 black pixels
-                }
-            } else {
-                // Fallback for misaligned regions
-                for (int i = start_x; i < end_x; i++) {
-                    vram[py * SCREEN_WIDTH + i] = CLR_BLACK;
-                }
-            }
+        if (py >= clip_top && py < clip_bottom) {
+            fillSpan(py, start_x, end_x, CLR_BLACK);
+        }
+    }
+}
+
+/**
+ * Draws a cached stamp (stamp_cache.h) centered on (cx, cy): each span is
+ * clipped to the screen and filled, with no per-pixel shape work.
+ */
+void drawStamp(int stamp, int cx, int cy, u16 color) {
+    int side;
+    const u8 *span = stampSpans(stamp, &side);
+    if (!span) return;
+    if (displayListRecording()) {
+        displayListStamp(stamp, cx, cy, side, color);
+        return;
+    }
+    int left = cx - side / 2;
+    int top = cy - side / 2;
+
+    for (int row = 0; row < side; row++) {
+        int count = *span++;
+        int py = top + row;
+        if (py < clip_top || py >= clip_bottom) {
+            span += 2 * count;
+            continue;
+        }
+        int x = left;
+        for (; count > 0; count--, span += 2) {
+            x += span[0];
+            int end = x + span[1];
+            fillSpan(py, (x > 0) ? x : 0, (end < SCREEN_WIDTH) ? end : SCREEN_WIDTH, color);
+            x = end;
         }
     }
 }
@@ -602,18 +788,56 @@ void clearPrevious(GameObject *obj) {
 
 // Draws an 8x8 character from a boolean array (optimized: skip black pixels)
 void printChar(const bool charData[64], int x, int y) {
-    for (int j = 0; j < CHAR_PIX_SIZE; j++) {
-        for (int i = 0; i < CHAR_PIX_SIZE; i++) {
-            // Only draw white pixels; skip black for performance
-            if (charData[j * CHAR_PIX_SIZE + i]) {
-                setPixel(x + i, y + j, CLR_WHITE);
-            }
-        }
-    }
+    printCharColor(charData, x, y, CLR_WHITE);
 }
 
 // Draw an 8x8 character in an arbitrary color
 void printCharColor(const bool charData[64], int x, int y, u16 color) {
+    if (displayListRecording()) {
+        displayListGlyph(charData, x, y, color);
+        return;
+    }
+#if defined(RENDER_TILED)
+    // At a multiple of 4 each glyph row covers two whole pixel quads: full
+    // quads are one store, the rest one read-modify-write
+    if (!(x & 3) && x >= 0 && x + CHAR_PIX_SIZE <= SCREEN_WIDTH) {
+        for (int j = 0; j < CHAR_PIX_SIZE; j++) {
+            int py = y + j;
+            if (py < clip_top || py >= clip_bottom) continue;
+            const bool *row = &charData[j * CHAR_PIX_SIZE];
+            for (int k = 0; k < CHAR_PIX_SIZE; k += 4) {
+                u16 mask = 0, bits = 0;
+                for (int b = 0; b < 4; b++) {
+                    if (!row[k + b]) continue;
+                    mask |= 0xF << (b * 4);
+                    bits |= color << (b * 4);
+                }
+                if (!mask) continue;
+                vu16 *quad = pixelQuad(x + k, py);
+                *quad = (mask == 0xFFFF) ? bits : ((*quad & ~mask) | bits);
+            }
+        }
+        return;
+    }
+#elif defined(RENDER_MODE4)
+    // At an even x each glyph row covers four whole pixel pairs: pairs with
+    // both pixels set are one store, only half-set pairs need a read
+    if (!(x & 1) && x >= 0 && x + CHAR_PIX_SIZE <= SCREEN_WIDTH) {
+        u16 both = color | (color << 8);
+        for (int j = 0; j < CHAR_PIX_SIZE; j++) {
+            int py = y + j;
+            if (py < clip_top || py >= clip_bottom) continue;
+            const bool *row = &charData[j * CHAR_PIX_SIZE];
+            vu16 *pair = pixelPair(x, py);
+            for (int k = 0; k < CHAR_PIX_SIZE; k += 2, pair++) {
+                if (row[k] && row[k + 1]) *pair = both;
+                else if (row[k])          *pair = (*pair & 0xFF00) | color;
+                else if (row[k + 1])      *pair = (*pair & 0x00FF) | (color << 8);
+            }
+        }
+        return;
+    }
+#endif
     for (int j = 0; j < CHAR_PIX_SIZE; j++) {
         for (int i = 0; i < CHAR_PIX_SIZE; i++) {
             if (charData[j * CHAR_PIX_SIZE + i]) {
@@ -623,52 +847,29 @@ void printCharColor(const bool charData[64], int x, int y, u16 color) {
     }
 }
 
+// Glyph of a displayable character (letters are upper case only)
+const bool *charGlyph(char c) {
+    if (c == '!') return punctuation[1];
+    if (c == ':') return punctuation[2];
+    if (c == '.') return punctuation[0];
+    if (c >= '0' && c <= '9') return score[c - '0'];
+    if (c == ' ') return score[10]; // score[10] is the blank char
+    if (c >= 'A' && c <= 'Z') return alphabet[c - 'A'];
+    return NULL;
+}
+
 // Draws a string of text in an arbitrary color
 void displayTextColor(const char* text, int x, int y, u16 color) {
     int len = strlen(text);
     for (int i = 0; i < len; i++) {
-        char c = text[i];
-        if (c == '!') {
-            printCharColor(punctuation[1], x + i * CHAR_PIX_SIZE, y, color);
-        } else if (c == ':') {
-            printCharColor(punctuation[2], x + i * CHAR_PIX_SIZE, y, color);
-        } else if (c == '.') {
-            printCharColor(punctuation[0], x + i * CHAR_PIX_SIZE, y, color);
-        } else if (c >= '0' && c <= '9') {
-            printCharColor(score[c - '0'], x + i * CHAR_PIX_SIZE, y, color);
-        } else if (c == ' ') {
-            printCharColor(score[10], x + i * CHAR_PIX_SIZE, y, color);
-        } else if (c >= 'A' && c <= 'Z') {
-            printCharColor(alphabet[c - 'A'], x + i * CHAR_PIX_SIZE, y, color);
-        }
+        const bool *glyph = charGlyph(text[i]);
+        if (glyph) printCharColor(glyph, x + i * CHAR_PIX_SIZE, y, color);
     }
 }
 
 // Draws a string of text
 void displayText(const char* text, int x, int y) {
-    int len = strlen(text);
-    for (int i = 0; i < len; i++) {
-        char c = text[i];
-        
-        // Exclamation Point
-        if (c == '!') { 	
-            printChar(punctuation[1], x + i * CHAR_PIX_SIZE, y);
-        } else if (c == ':') { 
-            printChar(punctuation[2], x + i * CHAR_PIX_SIZE, y);
-        // Period
-        } else if (c == '.') { 	
-            printChar(punctuation[0], x + i * CHAR_PIX_SIZE, y);
-        // Numbers 0-9
-        } else if (c >= '0' && c <= '9') { 	
-            printChar(score[c - '0'], x + i * CHAR_PIX_SIZE, y);
-        // Space
-        } else if (c == ' ') {
-            printChar(score[10], x + i * CHAR_PIX_SIZE, y); // score[10] is the blank char
-        // Letters A-Z (Capitalize all)
-        } else if (c >= 'A' && c <= 'Z') {
-            printChar(alphabet[c - 'A'], x + i * CHAR_PIX_SIZE, y);
-        }
-    }
+    displayTextColor(text, x, y, CLR_WHITE);
 }
 
 // Clears the main menu area
@@ -677,7 +878,8 @@ void clearMenu() {
                 CHAR_PIX_SIZE * 20, LINE_HEIGHT * 4);
 }
 
-// Draws the player ship (RESTORED TRIANGLE ROTATION LOGIC)
+// Places the player ship sprite (the hardware rotates the triangle, see
+// vector_sprites.c) and draws the engine flare behind it
 void drawPlayerShip(GameObject *ship) {
     // 1. Clear the previous drawing area
     clearPrevious(ship);
@@ -686,55 +888,17 @@ void drawPlayerShip(GameObject *ship) {
     int centerX = FP_TO_INT(ship->x) + (ship->width / 2); // Corrected to int from float
     int centerY = FP_TO_INT(ship->y) + (ship->height / 2); // Corrected to int from float
 
-    // 3. Define the vertices of the ship's triangle relative to its center (at angle 0/East)
-    int offset = ship->width / 2; // = 4 for an 8x8 ship
-    int front_offset = offset + PLAYER_FRONT_EXTEND; // extend the front tip for visibility
-    // Vertices for an 8x8 ship (PLAYER_SIZE is 8):
-    // Front point: (+front_offset, 0)
-    // Left back:   (-4, +4)
-    // Right back:  (-4, -4)
-    // Move the rear vertices inward to form an arrow-like tail
-    int back_inset = PLAYER_BACK_INSET;
-    int initial_vertices[3][2] = {
-        { front_offset, 0 },
-        { -offset + back_inset, offset - back_inset },
-        { -offset + back_inset, -offset + back_inset }
-    };
+    // 3. The triangle: an affine sprite rotated to the ship's angle
+    showShipSprite(centerX, centerY, ship->angle);
 
-    // 4. Calculate the rotation parameters (compute integer fixed-point sin/cos from angle)
+    // 4. Rotation parameters for the flare (integer fixed-point sin/cos from angle)
+    int offset = ship->width / 2; // = 4 for an 8x8 ship
     int cosA_fp = cos_fp_deg(ship->angle);
     int sinA_fp = sin_fp_deg(ship->angle);
 
-    int rotated_vertices[3][2];
-
-    // Rotation calculation: x' = x*cos(A) - y*sin(A), y' = x*sin(A) + y*cos(A)
-    // All calculations are fixed-point multiplication, resulting in an integer coordinate after shifting.
-    for (int i = 0; i < 3; i++) {
-        int x_rel = initial_vertices[i][0]; // Integer relative X
-        int y_rel = initial_vertices[i][1]; // Integer relative Y
-
-        // x' (integer result) = (x_rel * cosA_fp - y_rel * sinA_fp) >> FP_SHIFT
-        rotated_vertices[i][0] = centerX + 
-            (((x_rel * cosA_fp) - (y_rel * sinA_fp)) >> FP_SHIFT);
-
-        // y' (integer result) = (x_rel * sinA_fp + y_rel * cosA_fp) >> FP_SHIFT
-        rotated_vertices[i][1] = centerY + 
-            (((x_rel * sinA_fp) + (y_rel * cosA_fp)) >> FP_SHIFT);
-    }
-
-    u16 color = CLR_LIME;
-
-    // 5. Draw the three lines of the triangle
-    drawLine(rotated_vertices[0][0], rotated_vertices[0][1], 
-             rotated_vertices[1][0], rotated_vertices[1][1], color);
-    drawLine(rotated_vertices[1][0], rotated_vertices[1][1], 
-             rotated_vertices[2][0], rotated_vertices[2][1], color);
-    drawLine(rotated_vertices[2][0], rotated_vertices[2][1], 
-             rotated_vertices[0][0], rotated_vertices[0][1], color);
-
     // Also draw the 'engine flare' when thrusting (KEY_UP is pressed)
     u16 keys_held = keysHeld();
-    if (keys_held & KEY_UP || keys_held & KEY_B) {
+    if ((keys_held & KEY_UP || keys_held & KEY_B) && qualityEnabled(QFX_THRUSTER_FLARE)) {
         // Calculate the back center: (centerX + (-offset * cosA) >> 8, centerY + (-offset * sinA) >> 8)
         int flareX = centerX + (((-offset * cosA_fp)) >> FP_SHIFT);
         int flareY = centerY + (((-offset * sinA_fp)) >> FP_SHIFT);
@@ -752,11 +916,24 @@ void drawBullet(GameObject *bullet) {
     int x = FP_TO_INT(bullet->x);
     int y = FP_TO_INT(bullet->y);
     
+#ifdef RENDER_TILED
+    // A sprite; colorIdx cycles through the rainbow banks (game_logic.c)
+    objectSpriteAdd(SPRITE_SHAPE_CIRCLE, 2, x, y, bullet->colorIdx);
+#else
+#ifdef RENDER_PALETTED
+    // colorIdx stays fixed and picks the bullet's entry in the palette cycle,
+    // which costs nothing to animate, so the quality governor leaves it on
+    u16 color = CLR_ANIM_BULLET + bullet->colorIdx;
+#else
     // Color cycle for bullets: match the bouncing circles' rainbow palette
-    static const u16 bullet_colors[] = { CLR_RED, CLR_YELLOW, CLR_LIME, CLR_CYAN, CLR_BLUE, CLR_MAG };
-    const int BULLET_COLOR_COUNT = sizeof(bullet_colors) / sizeof(u16);
-    u16 color = bullet_colors[bullet->colorIdx % BULLET_COLOR_COUNT];
-    drawCircle(x, y, 2, color);
+    // (colorIdx is kept in [0, BULLET_COLOR_COUNT) by the game logic)
+    static const u16 bullet_colors[BULLET_COLOR_COUNT] = { CLR_RED, CLR_YELLOW, CLR_LIME, CLR_CYAN, CLR_BLUE, CLR_MAG };
+    u16 color = qualityEnabled(QFX_BULLET_CYCLE)
+                    ? bullet_colors[bullet->colorIdx]
+                    : CLR_CYAN;
+#endif
+    drawStamp(stampGet(STAMP_CIRCLE, 2, 0), x, y, color);
+#endif
 }
 
 // Draws an asteroid as a filled circle
@@ -770,62 +947,147 @@ void drawAsteroid(Asteroid *asteroid) {
     u16 color;
     int radius;
     if (asteroid->sizeType == ASTEROID_SIZE_L) {
-        color = RGB5(31, 0, 0);  // Red for large
+        color = CLR_RED;  // Red for large
         radius = 10;
     } else if (asteroid->sizeType == ASTEROID_SIZE_M) {
-        color = RGB5(31, 0, 31); // Magenta for medium
+        color = CLR_MAG;  // Magenta for medium
         radius = 6;
     } else {
-        color = RGB5(31, 31, 0); // Yellow for small
+        color = CLR_YELLOW; // Yellow for small
         radius = 3;
     }
     
-    // Draw filled circle
-    drawCircle(x, y, radius, color);
+#ifdef RENDER_TILED
+    // A sprite in the matching rainbow bank (red, magenta or yellow)
+    int colorIdx = (color == CLR_RED) ? 0 : (color == CLR_MAG) ? 5 : 1;
+    objectSpriteAdd(SPRITE_SHAPE_CIRCLE, radius, x, y, colorIdx);
+    return;
+#endif
+
+    // Draw the outline (a cached stamp); under load, only every other step of it
+    int shape = qualityEnabled(QFX_FULL_OUTLINES) ? STAMP_CIRCLE : STAMP_CIRCLE_DOTTED;
+    drawStamp(stampGet(shape, radius, 0), x, y, color);
 }
 
 // Draws the score and lives
 void drawScoreboard(int score, int lives, int highScore) {
+    char scoreText[16];
+    char hiText[20];
+    char livesText[16];
+    sprintf(scoreText, "SCORE: %d", score);
+    sprintf(hiText, "HI: %d", highScore);
+    sprintf(livesText, "LIVES: %d", lives);
+    int livesX = SCREEN_WIDTH - (8 * CHAR_PIX_SIZE + 10);
+
+#ifdef RENDER_TILED
+    // The text background (backgrounds.h) keeps the HUD; it is only redrawn
+    // when a value changes
+    hudText(HUD_SCORE, 10, SCORE_Y, scoreText, CLR_WHITE);
+    hudText(HUD_HIGH, 10, PLAYER_SYM_Y, hiText, CLR_RED);
+    hudText(HUD_LIVES, livesX, SCORE_Y, livesText, CLR_WHITE);
+#else
     // Clear Score Area
     clearRegion(0, SCORE_Y, SCREEN_WIDTH, LINE_HEIGHT);
     clearRegion(0, SCREEN_HEIGHT - LINE_HEIGHT - SCORE_Y, SCREEN_WIDTH, LINE_HEIGHT);
 
     // Draw Score
-    char scoreText[16];
-    sprintf(scoreText, "SCORE: %d", score);
     displayText(scoreText, 10, SCORE_Y);
 
-    // Draw High Score (right of the score area)
-    char hiText[20];
-    sprintf(hiText, "HI: %d", highScore);
     // place high-score in the bottom-left corner in red
     displayTextColor(hiText, 10, PLAYER_SYM_Y, CLR_RED);
 
     // Draw Lives
-    char livesText[16];
-    sprintf(livesText, "LIVES: %d", lives);
-    displayText(livesText, SCREEN_WIDTH - (8 * CHAR_PIX_SIZE + 10), SCORE_Y);
+    displayText(livesText, livesX, SCORE_Y);
+#endif
+}
+
+#ifdef RENDER_TILED
+static int s_hudScore, s_hudLives, s_hudHigh;
+
+void updateScoreboardCache(int score, int lives, int highScore) {
+    s_hudScore = score;
+    s_hudLives = lives;
+    s_hudHigh = highScore;
+}
+
+void drawScoreboardCached(void) {
+    drawScoreboard(s_hudScore, s_hudLives, s_hudHigh);
+}
+#else
+static const int HUD_BAND_Y[2] = { SCORE_Y, PLAYER_SYM_Y };
+static FRAMELINE s_hudBands[2][LINE_HEIGHT] EWRAM_BSS;
+static int s_hudScore = -1, s_hudLives = -1, s_hudHigh = -1;
+
+void updateScoreboardCache(int score, int lives, int highScore) {
+    if (score == s_hudScore && lives == s_hudLives && highScore == s_hudHigh) return;
+    s_hudScore = score;
+    s_hudLives = lives;
+    s_hudHigh = highScore;
+
+    // Draw the whole scoreboard into each band in turn, as the display
+    // list rasterizes a strip: rows addressed by screen y, clipped to it
+    FRAMELINE *target = back_buffer;
+    for (int b = 0; b < 2; b++) {
+        int y = HUD_BAND_Y[b];
+        back_buffer = s_hudBands[b] - y;
+        setDrawRows(y, y + LINE_HEIGHT);
+        drawScoreboard(score, lives, highScore);
+    }
+    back_buffer = target;
+    setDrawRows(0, SCREEN_HEIGHT);
+}
+
+void drawScoreboardCached(void) {
+    for (int b = 0; b < 2; b++) {
+        copyRows(s_hudBands[b], HUD_BAND_Y[b], LINE_HEIGHT);
+    }
+}
+#endif
+
+void copyRows(const FRAMELINE *rows, int y, int height) {
+    if (displayListRecording()) {
+        displayListRows(rows, y, height);
+        return;
+    }
+    for (int j = 0; j < height; j++) {
+        int py = y + j;
+        if (py >= clip_top && py < clip_bottom) {
+            memCopy32(back_buffer[py], rows[j], sizeof(FRAMELINE));
+        }
+    }
 }
 
 // Draw the perimeter of a circle using an integer midpoint algorithm (optimized: skip duplicate octants)
 void drawCircle(int cx, int cy, int radius, u16 color) {
+    drawCircleStep(cx, cy, radius, color, 1);
+}
+
+// Midpoint circle that plots only every 'step'-th octant step (step 1 = solid outline)
+void drawCircleStep(int cx, int cy, int radius, u16 color, int step) {
+    if (displayListRecording()) {
+        displayListCircle(cx, cy, radius, color, step);
+        return;
+    }
     int x = radius;
     int y = 0;
     int err = 0;
-    volatile u16* vram = (u16*)back_buffer;
+    int phase = 0;
 
     while (x >= y) {
-        // Draw all 8 octants efficiently with bounds check
-        int pts[8][2] = {
-            {cx + x, cy + y}, {cx + y, cy + x}, {cx - y, cy + x}, {cx - x, cy + y},
-            {cx - x, cy - y}, {cx - y, cy - x}, {cx + y, cy - x}, {cx + x, cy - y}
-        };
-        for (int p = 0; p < 8; p++) {
-            int px = pts[p][0], py = pts[p][1];
-            if (px >= 0 && px < SCREEN_WIDTH && py >= 0 && py < SCREEN_HEIGHT) {
-                vram[py * SCREEN_WIDTH + px] = color;
+        if (phase == 0) {
+            // Draw all 8 octants efficiently with bounds check
+            int pts[8][2] = {
+                {cx + x, cy + y}, {cx + y, cy + x}, {cx - y, cy + x}, {cx - x, cy + y},
+                {cx - x, cy - y}, {cx - y, cy - x}, {cx + y, cy - x}, {cx + x, cy - y}
+            };
+            for (int p = 0; p < 8; p++) {
+                int px = pts[p][0], py = pts[p][1];
+                if (px >= 0 && px < SCREEN_WIDTH && py >= clip_top && py < clip_bottom) {
+                    plotPixel(px, py, color);
+                }
             }
         }
+        if (++phase >= step) phase = 0;
 
         y++;
         if (err <= 0) {
@@ -5,17 +5,36 @@
 #define SCREEN_WIDTH    240
 #define SCREEN_HEIGHT   160
 
-// OAM Tile indices for asteroids and bullets
-#define TILE_ASTEROID_L     0   // 16x16 asteroid (large)
-#define TILE_ASTEROID_M     1   // 16x16 asteroid (medium)
-#define TILE_ASTEROID_S     2   // 8x8 asteroid (small)
-#define TILE_BULLET         3   // 8x8 bullet
-
 // OAM Size bits
 #define ATTR1_SIZE_8        0x0000 // 8x8 size
 #define ATTR1_SIZE_16       0x4000 // 16x16 size
+#define ATTR1_SIZE_32       0x8000 // 32x32 size
 
-// Color definitions
+// Color definitions: 15-bit colors in Mode 3, BG palette indices in the
+// paletted renderers (make RENDERER=mode4 or RENDERER=tiled; the palette is
+// loaded by initGraphics())
+#ifdef RENDER_PALETTED
+#define CLR_BLACK       0
+#define CLR_RED         1
+#define CLR_LIME        2
+#define CLR_YELLOW      3
+#define CLR_BLUE        4
+#define CLR_MAG         5
+#define CLR_CYAN        6
+#define CLR_WHITE       7
+#define CLR_COUNT       8
+// Entries after the fixed colors are color cycles run by palette_anim.c
+#define CLR_ANIM_BULLET         CLR_COUNT                              // BULLET_COLOR_COUNT entries, one per colorIdx
+#define CLR_ANIM_RING           (CLR_ANIM_BULLET + BULLET_COLOR_COUNT) // Respawn ring
+#ifdef RENDER_TILED
+// 4bpp tiles only reach 16 colors: the game-over circles share the bullet cycle
+#define CLR_ANIM_CIRCLES        CLR_ANIM_BULLET
+#define CLR_ANIM_CIRCLE_COUNT   BULLET_COLOR_COUNT
+#else
+#define CLR_ANIM_CIRCLES        (CLR_ANIM_RING + 1)                    // Game-over circles
+#define CLR_ANIM_CIRCLE_COUNT   4
+#endif
+#else
 #define CLR_BLACK       0x0000
 #define CLR_RED         0x001F
 #define CLR_LIME        0x03E0
@@ -24,6 +43,7 @@
 #define CLR_MAG         0x7C1F
 #define CLR_CYAN        0x7FE0
 #define CLR_WHITE       0x7FFF
+#endif
 
 #define CHAR_PIX_SIZE   8
 #define LINE_HEIGHT     12
@@ -48,14 +68,31 @@
 #define PLAYER_SYM_Y    (SCREEN_HEIGHT-LINE_HEIGHT-SCORE_Y)
 
 typedef u16             M3LINE[SCREEN_WIDTH];
+typedef u8              M4LINE[SCREEN_WIDTH];
+// The tiled renderer's frame is 30x20 4bpp BG tiles stored in order. A
+// TILEDLINE has the size of a pixel row, but only FRAME_ROW_ALIGN of them,
+// from a multiple of it, make up whole rows (of tiles).
+typedef u8              TILEDLINE[SCREEN_WIDTH / 2];
 
-// --- Double Buffering Declarations ---
-// Declare the back buffer in RAM. Defined in graphics.c
-extern M3LINE back_buffer[SCREEN_HEIGHT]; 
+#if defined(RENDER_TILED)
+typedef TILEDLINE       FRAMELINE;
+#define MEM_VRAM_PAGE1  (MEM_VRAM + 0x8000) // Char block 2
+#define FRAME_ROW_ALIGN 8
+#elif defined(RENDER_MODE4)
+typedef M4LINE          FRAMELINE;
+#define MEM_VRAM_PAGE1  (MEM_VRAM + 0xA000)
+#define FRAME_ROW_ALIGN 1
+#else
+typedef M3LINE          FRAMELINE;
+#define FRAME_ROW_ALIGN 1
+#endif
 
-// Redefine m3_vram to point to the back buffer for all drawing operations.
-// This is the simplest way to direct all existing drawing functions to RAM.
-#define m3_vram         ((M3LINE*)back_buffer) 
+// --- Double Buffering Declarations ---
+// The frame being drawn; flipBuffer() switches it between the frame
+// pipeline's buffers (frame_pipeline.h). Draw through the functions below:
+// Mode 4 pixels are bytes that VRAM only takes in pairs, tiled pixels are
+// nibbles in tile order.
+extern FRAMELINE *back_buffer;
 
 // Menu structure definition
 struct MenuScreen {
@@ -63,23 +100,40 @@ struct MenuScreen {
 };
 
 // --- Graphics Drawing Functions ---
+void initGraphics(); // Display mode (and Mode 4 palette) of the selected renderer
 void clearScreen();
 void clearRegion(int x, int y, int w, int h);
+void setDrawRows(int top, int bottom); // Clips drawing to rows [top, bottom)
 void setPixel(int x, int y, u16 color); // Prototype added
 // Draw a line between two points
 void drawLine(int x0, int y0, int x1, int y1, u16 color);
 void displayText(const char* text, int x, int y); 
+void displayTextColor(const char* text, int x, int y, u16 color);
 void printChar(const bool char_map[64], int x, int y);
+void printCharColor(const bool char_map[64], int x, int y, u16 color);
+const bool *charGlyph(char c); // 8x8 glyph displayText draws for c, or NULL
 void clearMenu();
-void flipBuffer(); // NEW: Function to copy back buffer to VRAM
+void flipBuffer(); // Queues the back buffer for the next VBlank and switches buffers
 
 // Game Object Drawing
 void drawPlayerShip(GameObject *ship);
 void drawAsteroid(Asteroid *asteroid);
 void drawBullet(GameObject *bullet);
 void drawScoreboard(int score, int lives, int highScore);
+// Scoreboard from a cache of its two bands (SCORE_Y and PLAYER_SYM_Y, full
+// width): the update re-renders them when a value changed, outside a
+// display list; the draw copies them into the frame. The tiled renderer's
+// HUD is its own background, so there both just draw the scoreboard.
+void updateScoreboardCache(int score, int lives, int highScore);
+void drawScoreboardCached(void);
+// Copies 'height' rows into the frame from row y (clipped like drawing)
+void copyRows(const FRAMELINE *rows, int y, int height);
+// Draw a cached span stamp (stamp_cache.h) centered on (cx, cy)
+void drawStamp(int stamp, int cx, int cy, u16 color);
 // Draw a circle perimeter (useful for showing respawn clear radius)
 void drawCircle(int cx, int cy, int radius, u16 color);
+// Same outline, plotting only every 'step'-th step (cheaper, dotted look)
+void drawCircleStep(int cx, int cy, int radius, u16 color, int step);
 
 // Debug visualization of collision circles
 void drawCollisionCircles(GameObject *ship, Asteroid asteroids[], GameObject bullets[]);
@@ -7,11 +7,33 @@
 #include <stdlib.h> // For rand() and srand()
 #include <time.h>   // For time(NULL) seed
 #include <string.h>
+#include "audio_mixer.h"
+#include "backgrounds.h"
+#include "display_list.h"
 #include "graphics.h"
 #include "game_objects.h"
 #include "fixed_trig.h"
+#include "fixed_math_bench.h"
+#include "frame_pipeline.h"
+#include "mem_ops_bench.h"
+#include "mod_player.h"
+#include "oam_manager.h"
+#include "object_pool.h"
+#include "object_sprites.h"
+#include "perf.h"
+#include "quality.h"
 #include "save.h"
 #include "sound.h"
+#include "space_mod.h"
+#include "sprite_tiles.h"
+#include "static_layer.h"
+#include "vector_sprites.h"
+#ifdef AUTOPLAY
+#include "autopilot.h"
+#endif
+#if defined(AUTOPLAY) || defined(FIXED_MATH_BENCH) || defined(MEM_OPS_BENCH)
+#include "debug_log.h"
+#endif
 
 // --- Constants ---
 #define MENU_MODE        0
@@ -26,8 +48,6 @@
 #define DAMAGE_DELAY 15
 #define DEATH_DELAY 35
 int DELAY = 0;
-// Radius (in pixels) around the player spawn center to clear asteroids on respawn
-#define RESPAWN_CLEAR_RADIUS 24
 
 // Rainbow colors for the respawn circle animation
 static const u16 rainbow_colors[] = {
@@ -40,6 +60,61 @@ static const u16 rainbow_colors[] = {
 };
 #define RAINBOW_COLOR_COUNT 6
 
+// Simulation state of the current match (spawn timers, pools, RNG)
+static MatchContext match;
+
+#ifdef AUTOPLAY
+// --- Autoplay soak statistics ---
+// Frame cost and entity counts are sampled every frame; a summary goes to the
+// emulator log every SOAK_REPORT_FRAMES frames, plus a line per new worst frame.
+#define SOAK_REPORT_FRAMES 3600
+
+static Autopilot autopilot;
+static u32 soakFrames = 0;
+static int soakReportCountdown = SOAK_REPORT_FRAMES;
+static u32 soakMatches = 0;
+static u32 soakDeaths = 0;
+static u32 soakLinesTotal = 0;   // Frame cost accumulated over the current report window
+static int soakWorstLines = 0;   // Worst frame since start
+static u32 soakWorstFrame = 0;
+
+static void soakRecordFrame(int score) {
+    int lines = perfLastFrameLines();
+    int rocks = poolLiveCount(&match.asteroidPool);
+    int shots = poolLiveCount(&match.bulletPool);
+    soakFrames++;
+    soakLinesTotal += lines;
+
+    if (lines > soakWorstLines) {
+        soakWorstLines = lines;
+        soakWorstFrame = soakFrames;
+        debugLog(DEBUG_LOG_WARN, "worst frame %lu: %d lines, %d asteroids, %d bullets, Q%d",
+                 (unsigned long)soakFrames, lines, rocks, shots, qualityLevel());
+    }
+
+    if (--soakReportCountdown == 0) {
+        soakReportCountdown = SOAK_REPORT_FRAMES;
+        PoolStats rockStats, shotStats;
+        FrameStats frames;
+        poolGetStats(&match.asteroidPool, &rockStats);
+        poolGetStats(&match.bulletPool, &shotStats);
+        frameGetStats(&frames);
+        debugLog(DEBUG_LOG_INFO,
+                 "frame %lu: avg %lu lines, worst %d (frame %lu), asteroids %d/%d hw %d, "
+                 "bullets %d/%d hw %d, Q%d, score %d, matches %lu, deaths %lu, "
+                 "late %lu, dropped %lu, budget %d lines, asteroid cost %d/256 lines",
+                 (unsigned long)soakFrames, (unsigned long)(soakLinesTotal / SOAK_REPORT_FRAMES),
+                 soakWorstLines, (unsigned long)soakWorstFrame,
+                 rockStats.live, rockStats.capacity, rockStats.highWater,
+                 shotStats.live, shotStats.capacity, shotStats.highWater,
+                 qualityLevel(), score, (unsigned long)soakMatches, (unsigned long)soakDeaths,
+                 (unsigned long)frames.late, (unsigned long)frames.dropped,
+                 perfBudgetLines(), perfLoadCost8());
+        soakLinesTotal = 0;
+    }
+}
+#endif
+
 // Bouncing circles for game-over screen animation
 typedef struct {
     int x, y;        // Position (in pixels)
@@ -49,17 +124,25 @@ typedef struct {
 } BouncingCircle;
 
 #define NUM_BOUNCING_CIRCLES 4
+#if defined(RENDER_PALETTED) && NUM_BOUNCING_CIRCLES > CLR_ANIM_CIRCLE_COUNT
+#error "each bouncing circle needs its own CLR_ANIM_CIRCLES palette entry"
+#endif
 static BouncingCircle bouncing_circles[NUM_BOUNCING_CIRCLES];
 
 // --- Menu floating outlined shapes (color-cycling, no gravity, bounce off walls) ---
 #define NUM_MENU_SHAPES 5
+#if NUM_MENU_SHAPES > VSPR_POLYGON_SLOTS
+#error "each menu shape needs its own polygon sprite slot"
+#endif
 typedef struct {
     int x, y;        // Position (pixels)
     int vx, vy;      // Velocity (pixels/frame)
     int radius;      // Size in pixels
     int sides;       // Number of polygon sides (3-6)
     int colorIdx;    // Fixed color index
-    // Precomputed vertex offsets (relative to center) to avoid per-frame trig
+    int angle;       // Rotation in degrees (applied by the sprite's affine matrix)
+    int spin;        // Degrees per frame
+    // Vertex offsets (relative to center), rasterized once into the shape's sprite
     int vertexX[6];  // max 6 sides
     int vertexY[6];
 } FloatingShape;
@@ -82,14 +165,21 @@ void initMenuShapes() {
         menu_shapes[i].sides = 3 + (i % 4); // 3..6
         // Assign a fixed color index for each shape (unique across shapes)
         menu_shapes[i].colorIdx = i % RAINBOW_COLOR_COUNT;
-        // Precompute vertex offsets for a non-rotating regular polygon
+        // Regular polygon outline, drawn once into the shape's sprite (which
+        // holds outlines up to VSPR_POLYGON_RADIUS)
+        int outlineRadius = menu_shapes[i].radius < VSPR_POLYGON_RADIUS ? menu_shapes[i].radius : VSPR_POLYGON_RADIUS;
         for (int v = 0; v < menu_shapes[i].sides; v++) {
             int deg = (v * 360 / menu_shapes[i].sides) % 360;
             int cos_fp = cos_fp_deg(deg);
             int sin_fp = sin_fp_deg(deg);
-            menu_shapes[i].vertexX[v] = (cos_fp * menu_shapes[i].radius) >> FP_SHIFT;
-            menu_shapes[i].vertexY[v] = (sin_fp * menu_shapes[i].radius) >> FP_SHIFT;
+            menu_shapes[i].vertexX[v] = (cos_fp * outlineRadius) >> FP_SHIFT;
+            menu_shapes[i].vertexY[v] = (sin_fp * outlineRadius) >> FP_SHIFT;
         }
+        loadPolygonSprite(i, menu_shapes[i].vertexX, menu_shapes[i].vertexY,
+                          menu_shapes[i].sides, menu_shapes[i].colorIdx);
+        // Rotation is free on affine sprites: turn slowly, alternating direction
+        menu_shapes[i].angle = 0;
+        menu_shapes[i].spin = (i % 2) ? 1 : -1;
 
         // Spread shapes evenly across the screen horizontally with a small jitter
         int spacingX = SCREEN_WIDTH / (NUM_MENU_SHAPES + 1);
@@ -131,29 +221,15 @@ void updateMenuShapes() {
         if (s->y - s->radius <= 0) { s->y = s->radius; s->vy = -s->vy; }
         if (s->y + s->radius >= bottom) { s->y = bottom - s->radius; s->vy = -s->vy; }
 
-        // No rotation: nothing to update per-frame beyond position
+        s->angle = fxWrapAdd(s->angle, s->spin, 360);
     }
 }
 
-// Draw regular polygon outline for each shape
+// Place each shape's sprite; the outlines were rasterized by initMenuShapes()
 void drawMenuShapes() {
     for (int i = 0; i < NUM_MENU_SHAPES; i++) {
         FloatingShape *s = &menu_shapes[i];
-        int sides = s->sides;
-        int prev_x = 0, prev_y = 0, first_x = 0, first_y = 0;
-        for (int v = 0; v < sides; v++) {
-            int px = s->x + s->vertexX[v];
-            int py = s->y + s->vertexY[v];
-            if (v == 0) {
-                first_x = px; first_y = py;
-            } else {
-                // draw line from prev to current
-                drawLine(prev_x, prev_y, px, py, rainbow_colors[s->colorIdx % RAINBOW_COLOR_COUNT]);
-            }
-            prev_x = px; prev_y = py;
-        }
-        // close polygon
-        drawLine(prev_x, prev_y, first_x, first_y, rainbow_colors[s->colorIdx % RAINBOW_COLOR_COUNT]);
+        showPolygonSprite(i, s->x, s->y, s->angle);
     }
 }
 
@@ -162,6 +238,8 @@ void drawMenuShapes() {
 #define SAVE_NOTIFY_DELAY 15
 // Make GAME OVER notification linger a bit longer for visibility
 #define SAVE_NOTIFY_GO_DELAY 45
+// Text row of the notifications (below the pause and game-over text)
+#define SAVE_NOTIFY_Y (END_TEXT_Y + (4 * LINE_HEIGHT) + 16)
 static int save_notify_counter = 0;
 static int save_notify_ok = 0;
 static int save_notify_gameover = 0; // when set, change text for game-over save
@@ -200,18 +278,18 @@ void maybeDrawSaveNotification(void) {
                 const char *text = "HIGH SCORE SAVED!";
                 int text_width = strlen(text) * CHAR_PIX_SIZE;
                 int centered_x = (SCREEN_WIDTH - text_width) / 2;
-                displayText(text, centered_x, END_TEXT_Y + (4 * LINE_HEIGHT) + 16);
+                displayText(text, centered_x, SAVE_NOTIFY_Y);
             } else if (save_notify_deleted) {
                 const char *text = "DELETED!";
                 int text_width = strlen(text) * CHAR_PIX_SIZE;
                 int centered_x = (SCREEN_WIDTH - text_width) / 2;
-                displayText(text, centered_x, END_TEXT_Y + (4 * LINE_HEIGHT) + 16);
+                displayText(text, centered_x, SAVE_NOTIFY_Y);
             } else {
                 // Center "SAVE SUCCESSFUL" horizontally
                 const char *text = "SAVE SUCCESSFUL";
                 int text_width = strlen(text) * CHAR_PIX_SIZE;
                 int centered_x = (SCREEN_WIDTH - text_width) / 2;
-                displayText(text, centered_x, END_TEXT_Y + (4 * LINE_HEIGHT) + 16);
+                displayText(text, centered_x, SAVE_NOTIFY_Y);
             }
         } else {
             // Check if this is a "no save data" notification (indicated by all flags being 0)
@@ -219,13 +297,13 @@ void maybeDrawSaveNotification(void) {
                 const char *text = "...NO SAVE DATA...";
                 int text_width = strlen(text) * CHAR_PIX_SIZE;
                 int centered_x = (SCREEN_WIDTH - text_width) / 2;
-                displayText(text, centered_x, END_TEXT_Y + (4 * LINE_HEIGHT) + 16);
+                displayText(text, centered_x, SAVE_NOTIFY_Y);
             } else {
                 // Center "SAVE FAILED" horizontally
                 const char *text = "SAVE FAILED";
                 int text_width = strlen(text) * CHAR_PIX_SIZE;
                 int centered_x = (SCREEN_WIDTH - text_width) / 2;
-                displayText(text, centered_x, END_TEXT_Y + (4 * LINE_HEIGHT) + 16);
+                displayText(text, centered_x, SAVE_NOTIFY_Y);
             }
         }
         save_notify_counter--;
@@ -237,15 +315,6 @@ GameObject playerShip;
 Asteroid asteroids[MAX_ASTEROIDS];
 GameObject bullets[MAX_BULLETS];
 
-// --- EXTERNAL GAME LOGIC DECLARATIONS (Defined in game_logic.c) ---
-extern void setupMatch(GameObject *ship, Asteroid asteroids[], GameObject bullets[],int *score, int *lives);
-extern void updatePlayer(GameObject *ship, u16 keys);
-extern void spawnBullet(GameObject bullets[], GameObject *ship);
-extern void updateBullets(GameObject bullets[]);
-extern void updateAsteroids(Asteroid asteroids[]);
-extern void manageAsteroidSpawning(GameObject *ship, Asteroid asteroids[]);
-extern void handleCollisions(GameObject *ship, Asteroid asteroids[], GameObject bullets[], int *lives, int *score);
-
 // --- Function Prototypes ---
 void creditsMode(bool *menuVisible, int *gameMode);
 
@@ -259,7 +328,7 @@ void initBouncingCircles() {
         bouncing_circles[i].vx = 1 + (i % 2) * 2; // 1 or 3 px/frame
         bouncing_circles[i].vy = 0;
         bouncing_circles[i].radius = radii[i];
-        bouncing_circles[i].colorIdx = i; // Stagger color cycles
+        bouncing_circles[i].colorIdx = fxWrap(i, RAINBOW_COLOR_COUNT); // Stagger color cycles
     }
 }
 
@@ -300,8 +369,10 @@ void updateBouncingCircles() {
             c->vx = -c->vx;
         }
         
-        // Cycle color
-        c->colorIdx++;
+#ifndef RENDER_PALETTED
+        // Cycle color (cosmetic; frozen when the quality governor is shedding load)
+        if (qualityEnabled(QFX_RAINBOW_CYCLE)) c->colorIdx = fxWrapInc(c->colorIdx, RAINBOW_COLOR_COUNT);
+#endif
     }
 }
 
@@ -309,7 +380,11 @@ void updateBouncingCircles() {
 void drawBouncingCircles() {
     for (int i = 0; i < NUM_BOUNCING_CIRCLES; i++) {
         BouncingCircle *c = &bouncing_circles[i];
-        u16 color = rainbow_colors[c->colorIdx % RAINBOW_COLOR_COUNT];
+#ifdef RENDER_PALETTED
+        u16 color = CLR_ANIM_CIRCLES + i; // Cycled in the palette
+#else
+        u16 color = rainbow_colors[c->colorIdx];
+#endif
         drawCircle(c->x, c->y, c->radius, color);
     }
 }
@@ -381,29 +456,37 @@ void menuMode(bool *menuVisible, struct MenuScreen *mainMenu, int *gameMode,
         // Reset cursor animation state on first frame entering the menu
         menuCursorNeedsInit = 1;
         // Start background music when entering menu
-        initProceduralMusic();
+        modStop();
+        musicPlay(&SONG_MENU);
     }
 
-    // Clear menu area using optimized direct buffer writes (same as gameplay)
-    for (int y = 0; y < SCREEN_HEIGHT; y++) {
-        for (int x = 0; x < SCREEN_WIDTH; x++) {
-            m3_vram[y][x] = CLR_BLACK;
-        }
+    // The static menu text is drawn once and restored from the layer cache;
+    // the cursor and notifications draw in the rows below the title
+    if (!staticLayerRestore(LAYER_MENU, MENU_ITEM_1, SAVE_NOTIFY_Y + CHAR_PIX_SIZE)) {
+        clearScreen();
+        int titleX = (SCREEN_WIDTH - (strlen("GBA ASTEROIDS") * CHAR_PIX_SIZE)) / 2;
+        int itemX = titleX + (2 * CHAR_PIX_SIZE);
+        displayText("GBA ASTEROIDS", titleX,   MENU_TEXT_Y);
+        displayText(" NEW GAME ", itemX, MENU_ITEM_1);
+        displayText(" CONTINUE ", itemX, MENU_ITEM_2);
+        displayText(" SETTINGS ", itemX, MENU_ITEM_3);
+        displayText(" CREDITS ", itemX, MENU_ITEM_4);
+        staticLayerCapture(LAYER_MENU);
+    }
+    if (qualityEnabled(QFX_MENU_SHAPES)) {
+        updateMenuShapes();
+        drawMenuShapes();
+    } else {
+        hidePolygonSprites();
     }
-    updateMenuShapes();
-    drawMenuShapes();
-
-    // Draw the static menu text (drawn each frame so it appears above shapes)
-    int titleX = (SCREEN_WIDTH - (strlen("GBA ASTEROIDS") * CHAR_PIX_SIZE)) / 2;
-    int itemX = titleX + (2 * CHAR_PIX_SIZE);
-    displayText("GBA ASTEROIDS", titleX,   MENU_TEXT_Y);
-    displayText(" NEW GAME ", itemX, MENU_ITEM_1);
-    displayText(" CONTINUE ", itemX, MENU_ITEM_2);
-    displayText(" SETTINGS ", itemX, MENU_ITEM_3);
-    displayText(" CREDITS ", itemX, MENU_ITEM_4);
     setMenuCursor(mainMenu->selection);
 
     u16 keys_down = keysDown();
+#ifdef AUTOPLAY
+    // Autoplay goes straight back into a new game
+    mainMenu->selection = 0;
+    keys_down = KEY_A;
+#endif
     bool selectionMade    = (keys_down & KEY_START) || (keys_down & KEY_A );
     bool changedSelection = (keys_down & KEY_DOWN)  || (keys_down & KEY_UP);
 
@@ -411,17 +494,24 @@ void menuMode(bool *menuVisible, struct MenuScreen *mainMenu, int *gameMode,
         clearMenu(); // Clear menu text and cursor
         if (mainMenu->selection == 0) {
             // NEW GAME: Stop music first, then setup
-            stopProceduralMusic(); // Stop menu music before starting game
+            musicStop(); // Stop menu music before starting game
+            modPlay(space_mod, space_mod_size); // Match music on the DirectSound mixer
             // Capture the high score at match start to detect increases by game over time
             initialHighScore = getHighScore();
-            setupMatch(ship, asteroids, bullets, score, lives); // Initialize game objects
+            setupMatch(&match, ship, asteroids, bullets, score, lives); // Initialize game objects
+#ifdef AUTOPLAY
+            autopilotInit(&autopilot);
+            soakMatches++;
+#endif
             *gameMode = MATCH_MODE; // Start the game
         }
         else if (mainMenu->selection == 1) { // CONTINUE
             if (hasSavedGame()) {
-                stopProceduralMusic(); // Stop menu music before resuming game
+                musicStop(); // Stop menu music before resuming game
                 if (loadGameState(score, lives, ship, asteroids, bullets)) {
+                    syncObjectPools(&match, asteroids, bullets);
                     initialHighScore = getHighScore();
+                    modPlay(space_mod, space_mod_size);
                     *gameMode = MATCH_MODE; // Resume saved game
                 } else {
                     // Show error notification
@@ -464,23 +554,29 @@ void menuMode(bool *menuVisible, struct MenuScreen *mainMenu, int *gameMode,
  * Handles the credits screen.
  */
 void creditsMode(bool *menuVisible, int *gameMode) {
-    // Clear the screen and redraw the text every frame to ensure it is visible.
-    clearScreen();
+    // Nothing on this screen moves: it is drawn once, and later frames only
+    // restore it from the layer cache (an empty band)
+    if (!staticLayerRestore(LAYER_CREDITS, 0, 0)) {
+        clearScreen();
 
-    // Center the credits title text
-    const char *creditsTitle = "MADE BY TAYLOR BOESE";
-    int creditsTitleX = (SCREEN_WIDTH - (strlen(creditsTitle) * CHAR_PIX_SIZE)) / 2;
-    displayText(creditsTitle, creditsTitleX, END_TEXT_Y - LINE_HEIGHT);
-
-    // Center the MAIN MENU option along with its cursor as a pair
-    const char *menuText = " MAIN MENU ";
-    int menuTextWidth = strlen(menuText) * CHAR_PIX_SIZE;
-    int pairWidth = CHAR_PIX_SIZE + menuTextWidth; // cursor + text
-    int pairLeftX = (SCREEN_WIDTH - pairWidth) / 2;
-    int menuTextX = pairLeftX + CHAR_PIX_SIZE;
-    int menuY = END_TEXT_Y + (2 * LINE_HEIGHT);
-    displayText(menuText, menuTextX, menuY);
-    printChar(selector[0], pairLeftX, menuY);
+#ifndef RENDER_TILED // The tiled renderer shows it in the credits roll (backgrounds.c)
+        // Center the credits title text
+        const char *creditsTitle = "MADE BY TAYLOR BOESE";
+        int creditsTitleX = (SCREEN_WIDTH - (strlen(creditsTitle) * CHAR_PIX_SIZE)) / 2;
+        displayText(creditsTitle, creditsTitleX, END_TEXT_Y - LINE_HEIGHT);
+#endif
+
+        // Center the MAIN MENU option along with its cursor as a pair
+        const char *menuText = " MAIN MENU ";
+        int menuTextWidth = strlen(menuText) * CHAR_PIX_SIZE;
+        int pairWidth = CHAR_PIX_SIZE + menuTextWidth; // cursor + text
+        int pairLeftX = (SCREEN_WIDTH - pairWidth) / 2;
+        int menuTextX = pairLeftX + CHAR_PIX_SIZE;
+        int menuY = END_TEXT_Y + (2 * LINE_HEIGHT);
+        displayText(menuText, menuTextX, menuY);
+        printChar(selector[0], pairLeftX, menuY);
+        staticLayerCapture(LAYER_CREDITS);
+    }
 
     // Always mark as visible since we are in this mode
     *menuVisible = true; 
@@ -515,17 +611,14 @@ void settingsMode(bool *menuVisible, int *gameMode) {
     static int cursorYConfirm = 0;
     static int cursorTargetYConfirm = 0;
     static int animConfirmActive = 0;
-    // Clear screen using optimized direct buffer writes (same as gameplay)
-    for (int y = 0; y < SCREEN_HEIGHT; y++) {
-        for (int x = 0; x < SCREEN_WIDTH; x++) {
-            m3_vram[y][x] = CLR_BLACK;
-        }
-    }
 
     // Title position (centered)
     int titleX = (SCREEN_WIDTH - (strlen("SETTINGS") * CHAR_PIX_SIZE)) / 2;
 
-    displayText("SETTINGS", titleX, MENU_TEXT_Y);
+    // Each view's text is drawn once and restored from the layer cache; the
+    // cursor and notifications draw from the first option row down
+    int cursorTop = MENU_ITEM_2;
+    int cursorBottom = SAVE_NOTIFY_Y + CHAR_PIX_SIZE;
 
     u16 keys_down = keysDown();
 
@@ -537,7 +630,6 @@ void settingsMode(bool *menuVisible, int *gameMode) {
         int delPairWidth = CHAR_PIX_SIZE + delTextWidth; // cursor + text
         int delLeftX = (SCREEN_WIDTH - delPairWidth) / 2;
         int delTextX = delLeftX + CHAR_PIX_SIZE;
-        displayText(delTxt, delTextX, MENU_ITEM_2);
 
         // 2) MAIN MENU
         const char *backTxt = " MAIN MENU ";
@@ -545,7 +637,14 @@ void settingsMode(bool *menuVisible, int *gameMode) {
         int backPairWidth = CHAR_PIX_SIZE + backTextWidth;
         int backLeftX = (SCREEN_WIDTH - backPairWidth) / 2;
         int backTextX = backLeftX + CHAR_PIX_SIZE;
-        displayText(backTxt, backTextX, MENU_ITEM_3);
+
+        if (!staticLayerRestore(LAYER_SETTINGS, cursorTop, cursorBottom)) {
+            clearScreen();
+            displayText("SETTINGS", titleX, MENU_TEXT_Y);
+            displayText(delTxt, delTextX, MENU_ITEM_2);
+            displayText(backTxt, backTextX, MENU_ITEM_3);
+            staticLayerCapture(LAYER_SETTINGS);
+        }
 
         // Initialize cursor positions on first entry
         if (cursorYSettings == 0) {
@@ -608,7 +707,6 @@ void settingsMode(bool *menuVisible, int *gameMode) {
         // Confirmation view
         const char *q = "CONFIRM DELETE?";
         int qx = (SCREEN_WIDTH - (strlen(q) * CHAR_PIX_SIZE)) / 2;
-        displayText(q, qx, MENU_ITEM_1);
 
         // Center YES and NO lines with their cursors as pairs
         const char *yesTxt = " YES ";
@@ -616,14 +714,21 @@ void settingsMode(bool *menuVisible, int *gameMode) {
         int yesPairWidth = CHAR_PIX_SIZE + yesTextWidth; // cursor + text
         int yesLeftX = (SCREEN_WIDTH - yesPairWidth) / 2;
         int yesTextX = yesLeftX + CHAR_PIX_SIZE;
-        displayText(yesTxt, yesTextX, MENU_ITEM_2);
 
         const char *noTxt = " NO ";
         int noTextWidth = strlen(noTxt) * CHAR_PIX_SIZE;
         int noPairWidth = CHAR_PIX_SIZE + noTextWidth;
         int noLeftX = (SCREEN_WIDTH - noPairWidth) / 2;
         int noTextX = noLeftX + CHAR_PIX_SIZE;
-        displayText(noTxt, noTextX, MENU_ITEM_3);
+
+        if (!staticLayerRestore(LAYER_SETTINGS_CONFIRM, cursorTop, cursorBottom)) {
+            clearScreen();
+            displayText("SETTINGS", titleX, MENU_TEXT_Y);
+            displayText(q, qx, MENU_ITEM_1);
+            displayText(yesTxt, yesTextX, MENU_ITEM_2);
+            displayText(noTxt, noTextX, MENU_ITEM_3);
+            staticLayerCapture(LAYER_SETTINGS_CONFIRM);
+        }
 
         // Initialize confirm cursor position (if not set)
         if (cursorYConfirm == 0) {
@@ -682,6 +787,28 @@ void settingsMode(bool *menuVisible, int *gameMode) {
     flipBuffer();
 }
 
+// SELECT toggles an on-screen readout of the quality level and frame cost
+static bool showPerfReadout = false;
+
+/**
+ * Draws the debug readout: quality level, the smoothed frame cost in scanlines,
+ * the number of late frames and the audio mixer's CPU percentage.
+ */
+void drawPerfReadout(void) {
+    char buf[24];
+    FrameStats frames;
+    frameGetStats(&frames);
+    snprintf(buf, sizeof(buf), "Q%d %d L%lu A%d", qualityLevel(), perfAvgFrameLines(),
+             (unsigned long)frames.late, audioMixPercent());
+    int x = SCREEN_WIDTH - (strlen(buf) * CHAR_PIX_SIZE) - 10;
+#ifdef RENDER_TILED
+    hudText(HUD_PERF, x, PLAYER_SYM_Y, buf, CLR_CYAN);
+#else
+    clearRegion(x, PLAYER_SYM_Y, strlen(buf) * CHAR_PIX_SIZE, CHAR_PIX_SIZE);
+    displayTextColor(buf, x, PLAYER_SYM_Y, CLR_CYAN);
+#endif
+}
+
 /**
  * Handles the main game logic loop (Match Mode).
  */
@@ -693,49 +820,26 @@ void matchMode(GameObject *ship, Asteroid asteroids[], GameObject bullets[],
 
     for (int i = 0; i < SPEED_MULTIPLIER; i++) {
 
+#ifdef AUTOPLAY
+        u16 keys_down;
+        u16 keys_held = autopilotKeys(&autopilot, &match, ship, asteroids, &keys_down);
+#else
         u16 keys_held = keysHeld();
         u16 keys_down = keysDown();
-        
-        // 1. INPUT & LOGIC UPDATES
-        updatePlayer(ship, keys_held);
-
-        if (keys_down & KEY_A) {
-            spawnBullet(bullets, ship);
-        }
+#endif
 
         if (keys_down & KEY_START) {
             *gameMode = PAUSE_MODE;
+            frameRetain(); // The pause menu is drawn over the last game frame
             return; // Exit multiplier loop if paused
         }
 
-        // 2. APPLY MOVEMENT (Ship wrapping is handled here for screen boundaries)
-        ship->prevX = FP_TO_INT(ship->x);
-        ship->prevY = FP_TO_INT(ship->y);
-
-        // Apply Player Movement
-        ship->x += ship->velocityX;
-        ship->y += ship->velocityY;
-
-        // Wrap Player around screen
-        int x = FP_TO_INT(ship->x);
-        int y = FP_TO_INT(ship->y);
-
-        if (x < -ship->width) ship->x = INT_TO_FP(SCREEN_WIDTH);
-        else if (x > SCREEN_WIDTH) ship->x = INT_TO_FP(-ship->width);
-
-        if (y < -ship->height) ship->y = INT_TO_FP(SCREEN_HEIGHT);
-        else if (y > SCREEN_HEIGHT) ship->y = INT_TO_FP(-ship->height);
-
-        // Update Bullets and Asteroids
-        updateBullets(bullets);
-        updateAsteroids(asteroids);
-
-        // This call must be added to spawn new asteroids over time.
-        // Use the current match's ship pointer (passed into matchMode) instead of the global playerShip.
-        manageAsteroidSpawning(ship, asteroids);
+        if (keys_down & KEY_SELECT) {
+            showPerfReadout = !showPerfReadout;
+        }
 
-        // 3. COLLISION DETECTION
-        handleCollisions(ship, asteroids, bullets, lives, score);
+        // 1-3. INPUT, MOVEMENT, SPAWNING AND COLLISIONS
+        stepMatch(&match, ship, asteroids, bullets, score, lives, keys_held, keys_down);
 
         // Update runtime high score immediately when beaten so the
         // in-game scoreboard shows the current session best.
@@ -745,42 +849,72 @@ void matchMode(GameObject *ship, Asteroid asteroids[], GameObject bullets[],
 
         // 4. DEATH/GAME OVER CHECK
         if (ship->isAlive == 0) { 
+#ifdef AUTOPLAY
+            soakDeaths++;
+#endif
             *gameMode = RESET_MODE; // Transition to death delay/reset screen
             return; // Exit multiplier loop if ship is dead
         }
     } // End of SPEED_MULTIPLIER loop
 
+#ifdef HEADLESS
+    // Headless soak runs measure simulation cost only
+    return;
+#endif
+
     // 5. DRAWING
-    // Clear the entire gameplay screen each frame (full height to catch objects at edges)
-    // but use optimized row-by-row u32 writes instead of clearScreen()'s per-pixel approach
-    for (int y = 0; y < SCREEN_HEIGHT; y++) {
-        for (int x = 0; x < SCREEN_WIDTH; x++) {
-            m3_vram[y][x] = CLR_BLACK;
-        }
+    // At the lowest quality level the scoreboard text is only re-rendered
+    // every other frame, into a cache of its two bands; every frame copies
+    // the bands in, so whatever crossed them last time is gone
+    static bool hudRefresh = false;
+    static bool hudCacheLive = false; // The cache has been rendered since the level dropped
+    bool hudEveryFrame = qualityEnabled(QFX_HUD_EVERY_FRAME);
+    hudRefresh = !hudRefresh;
+    if (hudEveryFrame) {
+        hudCacheLive = false;
+    } else if (hudRefresh || !hudCacheLive) {
+        updateScoreboardCache(*score, *lives, getHighScore());
+        hudCacheLive = true;
     }
 
-    drawScoreboard(*score, *lives, getHighScore()); // Use the correct drawScoreboard function
+    // Draw calls are binned and rasterized band by band in IWRAM at the end
+    // (display_list.h)
+    displayListBegin();
+    // Clear the entire gameplay screen each frame (full height to catch objects at edges)
+    clearScreen();
+    if (hudEveryFrame) {
+        drawScoreboard(*score, *lives, getHighScore());
+    } else {
+        drawScoreboardCached();
+    }
 
     if (ship->isAlive) {
         drawPlayerShip(ship);
+    } else {
+        hideShipSprite();
     }
 
-    // Draw all active asteroids
-    for (int i = 0; i < MAX_ASTEROIDS; i++) {
-        if (asteroids[i].obj.isAlive) {
-            drawAsteroid(&asteroids[i]);
-        }
+    // Draw all active asteroids (sprites in the tiled renderer, object_sprites.h)
+    objectSpritesBegin();
+    POOL_FOR_EACH(&match.asteroidPool, i) {
+        drawAsteroid(&asteroids[i]);
     }
 
     // Draw all active bullets
-    for (int i = 0; i < MAX_BULLETS; i++) {
-        if (bullets[i].isAlive) {
-            drawBullet(&bullets[i]);
-        }
+    POOL_FOR_EACH(&match.bulletPool, i) {
+        drawBullet(&bullets[i]);
     }
+    objectSpritesEnd();
     
     // Draw collision circles for debugging
     //drawCollisionCircles(ship, asteroids, bullets);
+
+    if (showPerfReadout) {
+        drawPerfReadout();
+    } else {
+        hudText(HUD_PERF, 0, PLAYER_SYM_Y, "", CLR_CYAN); // HUD background only
+    }
+    displayListEnd();
     
     // Copy the final frame from the back buffer to the visible VRAM
     flipBuffer();
@@ -794,11 +928,12 @@ int main(void) {
 
     // Interrupt handlers setup
     irqInit();
-    irqEnable(IRQ_VBLANK);
+    framePipelineInit(); // VBlank handler: presents frames, counts refreshes, ticks effects, mixes audio
 
     // Initialize sound system for sound effects
     REG_SOUNDCNT_X = 0x80; // Enable sound
     REG_SOUNDCNT_L = 0x7777; // Enable all channels left/right, full volume
+    audioInit(); // DirectSound mixer: streams from the next VBlank
 
     // --- Game Variables ---
     GameObject ship;
@@ -814,25 +949,71 @@ int main(void) {
     bool menuVisible = false;
     int gameMode = MENU_MODE;
     int resetCounter = 0;
+    int layerMode = -1; // Screen the static layer cache was built for
+#ifdef RENDER_PALETTED
+    int resetStillFrames = 0; // DANGER frames drawn with nothing transient on them
+#else
     int colorCycleIndex = 0; // For animating the respawn circle color
+#endif
     
     // --- Pause Menu Variables ---
     int pauseMenuSelection = 0; // 0 = SAVE, 1 = RESUME
 
-    // Seed the random number generator
+    // Seed the random number generators (libc rand() drives the menu effects)
     srand(time(NULL));
-
-    // Set GBA display to Mode 3 (240x160, 16-bit color, BG2 active)
-    SetMode( MODE_3 | BG2_ON );
+    matchContextInit(&match, (u32)time(NULL));
+
+    // Set the GBA display mode (Mode 3, or paletted Mode 4 / Mode 0 tiles with
+    // RENDERER=mode4 / RENDERER=tiled)
+    initGraphics();
+    // Sprites: the ship and menu shapes are hardware-rotated outlines
+    initOAM();
+    vectorSpritesInit();
+    spriteTilesInit(); // Asteroid and bullet sprite imagery
+    objectSpritesInit(); // Asteroid and bullet sprites (tiled renderer)
+
+#ifdef AUTOPLAY
+    debugLogInit();
+    debugLog(DEBUG_LOG_INFO, "autoplay soak started");
+#endif
+
+#ifdef FIXED_MATH_BENCH
+    debugLogInit();
+    fixedMathBenchRun();
+#endif
+
+#ifdef MEM_OPS_BENCH
+    debugLogInit();
+    memOpsBenchRun();
+#endif
 
     // Main Game Loop
     while (1) {
-        VBlankIntrWait(); // Synchronize screen updates
+#ifndef HEADLESS
+        frameWaitTick(); // One simulation step per refresh; no wait after an overrun
+#endif
+        perfFrameStart();
         scanKeys();
+
+        // Sprites stay up until hidden: drop those of the screens not shown
+        // (the ship stays visible under the pause menu)
+        if (gameMode != MATCH_MODE && gameMode != PAUSE_MODE) {
+            hideShipSprite();
+            objectSpritesHide();
+        }
+        if (gameMode != MENU_MODE) hidePolygonSprites();
+        // Scrolling scenery and HUD of the tiled renderer (no-op otherwise)
+        if (gameMode == CREDITS_MODE) backgroundsShow(BGL_CREDITS);
+        else if (gameMode == MATCH_MODE || gameMode == PAUSE_MODE) backgroundsShow(BGL_STARFIELD | BGL_HUD);
+        else if (gameMode == RESET_MODE) backgroundsShow(BGL_STARFIELD);
+        else backgroundsShow(0);
+        // A new screen rebuilds its cached static layer
+        if (gameMode != layerMode) {
+            staticLayerInvalidate();
+            layerMode = gameMode;
+        }
         
         if (gameMode == MENU_MODE) {
-            // Update background music only in menu mode
-            updateProceduralMusic();
             menuMode(&menuVisible, &mainMenu, &gameMode, &ship, asteroids, bullets, &score, &lives);
 
         } else if (gameMode == MATCH_MODE) {
@@ -847,53 +1028,65 @@ int main(void) {
         } else if (gameMode == RESET_MODE) {
             // Death Delay / Game Over Screen
             resetCounter++;
-            // Clear screen using optimized direct buffer writes (same as gameplay)
-            for (int y = 0; y < SCREEN_HEIGHT; y++) {
-                for (int x = 0; x < SCREEN_WIDTH; x++) {
-                    m3_vram[y][x] = CLR_BLACK;
-                }
-            }
-            
-            // Display "DANGER!" if lives remain, or "GAME OVER!" if not.
-            if (lives > 0) {
-                // Draw respawn-clear radius circle with animated rainbow color FIRST (behind text)
-                int spawnCenterX = SCREEN_WIDTH / 2;
-                int spawnCenterY = SCREEN_HEIGHT / 2;
-                u16 circleColor = rainbow_colors[colorCycleIndex % RAINBOW_COLOR_COUNT];
-                drawCircle(spawnCenterX, spawnCenterY, RESPAWN_CLEAR_RADIUS, circleColor);
-                colorCycleIndex++; // Advance color for next frame
-
-                // Center the DANGER! warning horizontally
-                const char *dangerText = "DANGER!";
-                int dangerWidth = strlen(dangerText) * CHAR_PIX_SIZE;
-                int dangerX = (SCREEN_WIDTH - dangerWidth) / 2;
-                displayText(dangerText, dangerX, END_TEXT_Y);
-
-                // Display remaining lives (keep at original scoreboard area for clarity)
-                char livesBuf[16];
-                snprintf(livesBuf, sizeof(livesBuf), "LIVES LEFT: %d", lives);
-                displayText(livesBuf, END_TEXT_X, NUM_LIVES_Y);
-
-                DELAY = DAMAGE_DELAY;
-            } else {
-                displayText(" GAME OVER! ", END_TEXT_X, END_TEXT_Y);
-                // Initialize bouncing circles and conditionally save on first frame of game-over
-                if (resetCounter == 1) {
-                    initBouncingCircles();
-                    // Only persist and notify if high score increased during this match
-                    if (getHighScore() > initialHighScore) {
-                        saveHighScore();
-                        setSaveNotificationGameOver(wasLastSaveOK());
+            bool redrawReset = true;
+#ifdef RENDER_PALETTED
+            // The ring's color cycles in the palette, so once both pages hold
+            // the same DANGER screen it is left alone until the respawn
+            if (resetCounter == 1) resetStillFrames = 0;
+            redrawReset = lives == 0 || resetStillFrames < FRAME_BACK_BUFFERS;
+#endif
+            if (redrawReset) {
+                // Clear screen
+                clearScreen();
+
+                // Display "DANGER!" if lives remain, or "GAME OVER!" if not.
+                if (lives > 0) {
+                    // Draw respawn-clear radius circle with animated rainbow color FIRST (behind text)
+                    int spawnCenterX = SCREEN_WIDTH / 2;
+                    int spawnCenterY = SCREEN_HEIGHT / 2;
+#ifdef RENDER_PALETTED
+                    u16 circleColor = CLR_ANIM_RING; // Cycled in the palette
+#else
+                    u16 circleColor = rainbow_colors[colorCycleIndex];
+                    if (qualityEnabled(QFX_RAINBOW_CYCLE)) colorCycleIndex = fxWrapInc(colorCycleIndex, RAINBOW_COLOR_COUNT); // Advance color for next frame
+#endif
+                    drawCircle(spawnCenterX, spawnCenterY, RESPAWN_CLEAR_RADIUS, circleColor);
+
+                    // Center the DANGER! warning horizontally
+                    const char *dangerText = "DANGER!";
+                    int dangerWidth = strlen(dangerText) * CHAR_PIX_SIZE;
+                    int dangerX = (SCREEN_WIDTH - dangerWidth) / 2;
+                    displayText(dangerText, dangerX, END_TEXT_Y);
+
+                    // Display remaining lives (keep at original scoreboard area for clarity)
+                    char livesBuf[16];
+                    snprintf(livesBuf, sizeof(livesBuf), "LIVES LEFT: %d", lives);
+                    displayText(livesBuf, END_TEXT_X, NUM_LIVES_Y);
+
+                    DELAY = DAMAGE_DELAY;
+                } else {
+                    displayText(" GAME OVER! ", END_TEXT_X, END_TEXT_Y);
+                    // Initialize bouncing circles and conditionally save on first frame of game-over
+                    if (resetCounter == 1) {
+                        initBouncingCircles();
+                        // Only persist and notify if high score increased during this match
+                        if (getHighScore() > initialHighScore) {
+                            saveHighScore();
+                            setSaveNotificationGameOver(wasLastSaveOK());
+                        }
                     }
+                    // Update and draw bouncing circles
+                    updateBouncingCircles();
+                    drawBouncingCircles();
+                    DELAY = DEATH_DELAY;
                 }
-                // Update and draw bouncing circles
-                updateBouncingCircles();
-                drawBouncingCircles();
-                DELAY = DEATH_DELAY;
-            }
 
-            // Draw any transient save notification (so it shows during GAME OVER)
-            maybeDrawSaveNotification();
+                // Draw any transient save notification (so it shows during GAME OVER)
+#ifdef RENDER_PALETTED
+                resetStillFrames = save_notify_counter > 0 ? 0 : resetStillFrames + 1;
+#endif
+                maybeDrawSaveNotification();
+            }
             // Copy the final frame from the back buffer to the visible VRAM
             flipBuffer();
 
@@ -903,39 +1096,20 @@ int main(void) {
 
                 // Re-spawn logic
                 if (lives > 0) {
-                        // Clear nearby asteroids around the default spawn center
-                        int spawnCenterX = SCREEN_WIDTH / 2;
-                        int spawnCenterY = SCREEN_HEIGHT / 2;
-                        int r2 = RESPAWN_CLEAR_RADIUS * RESPAWN_CLEAR_RADIUS;
-                        
-                        for (int a = 0; a < MAX_ASTEROIDS; a++) {
-                            if (asteroids[a].obj.isAlive) {
-                                int ax = FP_TO_INT(asteroids[a].obj.x) + (asteroids[a].obj.width / 2);
-                                int ay = FP_TO_INT(asteroids[a].obj.y) + (asteroids[a].obj.height / 2);
-                                int dx = ax - spawnCenterX;
-                                int dy = ay - spawnCenterY;
-                                if (dx*dx + dy*dy <= r2) {
-                                    asteroids[a].obj.isAlive = 0; // destroy asteroid near spawn
-                                }
-                            }
-                        }
-                        // SHIP REAPPEARS: Set isAlive and return to match
-                        ship.isAlive = 1;
+                        // Clear nearby asteroids around the spawn center; the ship reappears
+                        respawnShip(&match, &ship, asteroids);
                         gameMode = MATCH_MODE;
                 } else {
                     // FINAL GAME OVER: Reset and go to menu
                         menuVisible = false;
                         // High score already persisted when Game Over screen started
-                        setupMatch(&ship, asteroids, bullets, &score, &lives);
+                        setupMatch(&match, &ship, asteroids, bullets, &score, &lives);
                         gameMode = MENU_MODE;
                 }
             }
           } else if (gameMode == PAUSE_MODE) {
                  u16 keys_down = keysDown();
                  
-                 // Clear the pause menu area each frame to avoid cursor duplication
-                 clearRegion(END_TEXT_X - CHAR_PIX_SIZE - 8, END_TEXT_Y, 14 * CHAR_PIX_SIZE, 5 * LINE_HEIGHT);
-                 
                  // Handle selection navigation (UP/DOWN to move cursor, START or A to select)
                  if (keys_down & KEY_DOWN) {
                      pauseMenuSelection = (pauseMenuSelection + 1) % 3;
@@ -943,17 +1117,22 @@ int main(void) {
                      pauseMenuSelection = (pauseMenuSelection + 2) % 3; // -1 mod 3
                  }
                  
-                 // Draw PAUSE text
-                 displayText("  PAUSED!   ", END_TEXT_X, END_TEXT_Y);
-
-                 // Draw menu options with cursor
+                 // Menu options
                  int option1Y = END_TEXT_Y + (2 * LINE_HEIGHT);
                  int option2Y = option1Y + LINE_HEIGHT;
                  int option3Y = option2Y + LINE_HEIGHT;
-                 
-                 displayText(" RESUME ", END_TEXT_X, option1Y);
-                 displayText(" SAVE GAME ", END_TEXT_X, option2Y);
-                 displayText(" QUIT ", END_TEXT_X, option3Y);
+
+                 // The menu over the retained game frame is drawn once and
+                 // restored from the layer cache; the cursor and notifications
+                 // draw in the option rows and below
+                 if (!staticLayerRestore(LAYER_PAUSE, option1Y, SAVE_NOTIFY_Y + CHAR_PIX_SIZE)) {
+                     clearRegion(END_TEXT_X - CHAR_PIX_SIZE - 8, END_TEXT_Y, 14 * CHAR_PIX_SIZE, 5 * LINE_HEIGHT);
+                     displayText("  PAUSED!   ", END_TEXT_X, END_TEXT_Y);
+                     displayText(" RESUME ", END_TEXT_X, option1Y);
+                     displayText(" SAVE GAME ", END_TEXT_X, option2Y);
+                     displayText(" QUIT ", END_TEXT_X, option3Y);
+                     staticLayerCapture(LAYER_PAUSE);
+                 }
                  
                  // Draw cursor at selected option
                  if (pauseMenuSelection == 0) {
@@ -997,6 +1176,15 @@ int main(void) {
                  maybeDrawSaveNotification();
                  flipBuffer();
           }
-        
+
+        // Frame cost feeds the asteroid spawn scheduler's budget check (with
+        // the per-asteroid cost fitted over match frames) and the quality
+        // governor
+        perfFrameEnd();
+        if (gameMode == MATCH_MODE) perfSampleLoad(poolLiveCount(&match.asteroidPool));
+        qualityUpdate(perfLastFrameLines());
+#ifdef AUTOPLAY
+        soakRecordFrame(score);
+#endif
     } // End of while(1)
 } // End of main(void)
\ No newline at end of file
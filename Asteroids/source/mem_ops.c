@@ -0,0 +1,81 @@
+#include <gba_dma.h>
+#include <gba_interrupt.h>
+#include <gba_systemcalls.h>
+#include "mem_ops.h"
+
+// Below this many words the call into IWRAM or the BIOS costs more than
+// the loop it saves
+#define SMALL_WORDS 16
+
+void memFill32(void *dst, u32 value, u32 bytes) {
+    u32 words = bytes >> 2;
+    if (words < SMALL_WORDS) {
+        vu32 *d = dst;
+        while (words--) *d++ = value;
+    } else if ((words & 7) == 0) {
+        CpuFastSet(&value, dst, FILL | COPY32 | words);
+    } else {
+        memFillWordsArm(dst, value, words);
+    }
+}
+
+void memCopy32(void *dst, const void *src, u32 bytes) {
+    u32 words = bytes >> 2;
+    if (words < SMALL_WORDS) {
+        vu32 *d = dst;
+        const u32 *s = src;
+        while (words--) *d++ = *s++;
+    } else if ((words & 7) == 0) {
+        CpuFastSet(src, dst, COPY32 | words);
+    } else {
+        memCopyWordsArm(dst, src, words);
+    }
+}
+
+// A halfword at each misaligned end, words in between
+void memFill16(void *dst, u16 value, u32 bytes) {
+    vu16 *d = dst;
+    if (bytes && ((u32)d & 2)) {
+        *d++ = value;
+        bytes -= 2;
+    }
+    memFill32((void *)d, value | ((u32)value << 16), bytes & ~3u);
+    if (bytes & 2) d[(bytes >> 1) - 1] = value;
+}
+
+void memCopy16(void *dst, const void *src, u32 bytes) {
+    vu16 *d = dst;
+    const u16 *s = src;
+    // Words only line up when both start at the same offset in one
+    if (((u32)d ^ (u32)s) & 2) {
+        for (u32 i = 0; i < bytes >> 1; i++) d[i] = s[i];
+        return;
+    }
+    if (bytes && ((u32)d & 2)) {
+        *d++ = *s++;
+        bytes -= 2;
+    }
+    memCopy32((void *)d, s, bytes & ~3u);
+    if (bytes & 2) d[(bytes >> 1) - 1] = s[(bytes >> 1) - 1];
+}
+
+// DMA3 is shared with the VBlank handler; keep it from reprogramming the
+// channel between the register writes
+static inline void dma3Words(const void *src, void *dst, u32 words, u32 mode) {
+    u16 ime = REG_IME;
+    REG_IME = 0;
+    REG_DMA3SAD = (u32)src;
+    REG_DMA3DAD = (u32)dst;
+    REG_DMA3CNT = DMA_ENABLE | DMA_IMMEDIATE | DMA32 | mode | words;
+    REG_IME = ime;
+}
+
+void memDmaFill32(void *dst, u32 value, u32 bytes) {
+    // The CPU is halted until the transfer ends, so the source can live on
+    // the stack
+    if (bytes) dma3Words(&value, dst, bytes >> 2, DMA_SRC_FIXED);
+}
+
+void memDmaCopy32(void *dst, const void *src, u32 bytes) {
+    if (bytes) dma3Words(src, dst, bytes >> 2, DMA_SRC_INC);
+}
@@ -0,0 +1,33 @@
+#ifndef MEM_OPS_H
+#define MEM_OPS_H
+
+#include <gba_base.h>
+#include <gba_types.h>
+
+// --- Memory Fill and Copy ---
+// Sizes are in bytes. memFill32() and memCopy32() pick a backend by size:
+// a plain word loop for a few words, the BIOS CpuFastSet for multiples of
+// 8 words, and an ARM ldm/stm loop in IWRAM (mem_ops.iwram.c) for the
+// rest. All three can be interrupted. The DMA3 versions are no faster
+// on the GBA's buses, but hold the CPU and every interrupt off until done:
+// use them from the VBlank handler, or where that latency is wanted.
+// The 16-bit versions take halfword alignment and never write single
+// bytes, so they are safe for VRAM.
+
+// dst (and src) word aligned, bytes a multiple of 4
+void memFill32(void *dst, u32 value, u32 bytes);
+void memCopy32(void *dst, const void *src, u32 bytes);
+
+// dst (and src) halfword aligned, bytes a multiple of 2
+void memFill16(void *dst, u16 value, u32 bytes);
+void memCopy16(void *dst, const void *src, u32 bytes);
+
+// DMA3, word aligned; safe to call with interrupts on or off
+void memDmaFill32(void *dst, u32 value, u32 bytes);
+void memDmaCopy32(void *dst, const void *src, u32 bytes);
+
+// The IWRAM backend on its own (mem_ops_bench.c times each backend)
+IWRAM_CODE void memFillWordsArm(u32 *dst, u32 value, u32 words);
+IWRAM_CODE void memCopyWordsArm(u32 *dst, const u32 *src, u32 words);
+
+#endif // MEM_OPS_H
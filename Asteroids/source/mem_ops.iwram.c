@@ -0,0 +1,43 @@
+#include "mem_ops.h"
+
+// Built as ARM code (the .iwram.c rule): eight registers per ldm/stm, and
+// the loop runs from IWRAM's 32-bit bus. The tail words go one at a time.
+
+IWRAM_CODE void memFillWordsArm(u32 *dst, u32 value, u32 words) {
+    u32 blocks = words >> 3;
+    if (blocks) {
+        __asm__ volatile (
+            "mov    r3, %[v]\n\t"
+            "mov    r4, %[v]\n\t"
+            "mov    r5, %[v]\n\t"
+            "mov    r6, %[v]\n\t"
+            "mov    r7, %[v]\n\t"
+            "mov    r8, %[v]\n\t"
+            "mov    r9, %[v]\n\t"
+            "mov    r10, %[v]\n"
+            "1:\n\t"
+            "stmia  %[d]!, {r3-r10}\n\t"
+            "subs   %[n], %[n], #1\n\t"
+            "bne    1b"
+            : [d] "+r" (dst), [n] "+r" (blocks)
+            : [v] "r" (value)
+            : "r3", "r4", "r5", "r6", "r7", "r8", "r9", "r10", "cc", "memory");
+    }
+    for (words &= 7; words; words--) *dst++ = value;
+}
+
+IWRAM_CODE void memCopyWordsArm(u32 *dst, const u32 *src, u32 words) {
+    u32 blocks = words >> 3;
+    if (blocks) {
+        __asm__ volatile (
+            "1:\n\t"
+            "ldmia  %[s]!, {r3-r10}\n\t"
+            "stmia  %[d]!, {r3-r10}\n\t"
+            "subs   %[n], %[n], #1\n\t"
+            "bne    1b"
+            : [d] "+r" (dst), [s] "+r" (src), [n] "+r" (blocks)
+            :
+            : "r3", "r4", "r5", "r6", "r7", "r8", "r9", "r10", "cc", "memory");
+    }
+    for (words &= 7; words; words--) *dst++ = *src++;
+}
@@ -0,0 +1,124 @@
+#include "mem_ops_bench.h"
+
+#ifdef MEM_OPS_BENCH
+
+#include <gba_input.h>
+#include <gba_systemcalls.h>
+#include <gba_timers.h>
+#include <stdio.h>
+#include "debug_log.h"
+#include "graphics.h"
+#include "mem_ops.h"
+
+// A few OAM entries or two tiles, and the tiled renderer's whole frame
+#define SMALL_BYTES     64
+#define LARGE_BYTES     19200
+#define SMALL_REPEATS   64  // Small blocks are timed over this many calls
+#define FILL_VALUE      0x5A5AA5A5u
+
+enum { OP_FILL, OP_COPY };
+enum { BACKEND_LOOP, BACKEND_ARM, BACKEND_BIOS, BACKEND_DMA, BACKEND_COUNT };
+
+static const char *const BACKEND_NAMES[BACKEND_COUNT] = { "LOOP", "ARM", "BIOS", "DMA" };
+
+// Source data lives in EWRAM like the frame buffers and layers it stands for
+static EWRAM_BSS u32 benchSrc[LARGE_BYTES / 4];
+
+static void timerStart(void) {
+    REG_TM2CNT_H = 0;
+    REG_TM3CNT_H = 0;
+    REG_TM2CNT_L = 0;
+    REG_TM3CNT_L = 0;
+    REG_TM3CNT_H = TIMER_COUNT | TIMER_START; // Counts timer 2 overflows
+    REG_TM2CNT_H = TIMER_START;               // 1 tick per CPU cycle
+}
+
+static u32 timerStop(void) {
+    REG_TM2CNT_H = 0;
+    REG_TM3CNT_H = 0;
+    return REG_TM2CNT_L | ((u32)REG_TM3CNT_L << 16);
+}
+
+static void runCase(int op, int backend, u32 *dst, u32 bytes) {
+    u32 words = bytes / 4;
+    switch (backend) {
+    case BACKEND_LOOP: {
+        vu32 *d = dst;
+        if (op == OP_FILL) for (u32 i = 0; i < words; i++) d[i] = FILL_VALUE;
+        else               for (u32 i = 0; i < words; i++) d[i] = benchSrc[i];
+        break;
+    }
+    case BACKEND_ARM:
+        if (op == OP_FILL) memFillWordsArm(dst, FILL_VALUE, words);
+        else               memCopyWordsArm(dst, benchSrc, words);
+        break;
+    case BACKEND_BIOS: {
+        static const u32 fill = FILL_VALUE;
+        if (op == OP_FILL) CpuFastSet(&fill, dst, FILL | COPY32 | words);
+        else               CpuFastSet(benchSrc, dst, COPY32 | words);
+        break;
+    }
+    case BACKEND_DMA:
+        if (op == OP_FILL) memDmaFill32(dst, FILL_VALUE, bytes);
+        else               memDmaCopy32(dst, benchSrc, bytes);
+        break;
+    }
+}
+
+static bool checkCase(int op, const u32 *dst, u32 bytes) {
+    const vu32 *d = dst;
+    for (u32 i = 0; i < bytes / 4; i++) {
+        if (d[i] != ((op == OP_FILL) ? FILL_VALUE : benchSrc[i])) return false;
+    }
+    return true;
+}
+
+void memOpsBenchRun(void) {
+    u32 seed = 0x2545F491;
+    for (int i = 0; i < LARGE_BYTES / 4; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        benchSrc[i] = seed;
+    }
+
+    static const u32 sizes[2] = { SMALL_BYTES, LARGE_BYTES };
+    char lines[2 * 2 * BACKEND_COUNT][32];
+    int count = 0;
+    u32 *dst = (u32 *)back_buffer;
+
+    for (int op = OP_FILL; op <= OP_COPY; op++) {
+        for (int s = 0; s < 2; s++) {
+            u32 bytes = sizes[s];
+            int repeats = (bytes == SMALL_BYTES) ? SMALL_REPEATS : 1;
+            for (int b = 0; b < BACKEND_COUNT; b++) {
+                clearScreen();
+                timerStart();
+                for (int r = 0; r < repeats; r++) runCase(op, b, dst, bytes);
+                u32 t = timerStop();
+                bool ok = checkCase(op, dst, bytes);
+
+                // Cycles per word, in hundredths
+                u32 hundredths = (t * 100) / (repeats * (bytes / 4));
+                snprintf(lines[count], sizeof(lines[count]), "%s %-4s %5lu %2lu.%02lu %s",
+                         op == OP_FILL ? "FILL" : "COPY", BACKEND_NAMES[b], (unsigned long)bytes,
+                         (unsigned long)(hundredths / 100), (unsigned long)(hundredths % 100),
+                         ok ? "OK" : "BAD");
+                debugLog(ok ? DEBUG_LOG_INFO : DEBUG_LOG_ERROR, "membench: %s", lines[count]);
+                count++;
+            }
+        }
+    }
+
+    clearScreen();
+    displayText("MEM OPS CYC/WORD START: GO", 8, 2);
+    for (int i = 0; i < count; i++) {
+        displayText(lines[i], 8, 12 + i * 9);
+    }
+    flipBuffer();
+
+    do {
+        VBlankIntrWait();
+        scanKeys();
+    } while (!(keysDown() & KEY_START));
+}
+
+#endif // MEM_OPS_BENCH
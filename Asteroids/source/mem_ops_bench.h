@@ -0,0 +1,15 @@
+#ifndef MEM_OPS_BENCH_H
+#define MEM_OPS_BENCH_H
+
+// --- mem_ops Throughput Benchmark (make MEMBENCH=1) ---
+// Times each fill and copy backend (word loop, IWRAM ldm/stm, BIOS
+// CpuFastSet, DMA3) on a small and a frame-sized block into the renderer's
+// back buffer with timers 2+3 cascaded, checks the result, and reports
+// cycles per word on screen and to the mGBA debug log.
+
+#ifdef MEM_OPS_BENCH
+// Runs once at boot and waits for START
+void memOpsBenchRun(void);
+#endif
+
+#endif // MEM_OPS_BENCH_H
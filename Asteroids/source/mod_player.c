@@ -0,0 +1,278 @@
+#include <gba_interrupt.h>
+#include <stddef.h>
+#include "audio_mixer.h"
+#include "mod_player.h"
+
+#define MOD_CHANNELS        4
+#define MOD_SAMPLES         31
+#define MOD_ROWS            64
+#define MOD_ORDERS          128
+#define CELL_BYTES          4
+#define PATTERN_BYTES       (MOD_ROWS * MOD_CHANNELS * CELL_BYTES)
+
+// Header layout
+#define SAMPLE_HEADERS      20
+#define SAMPLE_HEADER_BYTES 30
+#define SONG_LENGTH         950
+#define SONG_RESTART        951
+#define SONG_ORDERS         952
+#define MODULE_TAG          1080
+#define HEADER_BYTES        1084
+
+#define PERIOD_MIN          113
+#define PERIOD_MAX          856
+#define DEFAULT_SPEED       6
+#define DEFAULT_TEMPO       125
+
+// Amiga PAL Paula clock over the mix rate: the step of period 1
+#define PERIOD_STEP         (u32)(((u64)3546895 << AUDIO_FRAC_BITS) / AUDIO_RATE)
+// AUDIO_RATE * 2.5 s in 8.8: a tick lasts this / tempo output samples
+#define TICK_SAMPLES_BPM    8562534
+
+// 2^(finetune/96) in 0.16, for finetunes 0-7 then -8 to -1
+static const u32 FINETUNE[16] = {
+    65536, 66011, 66489, 66971, 67456, 67945, 68438, 68933,
+    61858, 62306, 62757, 63212, 63670, 64132, 64596, 65065,
+};
+
+// Amiga panning: channels 0 and 3 left, 1 and 2 right
+static const u8 CHANNEL_PAN[MOD_CHANNELS] = {
+    AUDIO_PAN_LEFT, AUDIO_PAN_RIGHT, AUDIO_PAN_RIGHT, AUDIO_PAN_LEFT
+};
+
+typedef struct {
+    const s8 *data;
+    u32 length;         // Bytes, as are the loop bounds
+    u32 loopStart;
+    u32 loopLength;     // 0: no loop
+    u8 finetune;
+    u8 volume;
+} ModSample;
+
+typedef struct {
+    const ModSample *sample;
+    u16 period;
+    u8 volume;
+    u8 effect;
+    u8 param;
+    u32 step;
+} ModChannel;
+
+static ModSample s_samples[MOD_SAMPLES];
+static ModChannel s_channels[MOD_CHANNELS];
+static const u8 *s_orders = NULL;
+static const u8 *s_patterns = NULL;
+static int s_songLength = 0;
+static int s_restart = 0;
+
+static int s_order = 0;
+static int s_row = 0;
+static int s_tick = 0;
+static int s_speed = DEFAULT_SPEED;
+static int s_tickSamples = 0;   // 8.8 output samples per tick
+static int s_tickFrac = 0;
+static int s_nextOrder = -1;    // Set by B and D for the end of the row
+static int s_nextRow = 0;
+
+static inline u32 readWord(const u8 *p) {
+    return (p[0] << 8) | p[1]; // Big-endian
+}
+
+static void setPeriod(ModChannel *ch, int period) {
+    if (period < PERIOD_MIN) period = PERIOD_MIN;
+    if (period > PERIOD_MAX) period = PERIOD_MAX;
+    ch->period = period;
+    ch->step = ((PERIOD_STEP / period) * FINETUNE[ch->sample ? ch->sample->finetune : 0]) >> 16;
+}
+
+static void setVolume(ModChannel *ch, int volume) {
+    if (volume < 0) volume = 0;
+    if (volume > AUDIO_MAX_VOLUME) volume = AUDIO_MAX_VOLUME;
+    ch->volume = volume;
+}
+
+static void trigger(int c, u32 offset) {
+    const ModSample *s = s_channels[c].sample;
+    if (!s || !s->length) {
+        audioVoiceStop(c);
+        return;
+    }
+    audioVoiceStart(c, s->data, offset, s->length, s->loopStart, s->loopLength);
+}
+
+static void playRow(void) {
+    const u8 *cell = s_patterns + s_orders[s_order] * PATTERN_BYTES + s_row * MOD_CHANNELS * CELL_BYTES;
+
+    for (int c = 0; c < MOD_CHANNELS; c++, cell += CELL_BYTES) {
+        ModChannel *ch = &s_channels[c];
+        int sample = (cell[0] & 0xF0) | (cell[2] >> 4);
+        int period = ((cell[0] & 0x0F) << 8) | cell[1];
+        int effect = cell[2] & 0x0F;
+        int param = cell[3];
+        int x = param >> 4;
+        int y = param & 0x0F;
+
+        if (sample && sample <= MOD_SAMPLES) {
+            ch->sample = &s_samples[sample - 1];
+            ch->volume = ch->sample->volume;
+        }
+        if (period) {
+            setPeriod(ch, period);
+            trigger(c, (effect == 0x9) ? param << 8 : 0);
+        }
+        ch->effect = effect;
+        ch->param = param;
+
+        switch (effect) {
+        case 0xB:
+            s_nextOrder = param;
+            s_nextRow = 0;
+            break;
+        case 0xC:
+            setVolume(ch, param);
+            break;
+        case 0xD:
+            if (s_nextOrder < 0) s_nextOrder = s_order + 1;
+            s_nextRow = x * 10 + y;
+            if (s_nextRow >= MOD_ROWS) s_nextRow = 0;
+            break;
+        case 0xE:
+            if (x == 0xA) setVolume(ch, ch->volume + y);
+            else if (x == 0xB) setVolume(ch, ch->volume - y);
+            else if (x == 0xC && y == 0) ch->volume = 0;
+            break;
+        case 0xF:
+            if (param == 0) break;
+            if (param < 32) s_speed = param;
+            else s_tickSamples = TICK_SAMPLES_BPM / param;
+            break;
+        }
+    }
+}
+
+// Effects that run on every tick but the row's first
+static void updateEffects(void) {
+    for (int c = 0; c < MOD_CHANNELS; c++) {
+        ModChannel *ch = &s_channels[c];
+        int x = ch->param >> 4;
+        int y = ch->param & 0x0F;
+
+        switch (ch->effect) {
+        case 0x1:
+            if (ch->period) setPeriod(ch, ch->period - ch->param);
+            break;
+        case 0x2:
+            if (ch->period) setPeriod(ch, ch->period + ch->param);
+            break;
+        case 0xA:
+            setVolume(ch, x ? ch->volume + x : ch->volume - y);
+            break;
+        case 0xE:
+            if (x == 0x9 && y && s_tick % y == 0) trigger(c, 0);
+            else if (x == 0xC && s_tick == y) ch->volume = 0;
+            break;
+        }
+    }
+}
+
+static void nextRow(void) {
+    if (s_nextOrder >= 0) {
+        s_order = s_nextOrder;
+        s_row = s_nextRow;
+        s_nextOrder = -1;
+    } else if (++s_row >= MOD_ROWS) {
+        s_row = 0;
+        s_order++;
+    }
+    if (s_order >= s_songLength) s_order = s_restart;
+}
+
+// The mixer's tick handler: runs the tick due now and returns the samples
+// until the next
+static int modTick(void) {
+    if (s_tick == 0) playRow();
+    else updateEffects();
+
+    for (int c = 0; c < MOD_CHANNELS; c++) {
+        MixVoice *v = audioVoice(c);
+        v->step = s_channels[c].step;
+        v->volume = s_channels[c].volume;
+    }
+
+    if (++s_tick >= s_speed) {
+        s_tick = 0;
+        nextRow();
+    }
+
+    s_tickFrac += s_tickSamples;
+    int samples = s_tickFrac >> 8;
+    s_tickFrac &= 0xFF;
+    return samples;
+}
+
+bool modPlay(const u8 *module, u32 size) {
+    modStop();
+    if (size < HEADER_BYTES) return false;
+    const u8 *tag = module + MODULE_TAG;
+    if (tag[0] != 'M' || tag[1] != '.' || tag[2] != 'K' || tag[3] != '.') return false;
+
+    s_songLength = module[SONG_LENGTH];
+    if (s_songLength == 0 || s_songLength > MOD_ORDERS) return false;
+    s_restart = (module[SONG_RESTART] < s_songLength) ? module[SONG_RESTART] : 0;
+    s_orders = module + SONG_ORDERS;
+    s_patterns = module + HEADER_BYTES;
+
+    // Sample data follows the highest pattern any order names
+    int patterns = 0;
+    for (int i = 0; i < MOD_ORDERS; i++) {
+        if (s_orders[i] >= patterns) patterns = s_orders[i] + 1;
+    }
+    u32 offset = HEADER_BYTES + patterns * PATTERN_BYTES;
+    if (offset > size) return false;
+
+    for (int i = 0; i < MOD_SAMPLES; i++) {
+        const u8 *h = module + SAMPLE_HEADERS + i * SAMPLE_HEADER_BYTES;
+        ModSample *s = &s_samples[i];
+        u32 length = readWord(h + 22) * 2;
+        if (offset + length > size) length = size - offset;
+        s->data = (const s8 *)(module + offset);
+        s->length = length;
+        s->finetune = h[24] & 0x0F;
+        s->volume = (h[25] > AUDIO_MAX_VOLUME) ? AUDIO_MAX_VOLUME : h[25];
+        s->loopStart = readWord(h + 26) * 2;
+        s->loopLength = readWord(h + 28) * 2;
+        // A one-word loop means none; clamp the rest to the data
+        if (s->loopLength <= 2 || s->loopStart >= length) s->loopLength = 0;
+        else if (s->loopStart + s->loopLength > length) s->loopLength = length - s->loopStart;
+        offset += length;
+    }
+
+    for (int c = 0; c < MOD_CHANNELS; c++) {
+        ModChannel *ch = &s_channels[c];
+        ch->sample = NULL;
+        ch->period = 0;
+        ch->volume = 0;
+        ch->effect = 0;
+        ch->param = 0;
+        ch->step = 0;
+        audioVoice(c)->pan = CHANNEL_PAN[c];
+    }
+    s_order = 0;
+    s_row = 0;
+    s_tick = 0;
+    s_speed = DEFAULT_SPEED;
+    s_tickSamples = TICK_SAMPLES_BPM / DEFAULT_TEMPO;
+    s_tickFrac = 0;
+    s_nextOrder = -1;
+
+    audioSetTickHandler(modTick);
+    return true;
+}
+
+void modStop(void) {
+    u16 ime = REG_IME;
+    REG_IME = 0;
+    audioSetTickHandler(NULL);
+    for (int c = 0; c < AUDIO_MUSIC_VOICES; c++) audioVoiceStop(c);
+    REG_IME = ime;
+}
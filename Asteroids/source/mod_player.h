@@ -0,0 +1,19 @@
+#ifndef MOD_PLAYER_H
+#define MOD_PLAYER_H
+
+#include <gba_types.h>
+#include <stdbool.h>
+
+// --- Module Player ---
+// Plays 4-channel ProTracker modules ("M.K.") on the mixer's music voices
+// (audio_mixer.h), ticked from inside the mix. Effects: 1/2 (portamento),
+// 9 (sample offset), A (volume slide), B (position jump), C (volume),
+// D (pattern break), F (speed/tempo), E9/EA/EB/EC (retrigger, fine volume
+// slides, note cut); others are ignored. Songs loop.
+
+// Starts 'module' (in ROM, e.g. a bin2o'd .mod); false if it is not a
+// 4-channel module
+bool modPlay(const u8 *module, u32 size);
+void modStop(void);
+
+#endif // MOD_PLAYER_H
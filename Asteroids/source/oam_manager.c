@@ -1,6 +1,11 @@
 #include <gba_types.h>
 #include <gba_base.h>
+#include <gba_interrupt.h>
+#include <gba_video.h>
 #include "game_objects.h"
+#include "mem_ops.h"
+#include "object_pool.h"
+#include "oam_manager.h"
 
 // GBA Hardware Definitions for OAM
 typedef struct {
@@ -12,94 +17,131 @@ typedef struct {
 
 #define OAM_SIZE 128
 #define OAM ((OAMEntry*)0x07000000)
-#define MEM_OAM_TILE (u16*)0x06010000 // OAM VRAM for tile data (Mode 0)
+// OBJ tile data. The bitmap modes keep their framebuffer in the lower half
+// of OBJ VRAM, so sprite tiles start at OBJ_TILE_BASE (0x06014000).
+#define MEM_OAM_TILE ((u16*)0x06010000)
+#define TILE_HALFWORDS 16 // 4bpp 8x8 tile: 32 bytes
 
 // OAM Attributes: Simplified placeholders for GBA library constants
 // You will need to define these based on your GBA toolchain (e.g., libgba, devkitPro)
 #define ATTR0_Y_MASK        0x00FF
 #define ATTR0_MODE_NORMAL   0x0000
+#define ATTR0_AFFINE        0x0100 // Bit 8: transformed by an affine matrix
 #define ATTR0_8BPP          0x2000
-#define ATTR0_HIDE          0x0200 // Bit 9: hide sprite
+#define ATTR0_HIDE          0x0200 // Bit 9: hide sprite (double size on affine sprites)
+#define ATTR0_DOUBLE        0x0200 // Bit 9 of an affine sprite: twice the clip box
+#define ATTR0_MODE_BITS     (ATTR0_AFFINE | ATTR0_HIDE)
+#define ATTR0_SHAPE_MASK    0xC000
 #define ATTR1_X_MASK        0x01FF
+#define ATTR1_AFFINE(n)     ((n) << 9) // Matrix index of an affine sprite
+#define ATTR1_AFFINE_MASK   0x3E00
+#define ATTR1_SIZE_MASK     0xC000
 #define ATTR1_SIZE_8        0x0000 // 8x8 size
 #define ATTR1_SIZE_16       0x4000 // 16x16 size
 #define ATTR2_TILE_MASK     0x03FF
 #define ATTR2_PRIO(p)       ((p) << 10) // Priority 0 is highest
+#define ATTR2_PRIO_MASK     0x0C00
+#define ATTR2_PRIO_SHIFT    10
+#define ATTR2_PALBANK(n)    ((n) << 12) // 16-color palette bank
+#define ATTR2_PALBANK_MASK  0xF000
+#define ATTR2_DEFAULT       ATTR2_PRIO(1) // New sprites: priority 1 (below player)
 
-// Tile indices for different sprite types
-#define TILE_ASTEROID_L     0   // 16x16 asteroid (large)
-#define TILE_ASTEROID_M     1   // 16x16 asteroid (medium)
-#define TILE_ASTEROID_S     2   // 8x8 asteroid (small)
-#define TILE_BULLET         3   // 8x8 bullet
+// Shadow OAM: all sprite changes land here and reach hardware only from
+// the VBlank handler
+static OAMEntry oam_copy[OAM_SIZE] ALIGN(4);
+// Snapshot of oam_copy taken when a frame is finished; the VBlank handler
+// writes it to OAM together with that frame's framebuffer
+static OAMEntry oam_latched[OAM_SIZE] ALIGN(4);
+static bool oam_active = false;              // Set once initOAM() has run
+static volatile bool oam_latch_pending = false;
+// Entries [lo, hi) changed in oam_copy since the last latch, and in
+// oam_latched since the last commit: only those are copied and DMAed
+static int dirty_lo = OAM_SIZE, dirty_hi = 0;
+static int latched_lo = OAM_SIZE, latched_hi = 0;
+// One past the highest allocated slot; entries above it stay hidden
+static int oam_top = 0;
+// Priority sort: hardware entries ordered by priority, not by slot
+static bool oam_sort = false;
+static int oam_sorted_count = 0; // Visible entries the last sorted latch wrote
+// Affine bits of hidden sprites (bit 9 means double size on affine
+// sprites, so hiding has to drop them), restored by showOAMSprite()
+static u16 oam_hidden_mode[OAM_SIZE];
+// Allocation state of the OAM slots. Callers hold generation-checked handles,
+// so an oam_index kept after its sprite was released is rejected.
+static ObjectPool oam_pool;
+// Same for the affine matrices, which live in the padding of OAM entries:
+// matrix n is the 'fill' of entries 4n..4n+3
+static ObjectPool affine_pool;
 
-// Global OAM cache to minimize hardware writes
-static OAMEntry oam_copy[OAM_SIZE];
-static u8 oam_free[OAM_SIZE]; // 0 = allocated, 1 = free
+// Resolves a sprite handle to its OAM slot, or -1 if the handle is stale/invalid
+static inline int oamSlot(int oam_handle) {
+    return poolHandleValid(&oam_pool, oam_handle) ? POOL_HANDLE_INDEX(oam_handle) : -1;
+}
+
+static inline void markDirty(int lo, int hi) {
+    if (lo < dirty_lo) dirty_lo = lo;
+    if (hi > dirty_hi) dirty_hi = hi;
+}
+
+static inline void writeAttr0(int i, u16 attr0) {
+    oam_copy[i].attr0 = attr0;
+    markDirty(i, i + 1);
+}
+
+static inline void writeAttr1(int i, u16 attr1) {
+    oam_copy[i].attr1 = attr1;
+    markDirty(i, i + 1);
+}
+
+static inline void writeAttr2(int i, u16 attr2) {
+    oam_copy[i].attr2 = attr2;
+    markDirty(i, i + 1);
+}
 
 /**
- * Allocates a free OAM sprite index. Returns -1 if no sprites available.
+ * Allocates a free OAM sprite, hidden, at priority 1. Returns a sprite
+ * handle, or -1 if no sprites available.
  */
 int allocateOAMSprite() {
-    for (int i = 0; i < OAM_SIZE; i++) {
-        if (oam_free[i]) {
-            oam_free[i] = 0; // Mark as allocated
-            return i;
-        }
-    }
-    return -1; // No free sprites
+    int handle = poolAlloc(&oam_pool);
+    if (handle < 0) return handle;
+    int i = POOL_HANDLE_INDEX(handle);
+    writeAttr0(i, ATTR0_HIDE);
+    writeAttr1(i, 0);
+    writeAttr2(i, ATTR2_DEFAULT);
+    oam_hidden_mode[i] = 0;
+    if (i >= oam_top) oam_top = i + 1;
+    return handle;
 }
 
 /**
- * Deallocates an OAM sprite index (marks as free and hides it).
+ * Deallocates an OAM sprite (marks as free and hides it).
  */
-void deallocateOAMSprite(int oam_index) {
-    if (oam_index < 0 || oam_index >= OAM_SIZE) return;
-    oam_free[oam_index] = 1; // Mark as free
-    oam_copy[oam_index].attr0 |= ATTR0_HIDE; // Hide sprite
+void deallocateOAMSprite(int oam_handle) {
+    int i = oamSlot(oam_handle);
+    if (i < 0) return;
+    writeAttr0(i, (oam_copy[i].attr0 & ~ATTR0_MODE_BITS) | ATTR0_HIDE); // Hide sprite
+    oam_hidden_mode[i] = 0;
+    poolFree(&oam_pool, oam_handle);
+    while (oam_top > 0 && !poolIsLive(&oam_pool, oam_top - 1)) oam_top--;
 }
 
 /**
- * Fills an 8x8 tile with a single palette color.
- * Each tile is 32 bytes (64 pixels = 8x8, 4 bits per pixel).
+ * Reports how many OAM slots are in use and the most ever used at once.
  */
-static void fillTileWithColor(int tile_index, u8 color) {
-    u32 *tile_ptr = (u32*)(MEM_OAM_TILE + tile_index * 32); // 32 bytes per tile
-    u32 color_pair = (color << 4) | color; // Two pixels of same color per byte
-    u32 color_word = (color_pair << 24) | (color_pair << 16) | (color_pair << 8) | color_pair;
-    
-    for (int i = 0; i < 8; i++) {
-        tile_ptr[i] = color_word;
-    }
+void getOAMPoolStats(PoolStats *stats) {
+    poolGetStats(&oam_pool, stats);
 }
 
 /**
- * Creates simple sprite tiles: asteroids (red, magenta, yellow) and bullets (cyan).
- * Each tile is 8x8 pixels, 4 bits per pixel (16 colors).
- * Tile data is stored in OAM VRAM at tile indices 0-3.
- * 
- * Palette usage:
- * - Palette colors for asteroids/bullets use indices 1-4 (color 0 is transparent)
- * - Red (asteroid large/medium): color 1
- * - Magenta (bullet): color 2
- * - Yellow (asteroid small): color 3
- * - Cyan (sprite outline): color 4
+ * Returns the tile data of a sprite tile (tile_index relative to OBJ_TILE_BASE).
  */
-void loadSpriteTiles() {
-    // Tile 0: TILE_ASTEROID_L (red)
-    fillTileWithColor(0, 1);
-    
-    // Tile 1: TILE_ASTEROID_M (magenta)
-    fillTileWithColor(1, 2);
-    
-    // Tile 2: TILE_ASTEROID_S (yellow)
-    fillTileWithColor(2, 3);
-    
-    // Tile 3: TILE_BULLET (cyan)
-    fillTileWithColor(3, 4);
+u16 *objTileData(int tile_index) {
+    return MEM_OAM_TILE + (OBJ_TILE_BASE + tile_index) * TILE_HALFWORDS;
 }
 
 /**
- * Initializes the sprite palette and tile data.
+ * Initializes the sprite palette (bank 0).
  * Sprite palette is stored at 0x05000200 (OBJ palette RAM).
  */
 void initSpritePalette() {
@@ -115,71 +157,264 @@ void initSpritePalette() {
 }
 
 /**
- * Initializes the OAM system: sets the video mode and clears the OAM memory.
+ * Initializes the OAM system: enables sprites on top of the display mode set
+ * by initGraphics() and clears the OAM memory.
  */
 void initOAM() {
     // Initialize sprite palette
     initSpritePalette();
     
-    // Set REG_DISPCNT to enable Mode 0 (Tile/Text mode) and OAM (Sprites)
-    // You may already have this in main.c, but ensure OAM is enabled.
-    // REG_DISPCNT |= DCNT_OBJ | DCNT_OBJ_1D; 
+    // Sprites on, with tiles laid out linearly (1D mapping)
+    REG_DISPCNT |= OBJ_ON | OBJ_1D_MAP;
     
     // Clear the OAM memory and mark all sprites as free
     for (int i = 0; i < OAM_SIZE; i++) {
         oam_copy[i].attr0 = ATTR0_HIDE; // Hide all sprites
         oam_copy[i].attr1 = 0;
         oam_copy[i].attr2 = 0;
-        oam_free[i] = 1; // Mark as free
+        oam_copy[i].fill = 0;
+        oam_hidden_mode[i] = 0;
     }
-    
-    // Load sprite tile data
-    loadSpriteTiles();
+    poolInit(&oam_pool, OAM_SIZE);
+    poolInit(&affine_pool, OAM_AFFINE_COUNT);
+    oam_top = 0;
+    oam_sorted_count = 0;
+    markDirty(0, OAM_SIZE); // The first commit clears whatever OAM held
+    oam_active = true;
 }
 
 /**
- * Updates an OAM entry in the local cache. Supports variable sizes.
+ * Places a sprite, sets its tile and size and shows it. Shape, affine
+ * matrix, priority and palette bank are left as they were.
  * size_bits: 0=8x8, 0x4000=16x16, etc. (ATTR1_SIZE_*)
  */
-void setOAMAttributes(int oam_index, int x, int y, int tile_index, u16 size_bits) {
-    if (oam_index < 0 || oam_index >= OAM_SIZE) return;
+void setOAMAttributes(int oam_handle, int x, int y, int tile_index, u16 size_bits) {
+    int oam_index = oamSlot(oam_handle);
+    if (oam_index < 0) return;
+    OAMEntry *e = &oam_copy[oam_index];
 
-    // Attribute 0: Y position (mask 0-255), Mode (Normal), Color Depth (4bpp)
-    oam_copy[oam_index].attr0 = (y & ATTR0_Y_MASK) | ATTR0_MODE_NORMAL;
+    // Attribute 0: Y position (mask 0-255), keeping shape and mode
+    writeAttr0(oam_index, (e->attr0 & ~ATTR0_Y_MASK) | (y & ATTR0_Y_MASK));
+    showOAMSprite(oam_handle);
 
-    // Attribute 1: X position (mask 0-511), Size
-    oam_copy[oam_index].attr1 = (x & ATTR1_X_MASK) | size_bits;
+    // Attribute 1: X position (mask 0-511), Size, keeping the matrix index
+    writeAttr1(oam_index, (e->attr1 & ATTR1_AFFINE_MASK) | (x & ATTR1_X_MASK) | (size_bits & ATTR1_SIZE_MASK));
     
-    // Attribute 2: Tile Index, Priority
-    oam_copy[oam_index].attr2 = (tile_index & ATTR2_TILE_MASK) | ATTR2_PRIO(1); // Priority 1 (below player)
+    // Attribute 2: Tile Index, keeping priority and palette bank
+    writeAttr2(oam_index, (e->attr2 & ~ATTR2_TILE_MASK) | ((OBJ_TILE_BASE + tile_index) & ATTR2_TILE_MASK));
+}
+
+void setOAMPosition(int oam_handle, int x, int y) {
+    int oam_index = oamSlot(oam_handle);
+    if (oam_index < 0) return;
+    OAMEntry *e = &oam_copy[oam_index];
+    writeAttr0(oam_index, (e->attr0 & ~ATTR0_Y_MASK) | (y & ATTR0_Y_MASK));
+    writeAttr1(oam_index, (e->attr1 & ~ATTR1_X_MASK) | (x & ATTR1_X_MASK));
+}
+
+void setOAMTile(int oam_handle, int tile_index) {
+    int oam_index = oamSlot(oam_handle);
+    if (oam_index < 0) return;
+    OAMEntry *e = &oam_copy[oam_index];
+    writeAttr2(oam_index, (e->attr2 & ~ATTR2_TILE_MASK) | ((OBJ_TILE_BASE + tile_index) & ATTR2_TILE_MASK));
+}
+
+/**
+ * Sets the sprite's shape (OAM_SHAPE_*) and size (ATTR1_SIZE_*); together
+ * they pick its dimensions.
+ */
+void setOAMShape(int oam_handle, u16 shape_bits, u16 size_bits) {
+    int oam_index = oamSlot(oam_handle);
+    if (oam_index < 0) return;
+    OAMEntry *e = &oam_copy[oam_index];
+    writeAttr0(oam_index, (e->attr0 & ~ATTR0_SHAPE_MASK) | (shape_bits & ATTR0_SHAPE_MASK));
+    writeAttr1(oam_index, (e->attr1 & ~ATTR1_SIZE_MASK) | (size_bits & ATTR1_SIZE_MASK));
+}
+
+void setOAMPriority(int oam_handle, int priority) {
+    int oam_index = oamSlot(oam_handle);
+    if (oam_index < 0) return;
+    OAMEntry *e = &oam_copy[oam_index];
+    writeAttr2(oam_index, (e->attr2 & ~ATTR2_PRIO_MASK) | (ATTR2_PRIO(priority) & ATTR2_PRIO_MASK));
+}
+
+void setOAMPaletteBank(int oam_handle, int palette_bank) {
+    int oam_index = oamSlot(oam_handle);
+    if (oam_index < 0) return;
+    OAMEntry *e = &oam_copy[oam_index];
+    writeAttr2(oam_index, (e->attr2 & ~ATTR2_PALBANK_MASK) | (ATTR2_PALBANK(palette_bank) & ATTR2_PALBANK_MASK));
 }
 
 /**
- * Hide an OAM sprite (for inactive objects).
+ * Allocates one of the 32 affine matrices. Returns a matrix handle, or -1 if
+ * none are free.
  */
-void hideOAMSprite(int oam_index) {
-    if (oam_index < 0 || oam_index >= OAM_SIZE) return;
-    oam_copy[oam_index].attr0 |= ATTR0_HIDE;
+int allocateOAMAffine() {
+    return poolAlloc(&affine_pool);
+}
+
+void deallocateOAMAffine(int affine_handle) {
+    poolFree(&affine_pool, affine_handle);
 }
 
 /**
- * Show an OAM sprite.
+ * Sets an affine matrix (8.8 fixed point). It maps screen offsets from the
+ * sprite's center to texture offsets, so a rotation by angle A is
+ * pa = cos A, pb = sin A, pc = -sin A, pd = cos A.
  */
-void showOAMSprite(int oam_index) {
-    if (oam_index < 0 || oam_index >= OAM_SIZE) return;
-    oam_copy[oam_index].attr0 &= ~ATTR0_HIDE;
+void setOAMAffine(int affine_handle, s16 pa, s16 pb, s16 pc, s16 pd) {
+    if (!poolHandleValid(&affine_pool, affine_handle)) return;
+    int first = POOL_HANDLE_INDEX(affine_handle) * 4;
+    OAMEntry *entry = &oam_copy[first];
+    entry[0].fill = pa;
+    entry[1].fill = pb;
+    entry[2].fill = pc;
+    entry[3].fill = pd;
+    markDirty(first, first + 4);
 }
 
 /**
- * Copies the local OAM cache to the hardware OAM memory.
- * This should be called once per frame (after VBlank).
+ * Transforms a sprite by an affine matrix, optionally with the doubled clip
+ * box; affine_handle -1 makes it a regular sprite again.
+ */
+void setOAMAffineIndex(int oam_handle, int affine_handle, bool double_size) {
+    int oam_index = oamSlot(oam_handle);
+    if (oam_index < 0) return;
+    u16 mode = 0, matrix = 0;
+    if (affine_handle >= 0) {
+        if (!poolHandleValid(&affine_pool, affine_handle)) return;
+        mode = ATTR0_AFFINE | (double_size ? ATTR0_DOUBLE : 0);
+        matrix = ATTR1_AFFINE(POOL_HANDLE_INDEX(affine_handle));
+    }
+    OAMEntry *e = &oam_copy[oam_index];
+    if ((e->attr0 & ATTR0_MODE_BITS) == ATTR0_HIDE) {
+        oam_hidden_mode[oam_index] = mode; // Applied by showOAMSprite()
+    } else {
+        writeAttr0(oam_index, (e->attr0 & ~ATTR0_MODE_BITS) | mode);
+    }
+    writeAttr1(oam_index, (e->attr1 & ~ATTR1_AFFINE_MASK) | matrix);
+}
+
+/**
+ * Shows a square sprite transformed by an affine matrix. Its texture is
+ * drawn around the center of the size_bits box placed at (x, y).
+ */
+void setOAMAffineAttributes(int oam_handle, int affine_handle, int x, int y,
+                            int tile_index, int palette_bank, int priority, u16 size_bits) {
+    int oam_index = oamSlot(oam_handle);
+    if (oam_index < 0 || !poolHandleValid(&affine_pool, affine_handle)) return;
+
+    oam_hidden_mode[oam_index] = 0;
+    writeAttr0(oam_index, (y & ATTR0_Y_MASK) | ATTR0_AFFINE);
+    writeAttr1(oam_index, (x & ATTR1_X_MASK) | ATTR1_AFFINE(POOL_HANDLE_INDEX(affine_handle)) | size_bits);
+    writeAttr2(oam_index, ((OBJ_TILE_BASE + tile_index) & ATTR2_TILE_MASK)
+                        | ATTR2_PRIO(priority) | ATTR2_PALBANK(palette_bank));
+}
+
+/**
+ * Hide an OAM sprite (for inactive objects). On an affine sprite bit 9 means
+ * double size, so the affine bits are set aside until it is shown again.
+ */
+void hideOAMSprite(int oam_handle) {
+    int oam_index = oamSlot(oam_handle);
+    if (oam_index < 0) return;
+    u16 attr0 = oam_copy[oam_index].attr0;
+    if (attr0 & ATTR0_AFFINE) oam_hidden_mode[oam_index] = attr0 & ATTR0_MODE_BITS;
+    else if (attr0 & ATTR0_HIDE) return; // Already hidden
+    writeAttr0(oam_index, (attr0 & ~ATTR0_MODE_BITS) | ATTR0_HIDE);
+}
+
+/**
+ * Show an OAM sprite, restoring the affine mode it was hidden with.
+ */
+void showOAMSprite(int oam_handle) {
+    int oam_index = oamSlot(oam_handle);
+    if (oam_index < 0) return;
+    u16 attr0 = oam_copy[oam_index].attr0;
+    if ((attr0 & ATTR0_AFFINE) || !(attr0 & ATTR0_HIDE)) return; // Already shown
+    writeAttr0(oam_index, (attr0 & ~ATTR0_MODE_BITS) | oam_hidden_mode[oam_index]);
+    oam_hidden_mode[oam_index] = 0;
+}
+
+/**
+ * Orders the hardware entries by priority (stable, so equal priorities keep
+ * their slot order). Sprites overlap by OAM index, not by priority, so a
+ * priority 2 sprite in a lower slot would otherwise cover a priority 0 one.
+ */
+void oamSetPrioritySort(bool enabled) {
+    if (enabled == oam_sort) return;
+    oam_sort = enabled;
+    markDirty(0, OAM_SIZE); // Entries move between the two layouts
+}
+
+/**
+ * Queues the shadow OAM for the next VBlank. The frame pipeline already does
+ * this for every finished frame; OAM itself is only written in VBlank.
  */
 void updateOAM() {
-    // Copy the local cache to the hardware OAM memory
-    // This is the actual fast hardware write operation.
-    // Use the compiler's intrinsic for fast memory copy if available (e.g., DmaCopy)
-    // For simplicity, using a loop here, but a DMA copy is faster.
-    for (int i = 0; i < OAM_SIZE; i++) {
-        OAM[i] = oam_copy[i];
+    u16 ime = REG_IME;
+    REG_IME = 0;
+    oamLatch();
+    REG_IME = ime;
+}
+
+// Sorted latch: visible entries go to the front by priority, the slots
+// the last sorted latch used behind them are hidden. Matrices stay in
+// place, since they belong to the hardware slots, not to the sprites.
+static void latchSorted(void) {
+    int count = 0;
+    for (int prio = 0; prio < 4; prio++) {
+        for (int i = 0; i < oam_top; i++) {
+            const OAMEntry *e = &oam_copy[i];
+            bool hidden = (e->attr0 & ATTR0_MODE_BITS) == ATTR0_HIDE;
+            if (hidden || ((e->attr2 & ATTR2_PRIO_MASK) >> ATTR2_PRIO_SHIFT) != prio) continue;
+            oam_latched[count].attr0 = e->attr0;
+            oam_latched[count].attr1 = e->attr1;
+            oam_latched[count].attr2 = e->attr2;
+            count++;
+        }
     }
-}
\ No newline at end of file
+    // Only the matrix words keep their index
+    for (int i = dirty_lo; i < dirty_hi; i++) {
+        oam_latched[i].fill = oam_copy[i].fill;
+    }
+    int end = (count > oam_sorted_count) ? count : oam_sorted_count;
+    if (dirty_hi > end) end = dirty_hi;
+    for (int i = count; i < end; i++) {
+        oam_latched[i].attr0 = ATTR0_HIDE;
+    }
+    oam_sorted_count = count;
+    if (end > latched_hi) latched_hi = end;
+    latched_lo = 0;
+}
+
+/**
+ * Snapshots the changed part of the shadow OAM for the frame just finished
+ * (frame pipeline, interrupts off). Does nothing until sprites are in use.
+ */
+void oamLatch(void) {
+    if (!oam_active) return;
+    if (dirty_lo >= dirty_hi) return; // Nothing changed since the last frame
+    if (oam_sort) {
+        latchSorted();
+    } else {
+        memCopy32(&oam_latched[dirty_lo], &oam_copy[dirty_lo], (dirty_hi - dirty_lo) * sizeof(OAMEntry));
+        if (dirty_lo < latched_lo) latched_lo = dirty_lo;
+        if (dirty_hi > latched_hi) latched_hi = dirty_hi;
+    }
+    dirty_lo = OAM_SIZE;
+    dirty_hi = 0;
+    oam_latch_pending = true;
+}
+
+/**
+ * DMAs the latched entries to hardware OAM. Called from the VBlank handler,
+ * before the framebuffer copy runs past the blanking period.
+ */
+void oamCommit(void) {
+    if (!oam_latch_pending) return;
+    memDmaCopy32(&OAM[latched_lo], &oam_latched[latched_lo], (latched_hi - latched_lo) * sizeof(OAMEntry));
+    latched_lo = OAM_SIZE;
+    latched_hi = 0;
+    oam_latch_pending = false;
+}
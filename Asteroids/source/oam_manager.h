@@ -0,0 +1,61 @@
+#ifndef OAM_MANAGER_H
+#define OAM_MANAGER_H
+
+#include <gba_types.h>
+#include <stdbool.h>
+#include "object_pool.h"
+
+// Sprites are edited in a shadow OAM. Each change marks its entries dirty,
+// and only the dirty range (bounded by the highest allocated slot) is copied
+// to hardware, by DMA in VBlank, so sprite updates never tear.
+// Sprite handles returned by allocateOAMSprite() are generation checked:
+// every function below ignores a handle whose sprite has since been freed.
+
+void initOAM(void);
+int allocateOAMSprite(void);
+void deallocateOAMSprite(int oam_handle);
+void getOAMPoolStats(PoolStats *stats);
+
+// Sprite tile indices are relative to OBJ_TILE_BASE: in the bitmap modes the
+// framebuffer covers the OBJ VRAM below it
+#define OBJ_TILE_BASE       512
+#define OBJ_TILE_COUNT      512
+u16 *objTileData(int tile_index); // 4bpp tile, 32 bytes
+
+// Sprite shapes (attribute 0); with ATTR1_SIZE_* they give the dimensions
+#define OAM_SHAPE_SQUARE    0x0000
+#define OAM_SHAPE_WIDE      0x4000
+#define OAM_SHAPE_TALL      0x8000
+
+// Places, sizes and shows a sprite, keeping the attributes set below
+void setOAMAttributes(int oam_handle, int x, int y, int tile_index, u16 size_bits);
+void setOAMPosition(int oam_handle, int x, int y);
+void setOAMTile(int oam_handle, int tile_index);
+void setOAMShape(int oam_handle, u16 shape_bits, u16 size_bits);
+void setOAMPriority(int oam_handle, int priority);      // 0 (front) to 3; new sprites get 1
+void setOAMPaletteBank(int oam_handle, int palette_bank);
+void hideOAMSprite(int oam_handle);
+void showOAMSprite(int oam_handle);
+
+// Affine (rotation/scale) matrices, handed out like sprite handles
+#define OAM_AFFINE_COUNT    32
+int allocateOAMAffine(void);
+void deallocateOAMAffine(int affine_handle);
+void setOAMAffine(int affine_handle, s16 pa, s16 pb, s16 pc, s16 pd);
+void setOAMAffineIndex(int oam_handle, int affine_handle, bool double_size); // -1: regular sprite
+void setOAMAffineAttributes(int oam_handle, int affine_handle, int x, int y,
+                            int tile_index, int palette_bank, int priority, u16 size_bits);
+
+// Draws sprites in priority order instead of slot order (off by default)
+void oamSetPrioritySort(bool enabled);
+
+// Queues the shadow OAM for the next VBlank outside the frame pipeline
+void updateOAM(void);
+
+// Frame pipeline: oamLatch() snapshots the entries changed since the last
+// frame when one is finished, oamCommit() DMAs them to OAM from the VBlank
+// handler. Hardware OAM is never written outside VBlank.
+void oamLatch(void);
+void oamCommit(void);
+
+#endif // OAM_MANAGER_H
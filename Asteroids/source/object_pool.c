@@ -0,0 +1,156 @@
+#include "object_pool.h"
+
+// De Bruijn lookup for count-trailing-zeros. ARM7TDMI has no CLZ instruction,
+// so one multiply plus a table read beats libgcc's bit-by-bit __ctzsi2.
+static const u8 DEBRUIJN_CTZ[32] = {
+     0,  1, 28,  2, 29, 14, 24,  3, 30, 22, 20, 15, 25, 17,  4,  8,
+    31, 27, 13, 23, 21, 19, 16,  7, 26, 12, 18,  6, 11,  5, 10,  9
+};
+
+static inline int lowestSetBit(u32 w) {
+    // w must be non-zero
+    return DEBRUIJN_CTZ[((w & -w) * 0x077CB531u) >> 27];
+}
+
+static inline void setLive(ObjectPool *pool, int index) {
+    pool->liveMask[index >> 5] |= (1u << (index & 31));
+}
+
+static inline void clearLive(ObjectPool *pool, int index) {
+    pool->liveMask[index >> 5] &= ~(1u << (index & 31));
+}
+
+void poolInit(ObjectPool *pool, int capacity) {
+    if (capacity > POOL_MAX_CAPACITY) capacity = POOL_MAX_CAPACITY;
+    if (capacity < 0) capacity = 0;
+    pool->capacity = (u8)capacity;
+    pool->highWater = 0;
+    pool->allocFailures = 0;
+    for (int w = 0; w < POOL_MASK_WORDS; w++) {
+        pool->liveMask[w] = 0;
+    }
+    for (int i = 0; i < POOL_MAX_CAPACITY; i++) {
+        pool->generation[i] = 0;
+    }
+    poolReset(pool);
+}
+
+void poolReset(ObjectPool *pool) {
+    for (int w = 0; w < POOL_MASK_WORDS; w++) {
+        u32 live = pool->liveMask[w];
+        // Invalidate outstanding handles of slots that were live
+        while (live) {
+            int bit = lowestSetBit(live);
+            live &= live - 1;
+            pool->generation[(w << 5) + bit]++;
+        }
+        pool->liveMask[w] = 0;
+    }
+    // Ascending free list so the first allocations get the lowest slots
+    for (int i = 0; i < pool->capacity; i++) {
+        pool->next[i] = (u8)((i + 1 < pool->capacity) ? (i + 1) : POOL_NIL);
+    }
+    pool->freeHead = (pool->capacity > 0) ? 0 : POOL_NIL;
+    pool->liveCount = 0;
+}
+
+void poolBeginRebuild(ObjectPool *pool) {
+    poolReset(pool);
+    pool->freeHead = POOL_NIL;
+}
+
+void poolMarkLive(ObjectPool *pool, int index) {
+    if (index < 0 || index >= pool->capacity || poolIsLive(pool, index)) return;
+    setLive(pool, index);
+    pool->liveCount++;
+}
+
+void poolEndRebuild(ObjectPool *pool) {
+    // Relink the free list from the bitmap, highest slot first so the head
+    // ends up on the lowest free slot.
+    pool->freeHead = POOL_NIL;
+    for (int i = pool->capacity - 1; i >= 0; i--) {
+        if (!poolIsLive(pool, i)) {
+            pool->next[i] = pool->freeHead;
+            pool->freeHead = (u8)i;
+        }
+    }
+    if (pool->liveCount > pool->highWater) pool->highWater = pool->liveCount;
+}
+
+int poolAllocIndex(ObjectPool *pool) {
+    int index = pool->freeHead;
+    if (index == POOL_NIL) {
+        pool->allocFailures++;
+        return -1;
+    }
+    pool->freeHead = pool->next[index];
+    setLive(pool, index);
+    pool->liveCount++;
+    if (pool->liveCount > pool->highWater) pool->highWater = pool->liveCount;
+    return index;
+}
+
+void poolFreeIndex(ObjectPool *pool, int index) {
+    if (index < 0 || index >= pool->capacity || !poolIsLive(pool, index)) return;
+    clearLive(pool, index);
+    pool->generation[index]++;
+    pool->next[index] = pool->freeHead;
+    pool->freeHead = (u8)index;
+    pool->liveCount--;
+}
+
+int poolAlloc(ObjectPool *pool) {
+    int index = poolAllocIndex(pool);
+    if (index < 0) return POOL_INVALID_HANDLE;
+    return POOL_HANDLE(pool->generation[index], index);
+}
+
+bool poolHandleValid(const ObjectPool *pool, int handle) {
+    if (handle < 0) return false;
+    int index = POOL_HANDLE_INDEX(handle);
+    return index < pool->capacity
+        && poolIsLive(pool, index)
+        && pool->generation[index] == POOL_HANDLE_GEN(handle);
+}
+
+bool poolFree(ObjectPool *pool, int handle) {
+    if (!poolHandleValid(pool, handle)) return false;
+    poolFreeIndex(pool, POOL_HANDLE_INDEX(handle));
+    return true;
+}
+
+int poolHandleOf(const ObjectPool *pool, int index) {
+    if (index < 0 || index >= pool->capacity || !poolIsLive(pool, index)) {
+        return POOL_INVALID_HANDLE;
+    }
+    return POOL_HANDLE(pool->generation[index], index);
+}
+
+int poolFirst(const ObjectPool *pool) {
+    for (int w = 0; w < POOL_MASK_WORDS; w++) {
+        if (pool->liveMask[w]) return (w << 5) + lowestSetBit(pool->liveMask[w]);
+    }
+    return -1;
+}
+
+int poolNext(const ObjectPool *pool, int index) {
+    int w = (index + 1) >> 5;
+    int bit = (index + 1) & 31;
+    if (w >= POOL_MASK_WORDS) return -1;
+
+    // Remaining bits of the current word, then whole words after it
+    u32 rest = pool->liveMask[w] & (0xFFFFFFFFu << bit);
+    if (rest) return (w << 5) + lowestSetBit(rest);
+    for (w++; w < POOL_MASK_WORDS; w++) {
+        if (pool->liveMask[w]) return (w << 5) + lowestSetBit(pool->liveMask[w]);
+    }
+    return -1;
+}
+
+void poolGetStats(const ObjectPool *pool, PoolStats *stats) {
+    stats->capacity = pool->capacity;
+    stats->live = pool->liveCount;
+    stats->highWater = pool->highWater;
+    stats->allocFailures = pool->allocFailures;
+}
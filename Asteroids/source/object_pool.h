@@ -0,0 +1,83 @@
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#include <gba_types.h>
+#include <stdbool.h>
+
+// --- Fixed-Capacity Object Pool ---
+// Slots are handed out from an intrusive free list (O(1) alloc/free) and
+// tracked in a live bitmap so iteration only touches allocated slots.
+// Handles pack a per-slot generation with the slot index, so a handle kept
+// after its slot was freed (and possibly reused) is detected as stale.
+
+#define POOL_MAX_CAPACITY   128
+#define POOL_MASK_WORDS     (POOL_MAX_CAPACITY / 32)
+#define POOL_NIL            0xFF   // End of free list
+#define POOL_INVALID_HANDLE (-1)
+
+// Handle layout: bits 0-7 slot index, bits 8-15 slot generation
+#define POOL_HANDLE(gen, idx)   ((int)(((gen) << 8) | (idx)))
+#define POOL_HANDLE_INDEX(h)    ((h) & 0xFF)
+#define POOL_HANDLE_GEN(h)      (((h) >> 8) & 0xFF)
+
+typedef struct {
+    u32 liveMask[POOL_MASK_WORDS];   // 1 bit per slot, set while allocated
+    u8 next[POOL_MAX_CAPACITY];      // Free-list links (valid only for free slots)
+    u8 generation[POOL_MAX_CAPACITY];// Bumped on every free
+    u8 freeHead;                     // First free slot, POOL_NIL when full
+    u8 capacity;
+    u8 liveCount;
+    u8 highWater;                    // Most slots ever live at once
+    u16 allocFailures;               // Allocations refused because the pool was full
+} ObjectPool;
+
+typedef struct {
+    int capacity;
+    int live;
+    int highWater;
+    int allocFailures;
+} PoolStats;
+
+void poolInit(ObjectPool *pool, int capacity);
+
+// Frees every slot (bumping generations) but keeps the high-water statistics.
+void poolReset(ObjectPool *pool);
+
+// Rebuilds the pool from external state (e.g. after loading a saved game):
+// call poolBeginRebuild, poolMarkLive for every live slot, then poolEndRebuild.
+void poolBeginRebuild(ObjectPool *pool);
+void poolMarkLive(ObjectPool *pool, int index);
+void poolEndRebuild(ObjectPool *pool);
+
+// Allocation by handle (generation checked)
+int poolAlloc(ObjectPool *pool);            // Returns a handle or POOL_INVALID_HANDLE
+bool poolFree(ObjectPool *pool, int handle); // Returns false for stale/invalid handles
+bool poolHandleValid(const ObjectPool *pool, int handle);
+int poolHandleOf(const ObjectPool *pool, int index); // Current handle of a live slot
+
+// Allocation by slot index (for arrays that already carry an isAlive flag)
+int poolAllocIndex(ObjectPool *pool);       // Returns a slot index or -1
+void poolFreeIndex(ObjectPool *pool, int index);
+
+static inline bool poolIsLive(const ObjectPool *pool, int index) {
+    return (pool->liveMask[index >> 5] >> (index & 31)) & 1;
+}
+
+static inline int poolLiveCount(const ObjectPool *pool) {
+    return pool->liveCount;
+}
+
+static inline int poolFreeCount(const ObjectPool *pool) {
+    return pool->capacity - pool->liveCount;
+}
+
+// Live-slot iteration in ascending index order
+int poolFirst(const ObjectPool *pool);
+int poolNext(const ObjectPool *pool, int index);
+
+#define POOL_FOR_EACH(pool, idx) \
+    for (int idx = poolFirst(pool); idx >= 0; idx = poolNext(pool, idx))
+
+void poolGetStats(const ObjectPool *pool, PoolStats *stats);
+
+#endif // OBJECT_POOL_H
@@ -0,0 +1,55 @@
+#include "object_sprites.h"
+
+#ifdef RENDER_TILED
+
+#include "game_objects.h"
+#include "graphics.h"
+#include "oam_manager.h"
+#include "sprite_tiles.h"
+
+#define OBJECT_SPRITE_COUNT (MAX_ASTEROIDS + MAX_BULLETS)
+
+static int s_sprites[OBJECT_SPRITE_COUNT]; // Sprite handles
+static int s_used = 0;      // Placed since objectSpritesBegin()
+static int s_shown = 0;     // Placed by the last frame, hidden past s_used
+
+void objectSpritesInit(void) {
+    for (int i = 0; i < OBJECT_SPRITE_COUNT; i++) {
+        s_sprites[i] = allocateOAMSprite();
+    }
+}
+
+void objectSpritesBegin(void) {
+    s_used = 0;
+}
+
+void objectSpriteAdd(int shape, int radius, int cx, int cy, int colorIdx) {
+    if (s_used >= OBJECT_SPRITE_COUNT) return;
+    int tile = spriteTileGet(shape, radius);
+    if (tile < 0) return;
+
+    // OAM coordinates wrap (y at 256, x at 512): a sprite past the bottom
+    // or right edge would reappear at the top or left
+    int size = spriteTileSize(radius);
+    int x = cx - size / 2;
+    int y = cy - size / 2;
+    if (x >= SCREEN_WIDTH || y >= SCREEN_HEIGHT || x + size <= 0 || y + size <= 0) return;
+
+    int h = s_sprites[s_used++];
+    setOAMAttributes(h, x, y, tile, spriteTileSizeBits(radius));
+    setOAMPaletteBank(h, spriteColorBank(colorIdx));
+}
+
+void objectSpritesEnd(void) {
+    for (int i = s_used; i < s_shown; i++) {
+        hideOAMSprite(s_sprites[i]);
+    }
+    s_shown = s_used;
+}
+
+void objectSpritesHide(void) {
+    s_used = 0;
+    objectSpritesEnd();
+}
+
+#endif // RENDER_TILED
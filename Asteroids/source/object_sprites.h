@@ -0,0 +1,33 @@
+#ifndef OBJECT_SPRITES_H
+#define OBJECT_SPRITES_H
+
+#include <gba_types.h>
+
+// --- Object Sprites ---
+// The tiled renderer (RENDERER=tiled) shows asteroids and bullets as OBJ
+// sprites from the sprite_tiles.h cache instead of drawing them into BG2: a
+// frame only writes a few attributes per object, and no pixels. Sprites
+// are handed out in draw order between objectSpritesBegin() and
+// objectSpritesEnd(); the ones left over are hidden. The bitmap renderers
+// draw objects into the frame and these do nothing there.
+
+#ifdef RENDER_TILED
+// Allocates the sprites; call after initOAM()
+void objectSpritesInit(void);
+
+void objectSpritesBegin(void);
+// A cached shape (SPRITE_SHAPE_*) centered on (cx, cy) in rainbow color
+// 'colorIdx'; objects entirely off screen take no sprite
+void objectSpriteAdd(int shape, int radius, int cx, int cy, int colorIdx);
+void objectSpritesEnd(void);
+
+// Hides every object sprite (screens without objects)
+void objectSpritesHide(void);
+#else
+static inline void objectSpritesInit(void) {}
+static inline void objectSpritesBegin(void) {}
+static inline void objectSpritesEnd(void) {}
+static inline void objectSpritesHide(void) {}
+#endif
+
+#endif // OBJECT_SPRITES_H
@@ -0,0 +1,75 @@
+#include <gba_interrupt.h>
+#include <gba_video.h>
+#include "palette_anim.h"
+#include "fixed_math.h"
+
+typedef struct {
+    PaletteCycle def;
+    u8 step;     // Current offset into def.colors
+    u8 timer;    // VBlanks until the next step
+    s8 dir;      // +1 or -1 (ping-pong cycles)
+    bool enabled;
+} CycleState;
+
+static CycleState s_cycles[PALANIM_MAX_CYCLES];
+static volatile int s_cycleCount = 0;
+
+static void writeCycle(const CycleState *c) {
+    int color = c->step;
+    for (int i = 0; i < c->def.entries; i++) {
+        BG_PALETTE[c->def.first + i] = c->def.colors[color];
+        color = fxWrapInc(color, c->def.colorCount);
+    }
+}
+
+static void advanceCycle(CycleState *c) {
+    int last = c->def.colorCount - 1;
+    if (!(c->def.flags & PALCYCLE_PINGPONG)) {
+        c->step = fxWrapInc(c->step, c->def.colorCount);
+        return;
+    }
+    if (last == 0) return;
+    if ((c->dir > 0 && c->step == last) || (c->dir < 0 && c->step == 0)) c->dir = -c->dir;
+    c->step += c->dir;
+}
+
+void paletteAnimReset(void) {
+    s_cycleCount = 0;
+}
+
+int paletteCycleAdd(const PaletteCycle *cycle) {
+    if (s_cycleCount >= PALANIM_MAX_CYCLES || cycle->colorCount == 0) return -1;
+
+    int handle = s_cycleCount;
+    CycleState *c = &s_cycles[handle];
+    c->def = *cycle;
+    if (c->def.period == 0) c->def.period = 1;
+    c->step = 0;
+    c->timer = c->def.period;
+    c->dir = 1;
+    c->enabled = true;
+    writeCycle(c);
+
+    // The VBlank handler walks s_cycles up to s_cycleCount; publish the slot
+    // only once it is filled in
+    u16 ime = REG_IME;
+    REG_IME = 0;
+    s_cycleCount = handle + 1;
+    REG_IME = ime;
+    return handle;
+}
+
+void paletteCycleSetEnabled(int handle, bool enabled) {
+    if (handle < 0 || handle >= s_cycleCount) return;
+    s_cycles[handle].enabled = enabled;
+}
+
+void paletteAnimVBlank(void) {
+    for (int i = 0; i < s_cycleCount; i++) {
+        CycleState *c = &s_cycles[i];
+        if (!c->enabled || --c->timer) continue;
+        c->timer = c->def.period;
+        advanceCycle(c);
+        writeCycle(c);
+    }
+}
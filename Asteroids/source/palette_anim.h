@@ -0,0 +1,39 @@
+#ifndef PALETTE_ANIM_H
+#define PALETTE_ANIM_H
+
+#include <gba_types.h>
+#include <stdbool.h>
+
+// --- Palette Animation ---
+// Color cycles on BG palette entries, stepped by the VBlank handler. Pixels
+// drawn with a cycle's palette index change color with no redraw, so
+// animated-color objects cost one palette write per step instead of a
+// redraw. Only the paletted renderers (RENDERER=mode4 or tiled) draw with
+// palette indices; graphics.h lists the entries they reserve for cycles.
+#define PALANIM_MAX_CYCLES  4
+
+#define PALCYCLE_PINGPONG   (1 << 0) // Step back and forth instead of wrapping
+
+typedef struct {
+    const u16 *colors; // 15-bit colors the cycle steps through
+    u8 colorCount;
+    u8 first;          // First palette entry
+    u8 entries;        // Entry i shows colors[(i + step) % colorCount]
+    u8 period;         // VBlanks per step (at least 1)
+    u8 flags;          // PALCYCLE_*
+} PaletteCycle;
+
+// Drops all cycles (the palette entries keep their last colors)
+void paletteAnimReset(void);
+
+// Registers a cycle and writes its first step; returns its handle, or -1 when
+// all PALANIM_MAX_CYCLES are in use. 'colors' must outlive the cycle.
+int paletteCycleAdd(const PaletteCycle *cycle);
+
+// A paused cycle keeps its current colors
+void paletteCycleSetEnabled(int handle, bool enabled);
+
+// Called from the VBlank handler
+void paletteAnimVBlank(void);
+
+#endif // PALETTE_ANIM_H
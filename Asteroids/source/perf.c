@@ -0,0 +1,121 @@
+#include <gba_video.h>
+#include "fixed_math.h"
+#include "perf.h"
+
+// Average is kept scaled by 8 (AVG_SHIFT) so the smoothing keeps sub-line precision
+#define AVG_SHIFT 3
+
+static volatile u32 s_vblankCount = 0;
+static u32 s_startVBlank = 0;
+static int s_startLine = 0;
+static int s_lastLines = 0;
+static int s_avgLines8 = 0;
+static int s_worstLines = 0;
+static int s_budgetLines8 = FRAME_BUDGET_LINES << AVG_SHIFT;
+
+// Load fit: sums of units, lines, units^2 and units*lines over blocks of
+// FIT_FRAMES frames (asteroid counts change slowly); each block with
+// enough spread in the load refines the cost
+#define FIT_SHIFT       9
+#define FIT_FRAMES      (1 << FIT_SHIFT)
+#define FIT_MAX_LINES   (2 * SCANLINES_PER_FRAME)   // Outliers (e.g. a save) are clipped
+#define FIT_MIN_VAR     FIT_FRAMES                  // Variance of one unit^2
+static u32 s_fitUnits = 0, s_fitLines = 0, s_fitUnits2 = 0, s_fitUnitsLines = 0;
+static int s_fitFrames = 0;
+static int s_loadCost8 = -1;
+
+// Position of a scanline relative to the start of VBlank (line 160)
+static inline int linesSinceVBlank(int line) {
+    int pos = line - 160;
+    if (pos < 0) pos += SCANLINES_PER_FRAME;
+    return pos;
+}
+
+void perfVBlankHandler(void) {
+    s_vblankCount++;
+}
+
+void perfFrameStart(void) {
+    // Sample the line and the VBlank count together; if a VBlank slips in
+    // between the two reads, sample again.
+    u32 vb;
+    int line;
+    do {
+        vb = s_vblankCount;
+        line = REG_VCOUNT;
+    } while (vb != s_vblankCount);
+    s_startVBlank = vb;
+    s_startLine = line;
+
+    // The next VBlank is at line 160
+    int window = SCANLINES_PER_FRAME - linesSinceVBlank(line);
+    s_budgetLines8 += window - (s_budgetLines8 >> AVG_SHIFT);
+}
+
+void perfFrameEnd(void) {
+    u32 vb;
+    int line;
+    do {
+        vb = s_vblankCount;
+        line = REG_VCOUNT;
+    } while (vb != s_vblankCount);
+
+    // VBlank fires at line 160, so count whole refreshes from that point
+    int startPos = linesSinceVBlank(s_startLine);
+    int endPos = linesSinceVBlank(line);
+    int lines = (int)(vb - s_startVBlank) * SCANLINES_PER_FRAME + endPos - startPos;
+    if (lines < 0) lines = 0;
+
+    s_lastLines = lines;
+    s_avgLines8 += lines - (s_avgLines8 >> AVG_SHIFT);
+    if (lines > s_worstLines) s_worstLines = lines;
+}
+
+int perfLastFrameLines(void) {
+    return s_lastLines;
+}
+
+int perfAvgFrameLines(void) {
+    return s_avgLines8 >> AVG_SHIFT;
+}
+
+int perfWorstFrameLines(void) {
+    return s_worstLines;
+}
+
+void perfResetWorst(void) {
+    s_worstLines = 0;
+}
+
+int perfBudgetLines(void) {
+    return s_budgetLines8 >> AVG_SHIFT;
+}
+
+void perfSampleLoad(int units) {
+    int lines = s_lastLines > FIT_MAX_LINES ? FIT_MAX_LINES : s_lastLines;
+    s_fitUnits += units;
+    s_fitLines += lines;
+    s_fitUnits2 += units * units;
+    s_fitUnitsLines += units * lines;
+    if (++s_fitFrames < FIT_FRAMES) return;
+
+    // Covariance and variance of the block, times FIT_FRAMES. The products
+    // of sums stay within 32 bits unsigned for up to 24 units
+    // (MAX_ASTEROIDS) and FIT_MAX_LINES.
+    int cov = (int)(s_fitUnitsLines - ((s_fitUnits * s_fitLines) >> FIT_SHIFT));
+    int var = (int)(s_fitUnits2 - ((s_fitUnits * s_fitUnits) >> FIT_SHIFT));
+    if (var >= FIT_MIN_VAR) {
+        int cost8 = cov > 0 ? fxDiv(cov << 4, var >> 4) : 0;
+        s_loadCost8 = (s_loadCost8 < 0) ? cost8 : (s_loadCost8 + cost8) >> 1;
+    }
+    s_fitUnits = s_fitLines = s_fitUnits2 = s_fitUnitsLines = 0;
+    s_fitFrames = 0;
+}
+
+int perfLoadCost8(void) {
+    return s_loadCost8;
+}
+
+u32 perfVBlankCount(void) {
+    return s_vblankCount;
+}
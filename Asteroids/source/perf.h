@@ -0,0 +1,45 @@
+#ifndef PERF_H
+#define PERF_H
+
+#include <gba_types.h>
+
+// --- Frame Cost Measurement ---
+// Frame cost is measured in scanlines (1232 CPU cycles each) from the start
+// of a frame's work to its end. One display refresh is 228 scanlines.
+#define SCANLINES_PER_FRAME 228
+
+// Frame work starts once the VBlank handler returns and has to be done by
+// the next VBlank, so the present comes out of every refresh: in Mode 3 it
+// is a ~125-line DMA of the frame to VRAM, the paletted renderers flip a
+// page. FRAME_BUDGET_LINES is what is left (103 lines in Mode 3);
+// perfBudgetLines() measures it, audio mixing and late starts included.
+#ifdef RENDER_PALETTED
+#define FRAME_PRESENT_LINES 0
+#else
+#define FRAME_PRESENT_LINES 125
+#endif
+#define FRAME_BUDGET_LINES  (SCANLINES_PER_FRAME - FRAME_PRESENT_LINES)
+
+// Must be installed as (or called from) the VBlank interrupt handler
+void perfVBlankHandler(void);
+
+// Bracket the work of one frame: start right after the VBlank wait,
+// end once the frame has been presented.
+void perfFrameStart(void);
+void perfFrameEnd(void);
+
+int perfLastFrameLines(void);   // Cost of the most recent frame
+int perfAvgFrameLines(void);    // Smoothed cost (exponential average over ~8 frames)
+int perfWorstFrameLines(void);  // Worst frame since the last perfResetWorst()
+void perfResetWorst(void);
+int perfBudgetLines(void);      // Smoothed lines from frame start to the next VBlank
+
+// Frame cost per unit of load (e.g. live asteroids), least-squares fit over
+// blocks of 512 frames. Feed it after perfFrameEnd() on the frames the load
+// applies to; the cost is in lines x256, -1 until a block's load has varied
+// enough to fit.
+void perfSampleLoad(int units);
+int perfLoadCost8(void);
+u32 perfVBlankCount(void);      // VBlank interrupts seen since boot
+
+#endif // PERF_H
@@ -0,0 +1,44 @@
+#ifndef PSG_MUSIC_H
+#define PSG_MUSIC_H
+
+#include <gba_types.h>
+
+// --- PSG Song Format ---
+// A song gives each of the four PSG channels an order list of pattern
+// numbers; patterns are byte streams in ROM that the sequencer in sound.c
+// steps from the timer 1 interrupt, one tick at a time:
+//   0x00-0x47  note (PSG_NOTE), held for the current length
+//   0x7E       rest for the current length
+//   0x7F       end of pattern: continue with the channel's next order
+//   0x80-0xBF  set the length of the following notes and rests, 1-64 ticks
+//   0xC0-0xFF  select instrument 0-63 for the following notes
+// Channel 4 (noise) takes PSG_NOISE values in place of notes.
+
+#define PSG_CHANNELS    4
+
+enum { PN_C, PN_Cs, PN_D, PN_Ds, PN_E, PN_F, PN_Fs, PN_G, PN_Gs, PN_A, PN_As, PN_B };
+#define PSG_NOTE(pitch, octave) (PN_##pitch + 12 * ((octave) - 2)) // C2-B7
+#define PSG_NOISE(shift, ratio) (((shift) << 4) | (ratio))         // Noise frequency register bits
+#define PSG_REST        0x7E
+#define PSG_END         0x7F
+#define PSG_LEN(ticks)  (0x80 | ((ticks) - 1))
+#define PSG_INS(index)  (0xC0 | (index))
+
+#define PSG_ORDER_LOOP  0xFF // Ends an order list: the channel starts over
+
+typedef struct {
+    u16 envelope;   // Duty, length and envelope register (channel 3: its volume bits)
+    u16 sweep;      // Channel 1 sweep register
+} PsgInstrument;
+
+typedef struct {
+    u16 tickCounts;                     // Timer 1 counts (1/65536 s) per tick
+    const PsgInstrument *instruments;
+    const u8 *const *patterns;
+    const u8 *orders[PSG_CHANNELS];     // Pattern numbers, then PSG_ORDER_LOOP
+} PsgSong;
+
+// Songs (psg_songs.c)
+extern const PsgSong SONG_MENU;
+
+#endif // PSG_MUSIC_H
@@ -0,0 +1,99 @@
+#include "psg_music.h"
+
+// --- Menu Theme ---
+// Am F C G at 125 BPM: 50 ticks a second, 24 to the quarter note. The
+// lead alternates two phrases over the pad, bass and drum loops.
+
+#define TICK_COUNTS_50HZ 1311
+#define EIGHTH  12
+#define QUARTER 24
+#define HALF    48
+
+enum { INS_LEAD, INS_PAD, INS_BASS, INS_KICK, INS_HAT, INS_SNARE };
+
+static const PsgInstrument MENU_INSTRUMENTS[] = {
+    [INS_LEAD]  = { 0xA380, 0 }, // Duty 50%, volume 10, decay step 3
+    [INS_PAD]   = { 0x6740, 0 }, // Duty 25%, volume 6, slow decay
+    [INS_BASS]  = { 0x2000, 0 }, // Wave channel at full volume
+    [INS_KICK]  = { 0xC100, 0 }, // Volume 12, fast decay
+    [INS_HAT]   = { 0x4100, 0 },
+    [INS_SNARE] = { 0xA200, 0 },
+};
+
+#define KICK    PSG_NOISE(7, 7)
+#define SNARE   PSG_NOISE(3, 2)
+#define HAT     PSG_NOISE(0, 1)
+
+static const u8 LEAD_A[] = {
+    PSG_INS(INS_LEAD), PSG_LEN(EIGHTH),
+    PSG_NOTE(A, 4), PSG_NOTE(C, 5), PSG_NOTE(E, 5), PSG_NOTE(A, 5),
+    PSG_NOTE(G, 5), PSG_NOTE(E, 5), PSG_NOTE(C, 5), PSG_NOTE(E, 5),
+    PSG_NOTE(F, 4), PSG_NOTE(A, 4), PSG_NOTE(C, 5), PSG_NOTE(F, 5),
+    PSG_NOTE(E, 5), PSG_NOTE(C, 5), PSG_NOTE(A, 4), PSG_NOTE(C, 5),
+    PSG_NOTE(E, 4), PSG_NOTE(G, 4), PSG_NOTE(C, 5), PSG_NOTE(E, 5),
+    PSG_NOTE(D, 5), PSG_NOTE(C, 5), PSG_NOTE(G, 4), PSG_NOTE(C, 5),
+    PSG_NOTE(D, 5), PSG_NOTE(B, 4), PSG_NOTE(G, 4), PSG_NOTE(B, 4),
+    PSG_LEN(QUARTER), PSG_NOTE(D, 5), PSG_REST,
+    PSG_END,
+};
+
+static const u8 LEAD_B[] = {
+    PSG_INS(INS_LEAD),
+    PSG_LEN(QUARTER), PSG_NOTE(A, 5), PSG_LEN(EIGHTH), PSG_NOTE(G, 5), PSG_NOTE(E, 5),
+    PSG_LEN(QUARTER), PSG_NOTE(C, 5), PSG_LEN(EIGHTH), PSG_NOTE(E, 5), PSG_NOTE(G, 5),
+    PSG_LEN(QUARTER), PSG_NOTE(F, 5), PSG_LEN(EIGHTH), PSG_NOTE(E, 5), PSG_NOTE(C, 5),
+    PSG_LEN(QUARTER), PSG_NOTE(A, 4), PSG_LEN(EIGHTH), PSG_NOTE(C, 5), PSG_NOTE(E, 5),
+    PSG_LEN(QUARTER), PSG_NOTE(G, 5), PSG_LEN(EIGHTH), PSG_NOTE(E, 5), PSG_NOTE(C, 5),
+    PSG_LEN(QUARTER), PSG_NOTE(E, 5), PSG_LEN(EIGHTH), PSG_NOTE(G, 5), PSG_NOTE(C, 6),
+    PSG_LEN(QUARTER + EIGHTH), PSG_NOTE(B, 5), PSG_LEN(EIGHTH), PSG_NOTE(A, 5),
+    PSG_LEN(QUARTER), PSG_NOTE(G, 5), PSG_REST,
+    PSG_END,
+};
+
+static const u8 PAD[] = {
+    PSG_INS(INS_PAD), PSG_LEN(HALF),
+    PSG_NOTE(C, 5), PSG_NOTE(E, 5),
+    PSG_NOTE(A, 4), PSG_NOTE(C, 5),
+    PSG_NOTE(G, 4), PSG_NOTE(E, 4),
+    PSG_NOTE(B, 4), PSG_NOTE(D, 5),
+    PSG_END,
+};
+
+static const u8 BASS[] = {
+    PSG_INS(INS_BASS), PSG_LEN(QUARTER),
+    PSG_NOTE(A, 2), PSG_NOTE(A, 2), PSG_NOTE(A, 3), PSG_NOTE(A, 2),
+    PSG_NOTE(F, 2), PSG_NOTE(F, 2), PSG_NOTE(F, 3), PSG_NOTE(F, 2),
+    PSG_NOTE(C, 3), PSG_NOTE(C, 3), PSG_NOTE(C, 4), PSG_NOTE(C, 3),
+    PSG_NOTE(G, 2), PSG_NOTE(G, 2), PSG_NOTE(G, 3), PSG_NOTE(G, 2),
+    PSG_END,
+};
+
+// One bar
+static const u8 DRUMS[] = {
+    PSG_LEN(EIGHTH),
+    PSG_INS(INS_KICK), KICK, PSG_INS(INS_HAT), HAT, PSG_INS(INS_SNARE), SNARE, PSG_INS(INS_HAT), HAT,
+    PSG_INS(INS_KICK), KICK, KICK, PSG_INS(INS_SNARE), SNARE, PSG_INS(INS_HAT), HAT,
+    PSG_END,
+};
+
+enum { PAT_LEAD_A, PAT_LEAD_B, PAT_PAD, PAT_BASS, PAT_DRUMS };
+
+static const u8 *const MENU_PATTERNS[] = {
+    [PAT_LEAD_A] = LEAD_A,
+    [PAT_LEAD_B] = LEAD_B,
+    [PAT_PAD]    = PAD,
+    [PAT_BASS]   = BASS,
+    [PAT_DRUMS]  = DRUMS,
+};
+
+static const u8 ORDER_LEAD[]  = { PAT_LEAD_A, PAT_LEAD_B, PSG_ORDER_LOOP };
+static const u8 ORDER_PAD[]   = { PAT_PAD, PSG_ORDER_LOOP };
+static const u8 ORDER_BASS[]  = { PAT_BASS, PSG_ORDER_LOOP };
+static const u8 ORDER_DRUMS[] = { PAT_DRUMS, PSG_ORDER_LOOP };
+
+const PsgSong SONG_MENU = {
+    TICK_COUNTS_50HZ,
+    MENU_INSTRUMENTS,
+    MENU_PATTERNS,
+    { ORDER_LEAD, ORDER_PAD, ORDER_BASS, ORDER_DRUMS },
+};
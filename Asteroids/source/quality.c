@@ -0,0 +1,64 @@
+#include "quality.h"
+#include "perf.h"
+
+// Thresholds follow the frame budget, the lines left before VBlank
+// (perfBudgetLines(): ~103 in Mode 3, where the present DMA takes the rest
+// of the refresh). Step down after DEGRADE_FRAMES consecutive frames within
+// DEGRADE_MARGIN lines of it, before frames start missing VBlank...
+#define DEGRADE_MARGIN  4
+#define DEGRADE_FRAMES  3
+// ...and back up only after a long calm stretch a quarter under it.
+#define RECOVER_FRAMES  120
+
+static const u8 QUALITY_FEATURES[QUALITY_LEVELS] = {
+    // QUALITY_HIGH
+    QFX_BULLET_CYCLE | QFX_THRUSTER_FLARE | QFX_RAINBOW_CYCLE |
+    QFX_MENU_SHAPES | QFX_FULL_OUTLINES | QFX_HUD_EVERY_FRAME,
+    // QUALITY_MEDIUM
+    QFX_MENU_SHAPES | QFX_FULL_OUTLINES | QFX_HUD_EVERY_FRAME,
+    // QUALITY_LOW
+    QFX_HUD_EVERY_FRAME,
+    // QUALITY_MINIMAL
+    0,
+};
+
+static int s_level = QUALITY_HIGH;
+static int s_overFrames = 0;
+static int s_underFrames = 0;
+
+void qualityUpdate(int frameLines) {
+    int budget = perfBudgetLines();
+    if (frameLines > budget - DEGRADE_MARGIN) {
+        s_underFrames = 0;
+        if (++s_overFrames >= DEGRADE_FRAMES) {
+            if (s_level < QUALITY_LEVELS - 1) s_level++;
+            s_overFrames = 0;
+        }
+    } else if (frameLines < budget - (budget >> 2)) {
+        s_overFrames = 0;
+        if (++s_underFrames >= RECOVER_FRAMES) {
+            if (s_level > QUALITY_HIGH) s_level--;
+            s_underFrames = 0;
+        }
+    } else {
+        // Inside the hysteresis band: hold the current level
+        s_overFrames = 0;
+        s_underFrames = 0;
+    }
+}
+
+int qualityLevel(void) {
+    return s_level;
+}
+
+bool qualityEnabled(int feature) {
+    return (QUALITY_FEATURES[s_level] & feature) != 0;
+}
+
+void qualitySetLevel(int level) {
+    if (level < QUALITY_HIGH) level = QUALITY_HIGH;
+    if (level >= QUALITY_LEVELS) level = QUALITY_LEVELS - 1;
+    s_level = level;
+    s_overFrames = 0;
+    s_underFrames = 0;
+}
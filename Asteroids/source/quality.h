@@ -0,0 +1,34 @@
+#ifndef QUALITY_H
+#define QUALITY_H
+
+#include <gba_types.h>
+#include <stdbool.h>
+
+// --- Dynamic Quality Levels ---
+// When frames run long the governor steps down through these levels,
+// dropping purely cosmetic work first; it steps back up (with hysteresis)
+// once the load has stayed low for a while.
+#define QUALITY_HIGH    0   // Everything on
+#define QUALITY_MEDIUM  1   // No color cycling, no thruster flare
+#define QUALITY_LOW     2   // + half-density asteroid outlines, no menu shapes
+#define QUALITY_MINIMAL 3   // + scoreboard text re-rendered every other frame
+#define QUALITY_LEVELS  4
+
+// Cosmetic features gated by the current level
+#define QFX_BULLET_CYCLE    (1 << 0) // Bullet color cycling (Mode 3; Mode 4 cycles the palette for free)
+#define QFX_THRUSTER_FLARE  (1 << 1) // Engine flare behind the ship
+#define QFX_RAINBOW_CYCLE   (1 << 2) // Respawn ring / game-over circle color cycling (Mode 3 likewise)
+#define QFX_MENU_SHAPES     (1 << 3) // Floating polygons on the main menu
+#define QFX_FULL_OUTLINES   (1 << 4) // Full-density asteroid outlines
+#define QFX_HUD_EVERY_FRAME (1 << 5) // Scoreboard redrawn every frame (off: copied from a cache)
+
+// Feed the measured cost of the last frame (in scanlines), once per frame
+void qualityUpdate(int frameLines);
+
+int qualityLevel(void);
+bool qualityEnabled(int feature);
+
+// Forces a level (e.g. for benchmarking); the governor keeps adapting from there
+void qualitySetLevel(int level);
+
+#endif // QUALITY_H
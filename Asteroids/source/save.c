@@ -1,5 +1,9 @@
 #include "save.h"
+#include "crc32.h"
 #include "game_objects.h"
+#include "serialize.h"
+#include <gba_base.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -7,73 +11,205 @@
 // expose 8- or 16-bit windows. Address is the standard GBA SRAM base.
 #define SRAM_BASE ((volatile uint8_t*)0x0E000000)
 
-// Offsets (in bytes)
-#define OFF_MAGIC   0
-#define OFF_HIGHSCO 4
-#define OFF_GAMESTATE_MAGIC 8
-#define OFF_GAMESTATE_DATA  12
+// --- Journaled Records ---
+// The high score and the saved game are each a journal of two slots. A
+// save goes to the slot not holding the newest record: payload first, then
+// the header as the single final write. Every header carries a sequence
+// number and a CRC32 over its fields and the payload, so a save cut off
+// by power loss only spoils the slot it was writing, and loading picks the
+// newest slot that checks out.
+//
+// Slot header (little-endian): magic, sequence, payload length (u16),
+// payload version (u16), CRC32. The magic goes last.
+#define SLOT_MAGIC          0x56415341u // "ASAV"
+#define SLOT_HEADER_BYTES   16
+#define HDR_MAGIC           0
+#define HDR_SEQUENCE        4
+#define HDR_LENGTH          8
+#define HDR_VERSION         10
+#define HDR_CRC             12
 
-// Magic values
-#define SAVE_MAGIC 0xA5A5A5A5u
-#define GAMESTATE_MAGIC 0x47414D45u  // "GAME" in hex
+typedef struct {
+    uint32_t base;      // SRAM offset of slot 0; slot 1 follows it
+    uint32_t capacity;  // Payload bytes per slot
+    // Found by the last load or save, so a save needn't scan the slots
+    bool scanned;
+    int newest;         // Slot of the newest intact record, -1 if none
+    uint32_t sequence;  // Its sequence number
+} Journal;
+
+// Payload versions. Game states: 1 = a 32-bit word per field, 2 = the
+// bit-packed schemas below. Loading reads every version up to the current
+// one; saving writes only the current one.
+#define HIGHSCORE_VERSION   1
+#define GAMESTATE_VERSION   2
+
+#define HIGHSCORE_BYTES     4
+
+static Journal HIGHSCORE_JOURNAL = { 0x0000, 16, false, -1, 0 };
+static Journal GAMESTATE_JOURNAL = { 0x0100, 1024, false, -1, 0 };
+
+// Before the journals: magic and high score at offset 0
+#define LEGACY_MAGIC    0xA5A5A5A5u
+#define LEGACY_HIGHSCO  4
 
 static int highScore = 0;
 static volatile int last_save_ok = 0;
 static volatile int highscore_dirty = 0;
 
-// Helper: write a 32-bit value little-endian to SRAM at byte offset
-static void sram_write_u32(uint32_t offset, uint32_t value) {
+// Payloads are assembled and checked in RAM
+static uint8_t record[1024] EWRAM_BSS;
+
+static void sram_write(uint32_t offset, const uint8_t *data, uint32_t bytes) {
     volatile uint8_t *p = SRAM_BASE + offset;
-    p[0] = (uint8_t)(value & 0xFF);
-    p[1] = (uint8_t)((value >> 8) & 0xFF);
-    p[2] = (uint8_t)((value >> 16) & 0xFF);
-    p[3] = (uint8_t)((value >> 24) & 0xFF);
+    for (uint32_t i = 0; i < bytes; i++) p[i] = data[i];
 }
 
-// Helper: read a 32-bit little-endian value from SRAM at byte offset
-static uint32_t sram_read_u32(uint32_t offset) {
+static void sram_read(uint32_t offset, uint8_t *data, uint32_t bytes) {
     volatile uint8_t *p = SRAM_BASE + offset;
-    return (uint32_t)p[0]
-         | ((uint32_t)p[1] << 8)
-         | ((uint32_t)p[2] << 16)
-         | ((uint32_t)p[3] << 24);
+    for (uint32_t i = 0; i < bytes; i++) data[i] = p[i];
 }
 
-void loadHighScore(void) {
-    uint32_t magic = sram_read_u32(OFF_MAGIC);
-    if (magic == SAVE_MAGIC) {
-        int loaded = (int)sram_read_u32(OFF_HIGHSCO);
-        if (loaded < 0 || loaded > 1000000) {
-            highScore = 0;
-        } else {
-            highScore = loaded;
-        }
-    } else {
-        highScore = 0;
+// Helpers: 16- and 32-bit little-endian values in a byte buffer
+static void put_u16(uint8_t *p, uint16_t value) {
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+}
+
+static void put_u32(uint8_t *p, uint32_t value) {
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+}
+
+static uint16_t get_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint32_t slot_offset(const Journal *j, int slot) {
+    return j->base + slot * (SLOT_HEADER_BYTES + j->capacity);
+}
+
+// CRC over the header fields after the magic (sequence, length, version)
+// and the payload
+static uint32_t record_crc(const uint8_t *header, const uint8_t *payload, uint32_t length) {
+    uint32_t crc = crc32Update(CRC32_INIT, header + HDR_SEQUENCE, HDR_CRC - HDR_SEQUENCE);
+    return crc32Final(crc32Update(crc, payload, length));
+}
+
+// Reads a slot's header; returns false unless it has the magic and a
+// length that fits
+static bool slot_header(const Journal *j, int slot, uint8_t *header) {
+    sram_read(slot_offset(j, slot), header, SLOT_HEADER_BYTES);
+    return get_u32(header + HDR_MAGIC) == SLOT_MAGIC && get_u16(header + HDR_LENGTH) <= j->capacity;
+}
+
+// Reads the payload under 'header' into 'payload'; returns false unless it
+// matches the CRC
+static bool slot_payload(const Journal *j, int slot, const uint8_t *header, uint8_t *payload) {
+    uint32_t bytes = get_u16(header + HDR_LENGTH);
+    sram_read(slot_offset(j, slot) + SLOT_HEADER_BYTES, payload, bytes);
+    return record_crc(header, payload, bytes) == get_u32(header + HDR_CRC);
+}
+
+// Loads the newest intact record into 'payload' (capacity bytes); returns
+// the slot, or -1 if neither holds one. Only the newer header's payload is
+// read unless it fails its CRC.
+static int journal_load(Journal *j, uint8_t *payload, uint32_t *length, int *version) {
+    uint8_t headers[2][SLOT_HEADER_BYTES];
+    bool present[2];
+    for (int slot = 0; slot < 2; slot++) present[slot] = slot_header(j, slot, headers[slot]);
+
+    // Wrap-safe: the later of two sequence numbers goes first
+    int first = 0;
+    if (present[0] && present[1]) {
+        uint32_t seq0 = get_u32(headers[0] + HDR_SEQUENCE);
+        uint32_t seq1 = get_u32(headers[1] + HDR_SEQUENCE);
+        if ((int32_t)(seq1 - seq0) > 0) first = 1;
+    } else if (present[1]) {
+        first = 1;
+    }
+
+    j->scanned = true;
+    j->newest = -1;
+    for (int i = 0; i < 2; i++) {
+        int slot = first ^ i;
+        if (!present[slot] || !slot_payload(j, slot, headers[slot], payload)) continue;
+        j->newest = slot;
+        j->sequence = get_u32(headers[slot] + HDR_SEQUENCE);
+        *length = get_u16(headers[slot] + HDR_LENGTH);
+        *version = get_u16(headers[slot] + HDR_VERSION);
+        break;
     }
+    return j->newest;
 }
 
-void saveHighScore(void) {
-    // Write magic and high score as byte sequences to improve compatibility
-    sram_write_u32(OFF_MAGIC, SAVE_MAGIC);
-    sram_write_u32(OFF_HIGHSCO, (uint32_t)highScore);
+// Writes 'payload' to the slot after the newest one and checks it back
+static bool journal_save(Journal *j, const uint8_t *payload, uint32_t length, int version) {
+    static uint8_t scratch[1024] EWRAM_BSS;
+    if (!j->scanned) {
+        uint32_t oldLength;
+        int oldVersion;
+        journal_load(j, scratch, &oldLength, &oldVersion);
+    }
+    int slot = (j->newest == 0) ? 1 : 0;
+    uint32_t sequence = (j->newest < 0) ? 1 : j->sequence + 1;
 
-    // Slightly longer delay for slower emulators/hardware to settle
-    for (volatile int i = 0; i < 10000; i++) { __asm__("nop"); }
+    uint8_t header[SLOT_HEADER_BYTES];
+    put_u32(header + HDR_MAGIC, SLOT_MAGIC);
+    put_u32(header + HDR_SEQUENCE, sequence);
+    put_u16(header + HDR_LENGTH, (uint16_t)length);
+    put_u16(header + HDR_VERSION, (uint16_t)version);
+    put_u32(header + HDR_CRC, record_crc(header, payload, length));
 
-    // Read back and verify
-    uint32_t magic = sram_read_u32(OFF_MAGIC);
-    uint32_t hs = sram_read_u32(OFF_HIGHSCO);
+    uint32_t offset = slot_offset(j, slot);
+    sram_write(offset + SLOT_HEADER_BYTES, payload, length);
+    sram_write(offset + HDR_SEQUENCE, header + HDR_SEQUENCE, SLOT_HEADER_BYTES - HDR_SEQUENCE);
+    sram_write(offset + HDR_MAGIC, header + HDR_MAGIC, 4);
 
-    if (magic != SAVE_MAGIC || (int)hs != highScore) {
-        // Clear area to avoid later confusion
-        sram_write_u32(OFF_MAGIC, 0);
-        sram_write_u32(OFF_HIGHSCO, 0);
-        last_save_ok = 0;
-        // leave dirty flag so we can try again later
+    // The one read-back: the whole slot as a load would see it. On a
+    // mismatch the previous record stays the newest.
+    uint8_t written[SLOT_HEADER_BYTES];
+    if (!slot_header(j, slot, written) || memcmp(written, header, SLOT_HEADER_BYTES) != 0 ||
+        !slot_payload(j, slot, written, scratch) || memcmp(scratch, payload, length) != 0) {
+        return false;
+    }
+    j->newest = slot;
+    j->sequence = sequence;
+    return true;
+}
+
+void loadHighScore(void) {
+    uint32_t length;
+    int version;
+    highScore = 0;
+    if (journal_load(&HIGHSCORE_JOURNAL, record, &length, &version) >= 0) {
+        if (version == HIGHSCORE_VERSION && length >= HIGHSCORE_BYTES) {
+            highScore = (int)get_u32(record);
+        }
     } else {
+        // No journal yet: a high score saved by an older build
+        uint8_t legacy[8];
+        sram_read(0, legacy, sizeof(legacy));
+        if (get_u32(legacy) == LEGACY_MAGIC) highScore = (int)get_u32(legacy + LEGACY_HIGHSCO);
+    }
+    if (highScore < 0 || highScore > 1000000) highScore = 0;
+}
+
+void saveHighScore(void) {
+    uint8_t payload[HIGHSCORE_BYTES];
+    put_u32(payload, (uint32_t)highScore);
+    if (journal_save(&HIGHSCORE_JOURNAL, payload, HIGHSCORE_BYTES, HIGHSCORE_VERSION)) {
         last_save_ok = 1;
         highscore_dirty = 0;
+    } else {
+        last_save_ok = 0;
+        // leave dirty flag so we can try again later
     }
 }
 
@@ -95,166 +231,190 @@ int wasLastSaveOK(void) {
     return last_save_ok;
 }
 
+
+// --- Game State Schemas (version 2) ---
+// Score and lives, the ship, then an alive bitmap of the asteroid slots and
+// one of the bullet slots; only live objects get a record. Positions keep
+// their full 16.8 precision over the wrap margins; asteroid velocities are
+// whole pixels and sizes multiples of 4, so both are stored without the
+// bits that are always zero. A full table is about 250 bytes against 808
+// in version 1.
+typedef struct {
+    int score;
+    int lives;
+} SavedTotals;
+
+static const SchemaField TOTALS_FIELDS[] = {
+    SCHEMA_UINT(SavedTotals, score, 24),
+    SCHEMA_UINT(SavedTotals, lives, 4),
+};
+
+static const SchemaField SHIP_FIELDS[] = {
+    SCHEMA_FX8(GameObject, x, 9, 8),
+    SCHEMA_FX8(GameObject, y, 9, 8),
+    SCHEMA_FX8(GameObject, velocityX, 4, 8),    // PLAYER_MAX_VELOCITY
+    SCHEMA_FX8(GameObject, velocityY, 4, 8),
+    SCHEMA_UINT(GameObject, angle, 9),          // Degrees
+    SCHEMA_UINT(GameObject, isAlive, 1),
+};
+
+static const SchemaField ASTEROID_FIELDS[] = {
+    SCHEMA_FX8(Asteroid, obj.x, 9, 8),
+    SCHEMA_FX8(Asteroid, obj.y, 9, 8),
+    SCHEMA_FX8(Asteroid, obj.velocityX, 5, 0),
+    SCHEMA_FX8(Asteroid, obj.velocityY, 5, 0),
+    SCHEMA_FIELD(Asteroid, sizeType, 3, 2, 0),  // ASTEROID_SIZE_* / 4
+};
+
+static const SchemaField BULLET_FIELDS[] = {
+    SCHEMA_FX8(GameObject, x, 9, 8),
+    SCHEMA_FX8(GameObject, y, 9, 8),
+    SCHEMA_FX8(GameObject, velocityX, 3, 8),    // BULLET_SPEED
+    SCHEMA_FX8(GameObject, velocityY, 3, 8),
+};
+
+static const Schema TOTALS_SCHEMA = SCHEMA(TOTALS_FIELDS);
+static const Schema SHIP_SCHEMA = SCHEMA(SHIP_FIELDS);
+static const Schema ASTEROID_SCHEMA = SCHEMA(ASTEROID_FIELDS);
+static const Schema BULLET_SCHEMA = SCHEMA(BULLET_FIELDS);
+
 // Check if a saved game exists
 int hasSavedGame(void) {
-    uint32_t magic = sram_read_u32(OFF_GAMESTATE_MAGIC);
-    return (magic == GAMESTATE_MAGIC) ? 1 : 0;
+    uint32_t length;
+    int version;
+    return journal_load(&GAMESTATE_JOURNAL, record, &length, &version) >= 0 &&
+           version >= 1 && version <= GAMESTATE_VERSION;
 }
 
 // Save complete game state
 void saveGameState(int score, int lives, GameObject *ship, Asteroid asteroids[], GameObject bullets[]) {
-    uint32_t offset = OFF_GAMESTATE_DATA;
-    
-    // Write game state magic
-    sram_write_u32(OFF_GAMESTATE_MAGIC, GAMESTATE_MAGIC);
-    
-    // Write score and lives
-    sram_write_u32(offset, (uint32_t)score);
-    offset += 4;
-    sram_write_u32(offset, (uint32_t)lives);
-    offset += 4;
-    
-    // Write player ship data
-    sram_write_u32(offset, (uint32_t)ship->x);
-    offset += 4;
-    sram_write_u32(offset, (uint32_t)ship->y);
-    offset += 4;
-    sram_write_u32(offset, (uint32_t)ship->velocityX);
-    offset += 4;
-    sram_write_u32(offset, (uint32_t)ship->velocityY);
-    offset += 4;
-    sram_write_u32(offset, (uint32_t)ship->angle);
-    offset += 4;
-    sram_write_u32(offset, (uint32_t)ship->isAlive);
-    offset += 4;
-    
-    // Write asteroids (all MAX_ASTEROIDS slots)
+    BitStream s;
+    SavedTotals totals = { score, lives };
+    bitsBeginWrite(&s, record, sizeof(record));
+
+    schemaWrite(&s, &TOTALS_SCHEMA, &totals);
+    schemaWrite(&s, &SHIP_SCHEMA, ship);
+
+    for (int i = 0; i < MAX_ASTEROIDS; i++) bitsWrite(&s, asteroids[i].obj.isAlive != 0, 1);
+    for (int i = 0; i < MAX_BULLETS; i++) bitsWrite(&s, bullets[i].isAlive != 0, 1);
+
+    for (int i = 0; i < MAX_ASTEROIDS; i++) {
+        if (asteroids[i].obj.isAlive) schemaWrite(&s, &ASTEROID_SCHEMA, &asteroids[i]);
+    }
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        if (bullets[i].isAlive) schemaWrite(&s, &BULLET_SCHEMA, &bullets[i]);
+    }
+
+    last_save_ok = !s.overflow &&
+                   journal_save(&GAMESTATE_JOURNAL, record, bitsBytes(&s), GAMESTATE_VERSION) ? 1 : 0;
+}
+
+static bool load_v2(const uint8_t *data, uint32_t length, int *score, int *lives,
+                    GameObject *ship, Asteroid asteroids[], GameObject bullets[]) {
+    BitStream s;
+    SavedTotals totals;
+    bitsBeginRead(&s, data, length);
+
+    schemaRead(&s, &TOTALS_SCHEMA, &totals);
+    *score = totals.score;
+    *lives = totals.lives;
+    schemaRead(&s, &SHIP_SCHEMA, ship);
+
+    for (int i = 0; i < MAX_ASTEROIDS; i++) asteroids[i].obj.isAlive = (int)bitsRead(&s, 1);
+    for (int i = 0; i < MAX_BULLETS; i++) bullets[i].isAlive = (int)bitsRead(&s, 1);
+
+    for (int i = 0; i < MAX_ASTEROIDS; i++) {
+        if (asteroids[i].obj.isAlive) schemaRead(&s, &ASTEROID_SCHEMA, &asteroids[i]);
+    }
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        if (bullets[i].isAlive) schemaRead(&s, &BULLET_SCHEMA, &bullets[i]);
+    }
+    return !s.overflow;
+}
+
+// Version 1: a 32-bit word per field, dead slots just the isAlive word
+static bool load_v1(const uint8_t *data, uint32_t length, int *score, int *lives,
+                    GameObject *ship, Asteroid asteroids[], GameObject bullets[]) {
+    const uint8_t *p = data;
+    const uint8_t *end = data + length;
+    // Each object record is complete or the save is rejected
+    #define NEXT(dest) do { if (p + 4 > end) return false; (dest) = (int)get_u32(p); p += 4; } while (0)
+
+    NEXT(*score);
+    NEXT(*lives);
+    NEXT(ship->x);
+    NEXT(ship->y);
+    NEXT(ship->velocityX);
+    NEXT(ship->velocityY);
+    NEXT(ship->angle);
+    NEXT(ship->isAlive);
+
     for (int i = 0; i < MAX_ASTEROIDS; i++) {
-        sram_write_u32(offset, (uint32_t)asteroids[i].obj.isAlive);
-        offset += 4;
+        NEXT(asteroids[i].obj.isAlive);
         if (asteroids[i].obj.isAlive) {
-            sram_write_u32(offset, (uint32_t)asteroids[i].obj.x);
-            offset += 4;
-            sram_write_u32(offset, (uint32_t)asteroids[i].obj.y);
-            offset += 4;
-            sram_write_u32(offset, (uint32_t)asteroids[i].obj.velocityX);
-            offset += 4;
-            sram_write_u32(offset, (uint32_t)asteroids[i].obj.velocityY);
-            offset += 4;
-            sram_write_u32(offset, (uint32_t)asteroids[i].sizeType);
-            offset += 4;
+            NEXT(asteroids[i].obj.x);
+            NEXT(asteroids[i].obj.y);
+            NEXT(asteroids[i].obj.velocityX);
+            NEXT(asteroids[i].obj.velocityY);
+            NEXT(asteroids[i].sizeType);
         }
     }
-    
-    // Write bullets (all MAX_BULLETS slots)
+
     for (int i = 0; i < MAX_BULLETS; i++) {
-        sram_write_u32(offset, (uint32_t)bullets[i].isAlive);
-        offset += 4;
+        NEXT(bullets[i].isAlive);
         if (bullets[i].isAlive) {
-            sram_write_u32(offset, (uint32_t)bullets[i].x);
-            offset += 4;
-            sram_write_u32(offset, (uint32_t)bullets[i].y);
-            offset += 4;
-            sram_write_u32(offset, (uint32_t)bullets[i].velocityX);
-            offset += 4;
-            sram_write_u32(offset, (uint32_t)bullets[i].velocityY);
-            offset += 4;
+            NEXT(bullets[i].x);
+            NEXT(bullets[i].y);
+            NEXT(bullets[i].velocityX);
+            NEXT(bullets[i].velocityY);
         }
     }
-    
-    // Delay for write to settle
-    for (volatile int i = 0; i < 10000; i++) { __asm__("nop"); }
-    
-    // Verify the magic was written
-    uint32_t verify = sram_read_u32(OFF_GAMESTATE_MAGIC);
-    last_save_ok = (verify == GAMESTATE_MAGIC) ? 1 : 0;
+    #undef NEXT
+    return true;
 }
 
 // Load complete game state, returns 1 if successful, 0 if no save data
 int loadGameState(int *score, int *lives, GameObject *ship, Asteroid asteroids[], GameObject bullets[]) {
-    uint32_t magic = sram_read_u32(OFF_GAMESTATE_MAGIC);
-    if (magic != GAMESTATE_MAGIC) {
+    uint32_t length;
+    int version;
+    if (journal_load(&GAMESTATE_JOURNAL, record, &length, &version) < 0) {
         return 0;  // No save data
     }
-    
-    uint32_t offset = OFF_GAMESTATE_DATA;
-    
-    // Read score and lives
-    *score = (int)sram_read_u32(offset);
-    offset += 4;
-    *lives = (int)sram_read_u32(offset);
-    offset += 4;
-    
-    // Read player ship data
-    ship->x = (int)sram_read_u32(offset);
-    offset += 4;
-    ship->y = (int)sram_read_u32(offset);
-    offset += 4;
-    ship->velocityX = (int)sram_read_u32(offset);
-    offset += 4;
-    ship->velocityY = (int)sram_read_u32(offset);
-    offset += 4;
-    ship->angle = (int)sram_read_u32(offset);
-    offset += 4;
-    ship->isAlive = (int)sram_read_u32(offset);
-    offset += 4;
-    
+    bool loaded = false;
+    switch (version) {
+    case 1: loaded = load_v1(record, length, score, lives, ship, asteroids, bullets); break;
+    case 2: loaded = load_v2(record, length, score, lives, ship, asteroids, bullets); break;
+    }
+    if (!loaded) return 0;
+
     // Initialize ship fields that aren't saved
     ship->width = 8;  // PLAYER_SIZE
     ship->height = 8;
     ship->prevX = FP_TO_INT(ship->x);
     ship->prevY = FP_TO_INT(ship->y);
     ship->colorIdx = 0;
-    
-    // Read asteroids
+
+    // Initialize asteroid fields that aren't saved
     for (int i = 0; i < MAX_ASTEROIDS; i++) {
-        asteroids[i].obj.isAlive = (int)sram_read_u32(offset);
-        offset += 4;
-        if (asteroids[i].obj.isAlive) {
-            asteroids[i].obj.x = (int)sram_read_u32(offset);
-            offset += 4;
-            asteroids[i].obj.y = (int)sram_read_u32(offset);
-            offset += 4;
-            asteroids[i].obj.velocityX = (int)sram_read_u32(offset);
-            offset += 4;
-            asteroids[i].obj.velocityY = (int)sram_read_u32(offset);
-            offset += 4;
-            asteroids[i].sizeType = (int)sram_read_u32(offset);
-            offset += 4;
-            
-            // Initialize asteroid fields that aren't saved
-            asteroids[i].obj.width = asteroids[i].sizeType;
-            asteroids[i].obj.height = asteroids[i].sizeType;
-            asteroids[i].obj.prevX = FP_TO_INT(asteroids[i].obj.x);
-            asteroids[i].obj.prevY = FP_TO_INT(asteroids[i].obj.y);
-            asteroids[i].obj.angle = 0;
-            asteroids[i].obj.colorIdx = i & 0xFF;
-        }
+        if (!asteroids[i].obj.isAlive) continue;
+        asteroids[i].obj.width = asteroids[i].sizeType;
+        asteroids[i].obj.height = asteroids[i].sizeType;
+        asteroids[i].obj.prevX = FP_TO_INT(asteroids[i].obj.x);
+        asteroids[i].obj.prevY = FP_TO_INT(asteroids[i].obj.y);
+        asteroids[i].obj.angle = 0;
+        asteroids[i].obj.colorIdx = i & 0xFF;
     }
-    
-    // Read bullets
+
+    // Initialize bullet fields that aren't saved
     for (int i = 0; i < MAX_BULLETS; i++) {
-        bullets[i].isAlive = (int)sram_read_u32(offset);
-        offset += 4;
-        if (bullets[i].isAlive) {
-            bullets[i].x = (int)sram_read_u32(offset);
-            offset += 4;
-            bullets[i].y = (int)sram_read_u32(offset);
-            offset += 4;
-            bullets[i].velocityX = (int)sram_read_u32(offset);
-            offset += 4;
-            bullets[i].velocityY = (int)sram_read_u32(offset);
-            offset += 4;
-            
-            // Initialize bullet fields that aren't saved
-            bullets[i].width = 2;  // BULLET_SIZE
-            bullets[i].height = 2;
-            bullets[i].prevX = FP_TO_INT(bullets[i].x);
-            bullets[i].prevY = FP_TO_INT(bullets[i].y);
-            bullets[i].angle = 0;
-            bullets[i].colorIdx = i & 0xFF;
-        }
+        if (!bullets[i].isAlive) continue;
+        bullets[i].width = 2;  // BULLET_SIZE
+        bullets[i].height = 2;
+        bullets[i].prevX = FP_TO_INT(bullets[i].x);
+        bullets[i].prevY = FP_TO_INT(bullets[i].y);
+        bullets[i].angle = 0;
+        bullets[i].colorIdx = fxWrap(i, BULLET_COLOR_COUNT);
     }
-    
+
     return 1;  // Success
 }
@@ -0,0 +1,94 @@
+#include "serialize.h"
+#include <string.h>
+
+// Low 'bits' set, for 1-32 bits
+#define LOW_MASK(bits) (0xFFFFFFFFu >> (32 - (bits)))
+
+void bitsBeginWrite(BitStream *s, u8 *data, u32 bytes) {
+    memset(data, 0, bytes);
+    s->data = data;
+    s->bits = 0;
+    s->capacity = bytes * 8;
+    s->overflow = false;
+}
+
+void bitsBeginRead(BitStream *s, const u8 *data, u32 bytes) {
+    s->data = (u8 *)data;
+    s->bits = 0;
+    s->capacity = bytes * 8;
+    s->overflow = false;
+}
+
+u32 bitsBytes(const BitStream *s) {
+    return (s->bits + 7) >> 3;
+}
+
+void bitsWrite(BitStream *s, u32 value, int bits) {
+    if (s->bits + bits > s->capacity) {
+        s->overflow = true;
+        return;
+    }
+    value &= LOW_MASK(bits);
+    // A byte at a time: what is left of the current byte, then whole bytes
+    while (bits > 0) {
+        int used = s->bits & 7;
+        int n = 8 - used;
+        if (n > bits) n = bits;
+        s->data[s->bits >> 3] |= (u8)(value << used);
+        value >>= n;
+        s->bits += n;
+        bits -= n;
+    }
+}
+
+u32 bitsRead(BitStream *s, int bits) {
+    if (s->bits + bits > s->capacity) {
+        s->overflow = true;
+        return 0;
+    }
+    u32 value = 0;
+    int got = 0;
+    while (got < bits) {
+        int used = s->bits & 7;
+        int n = 8 - used;
+        if (n > bits - got) n = bits - got;
+        value |= (u32)((s->data[s->bits >> 3] >> used) & LOW_MASK(n)) << got;
+        s->bits += n;
+        got += n;
+    }
+    return value;
+}
+
+void schemaWrite(BitStream *s, const Schema *schema, const void *record) {
+    for (int i = 0; i < schema->count; i++) {
+        const SchemaField *f = &schema->fields[i];
+        int value = *(const int *)((const u8 *)record + f->offset) >> f->shift;
+        int lo = 0, hi;
+        if (f->flags & SCHEMA_SIGNED) {
+            lo = -(int)(1u << (f->bits - 1));
+            hi = (int)((1u << (f->bits - 1)) - 1);
+        } else {
+            hi = f->bits >= 31 ? 0x7FFFFFFF : (int)LOW_MASK(f->bits);
+        }
+        if (value < lo) value = lo;
+        else if (value > hi) value = hi;
+        bitsWrite(s, (u32)value, f->bits);
+    }
+}
+
+void schemaRead(BitStream *s, const Schema *schema, void *record) {
+    for (int i = 0; i < schema->count; i++) {
+        const SchemaField *f = &schema->fields[i];
+        u32 value = bitsRead(s, f->bits);
+        // Sign-extend from the stored width
+        if ((f->flags & SCHEMA_SIGNED) && f->bits < 32 && (value >> (f->bits - 1)))
+            value |= ~LOW_MASK(f->bits);
+        *(int *)((u8 *)record + f->offset) = (int)value << f->shift;
+    }
+}
+
+int schemaBits(const Schema *schema) {
+    int bits = 0;
+    for (int i = 0; i < schema->count; i++) bits += schema->fields[i].bits;
+    return bits;
+}
@@ -0,0 +1,57 @@
+#ifndef SERIALIZE_H
+#define SERIALIZE_H
+
+#include <gba_types.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "fixed_math.h"
+
+// --- Bit-Packed Serialization ---
+// A BitStream packs values of 1-32 bits into a byte buffer, least
+// significant bit first, with no padding between them. A Schema lists a
+// struct's int fields with the width each is stored in, so whole records
+// are written and read by table.
+
+typedef struct {
+    u8 *data;
+    u32 bits;       // Position, in bits from the start of 'data'
+    u32 capacity;   // In bits
+    bool overflow;  // Set once a write or read went past 'capacity'
+} BitStream;
+
+// Starts a stream over 'bytes' of 'data'; for writing, 'data' is cleared
+void bitsBeginWrite(BitStream *s, u8 *data, u32 bytes);
+void bitsBeginRead(BitStream *s, const u8 *data, u32 bytes);
+u32 bitsBytes(const BitStream *s); // Bytes touched so far, rounded up
+
+void bitsWrite(BitStream *s, u32 value, int bits); // The low 'bits' of 'value'
+u32 bitsRead(BitStream *s, int bits);              // 0 past the end
+
+#define SCHEMA_SIGNED 1
+
+typedef struct {
+    u16 offset;     // Of the int field in its struct
+    u8 bits;        // Stored width
+    u8 shift;       // Low bits dropped on write: stored = value >> shift
+    u8 flags;       // SCHEMA_*
+} SchemaField;
+
+typedef struct {
+    const SchemaField *fields;
+    int count;
+} Schema;
+
+#define SCHEMA_FIELD(type, member, bits, shift, flags) \
+    { offsetof(type, member), (bits), (shift), (flags) }
+#define SCHEMA_UINT(type, member, bits) SCHEMA_FIELD(type, member, bits, 0, 0)
+// Signed 16.8 fixed point (fx8) kept as Q<intBits>.<fracBits> plus a sign bit
+#define SCHEMA_FX8(type, member, intBits, fracBits) \
+    SCHEMA_FIELD(type, member, 1 + (intBits) + (fracBits), FX8_SHIFT - (fracBits), SCHEMA_SIGNED)
+#define SCHEMA(fields) { (fields), sizeof(fields) / sizeof((fields)[0]) }
+
+// Values out of a field's range are saturated to it
+void schemaWrite(BitStream *s, const Schema *schema, const void *record);
+void schemaRead(BitStream *s, const Schema *schema, void *record);
+int schemaBits(const Schema *schema); // Bits per record
+
+#endif // SERIALIZE_H
@@ -1,135 +1,408 @@
 #include "sound.h"
+#include <gba_base.h>
+#include <gba_interrupt.h>
 #include <gba_sound.h>
+#include <gba_timers.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "adpcm.h"
+#include "explosion_adpcm.h"
+#include "hit_adpcm.h"
+
+// --- PSG Register Shadow ---
+// Effects and music write the PSG registers (0x60-0x7E) here; soundVBlank()
+// copies the changed ones to hardware once per frame, in address order
+// (envelope before restart), and skips values the hardware already has
+// unless they restart the channel. Nothing else writes them: the music
+// timer ticks only update the shadow, so their notes sound from the next
+// VBlank.
+#define PSG_FIRST       0x60
+#define PSG_REGS        16
+#define PSG_SLOT(reg)   (((reg) - PSG_FIRST) >> 1)
+#define RESTART         0x8000
+// Registers whose bit 15 restarts a channel (1-4 frequency/control)
+#define PSG_TRIGGERS    ((1 << PSG_SLOT(0x64)) | (1 << PSG_SLOT(0x6C)) | \
+                         (1 << PSG_SLOT(0x74)) | (1 << PSG_SLOT(0x7C)))
+
+static u16 psgShadow[PSG_REGS];
+static u16 psgHardware[PSG_REGS];
+static u16 psgDirty = 0;
+
+// Called from the game loop and the VBlank handler
+static void psgWrite(u8 reg, u16 value) {
+    u16 ime = REG_IME;
+    REG_IME = 0;
+    int slot = PSG_SLOT(reg);
+    psgShadow[slot] = value;
+    psgDirty |= 1 << slot;
+    REG_IME = ime;
+}
+
+// Called from the VBlank handler only
+static void psgFlush(void) {
+    u16 ime = REG_IME;
+    REG_IME = 0;
+    u16 dirty = psgDirty;
+    for (int slot = 0; dirty; slot++, dirty >>= 1) {
+        if (!(dirty & 1)) continue;
+        u16 value = psgShadow[slot];
+        bool restart = ((PSG_TRIGGERS >> slot) & 1) && (value & RESTART);
+        if (value == psgHardware[slot] && !restart) continue;
+        *(vu16 *)(REG_BASE + PSG_FIRST + slot * 2) = value;
+        psgHardware[slot] = value;
+    }
+    psgDirty = 0;
+    REG_IME = ime;
+}
+
+// --- Sound Effect Sequencer ---
+// An effect is a table of PSG register writes, each followed by a wait in
+// frames, played on one of the four PSG channels (its voice). The VBlank
+// handler advances the steps, so multi-part effects never hold up the game
+// loop. The last wait keeps the voice busy while the sound decays.
+
+// Registers, as offsets from REG_BASE
+#define SFX_END     0x00    // Ends an effect and frees its voice
+#define SFX_SUSTAIN 0x01    // Holds the voice until stopEffect()
+#define SND1CNT_L   0x60    // Channel 1 sweep
+#define SND1CNT_H   0x62    // Channel 1 duty, length, envelope
+#define SND1CNT_X   0x64    // Channel 1 frequency, restart
+#define SND2CNT_L   0x68    // Channel 2 duty, length, envelope
+#define SND2CNT_H   0x6C    // Channel 2 frequency, restart
+
+typedef struct {
+    u8 reg;
+    u8 wait;    // Frames before the next step; 0 runs it at once
+    u16 value;
+} SfxStep;
+
+// Laser-like sweep on channel 1
+static const SfxStep STEPS_SHOOT[] = {
+    { SND1CNT_L, 0, 0x0077 }, // Fast downward sweep
+    { SND1CNT_H, 0, 0xF140 }, // Full volume, very short decay
+    { SND1CNT_X, 4, 0x87C0 }, // High frequency, restart
+    { SFX_END, 0, 0 },
+};
+
+// Mid-tone beep on channel 1
+static const SfxStep STEPS_MENU_SELECT[] = {
+    { SND1CNT_L, 0, 0x0000 }, // No sweep
+    { SND1CNT_H, 0, 0x8300 }, // Duty 50%, short
+    { SND1CNT_X, 4, 0x8400 }, // Frequency ~800Hz, restart
+    { SFX_END, 0, 0 },
+};
+
+// Continuous low tone on channel 2, until stopThrusterSound()
+static const SfxStep STEPS_THRUSTER[] = {
+    { SND2CNT_L, 0, 0x6800 }, // Duty 50%, initial volume 0x6 (medium), no envelope change
+    { SND2CNT_H, 0, 0x8100 }, // Frequency ~100Hz, restart
+    { SFX_SUSTAIN, 0, 0 },
+};
+
+// Rapid low-to-high sweep repeated 3 times on channel 1
+#define SIREN_SWEEP(wait) \
+    { SND1CNT_L, 0, 0x0068 }, /* Medium speed upward sweep */ \
+    { SND1CNT_H, 0, 0xF120 }, /* Duty 25%, medium envelope decay */ \
+    { SND1CNT_X, wait, 0x8300 } /* ~400Hz start, restart */
+static const SfxStep STEPS_SIREN[] = {
+    SIREN_SWEEP(12), SIREN_SWEEP(12), SIREN_SWEEP(12),
+    { SFX_END, 0, 0 },
+};
+
+// --- Voices ---
+// One voice per PSG channel. An effect may take any channel in its mask
+// (only channel 1 has the sweep unit); when all of them are busy it
+// preempts the lowest-priority one of equal or lower priority, or is
+// dropped. A second trigger of an effect in the same frame is ignored.
+#define CH1 (1 << 0)
+#define CH2 (1 << 1)
+#define CH3 (1 << 2)
+#define CH4 (1 << 3)
+#define VOICE_COUNT 4
+
+enum { SFX_SHOOT, SFX_MENU_SELECT, SFX_THRUSTER, SFX_SIREN, SFX_COUNT, SFX_NONE = 0xFF };
+
+typedef struct {
+    const SfxStep *steps;
+    u8 channels;
+    u8 priority; // Higher preempts lower
+} SfxEffect;
+
+static const SfxEffect EFFECTS[SFX_COUNT] = {
+    [SFX_SHOOT]       = { STEPS_SHOOT,       CH1, 1 },
+    [SFX_MENU_SELECT] = { STEPS_MENU_SELECT, CH1, 1 },
+    [SFX_THRUSTER]    = { STEPS_THRUSTER,    CH2, 2 },
+    [SFX_SIREN]       = { STEPS_SIREN,       CH1, 3 },
+};
+
+typedef struct {
+    const SfxStep *next; // Step to run when wait expires
+    u8 wait;
+    u8 effect;           // SFX_NONE when free
+} Voice;
+
+static Voice voices[VOICE_COUNT] = {
+    { NULL, 0, SFX_NONE }, { NULL, 0, SFX_NONE }, { NULL, 0, SFX_NONE }, { NULL, 0, SFX_NONE },
+};
+static u16 sfxTriggered = 0; // Effects started since the last VBlank, one bit each
+
+// Volume/envelope and frequency/control register of each channel: zero in
+// both silences it without a restart
+static const u8 VOICE_REGS[VOICE_COUNT][2] = {
+    { SND1CNT_H, SND1CNT_X }, { SND2CNT_L, SND2CNT_H }, { 0x72, 0x74 }, { 0x78, 0x7C },
+};
+
+// Writes steps until one waits; frees the voice at the end
+static void runSteps(Voice *v) {
+    const SfxStep *step = v->next;
+    for (; step->reg != SFX_END; step++) {
+        if (step->reg == SFX_SUSTAIN) {
+            v->next = step;
+            return;
+        }
+        psgWrite(step->reg, step->value);
+        if (step->wait) {
+            v->wait = step->wait;
+            v->next = step + 1;
+            return;
+        }
+    }
+    v->next = NULL;
+    v->effect = SFX_NONE;
+}
+
+static void startEffect(int effect) {
+    const SfxEffect *e = &EFFECTS[effect];
+    // The VBlank handler advances the voices
+    u16 ime = REG_IME;
+    REG_IME = 0;
+    bool again = sfxTriggered & (1 << effect);
+    sfxTriggered |= 1 << effect;
+
+    int pick = -1;
+    for (int ch = 0; ch < VOICE_COUNT && !again; ch++) {
+        if (!(e->channels & (1 << ch))) continue;
+        if (voices[ch].effect == SFX_NONE) {
+            pick = ch;
+            break;
+        }
+        if (EFFECTS[voices[ch].effect].priority <= e->priority &&
+            (pick < 0 || EFFECTS[voices[ch].effect].priority < EFFECTS[voices[pick].effect].priority)) {
+            pick = ch;
+        }
+    }
+    if (pick >= 0) {
+        Voice *v = &voices[pick];
+        v->effect = effect;
+        v->next = e->steps;
+        runSteps(v);
+    }
+    REG_IME = ime;
+}
+
+static void stopEffect(int effect) {
+    u16 ime = REG_IME;
+    REG_IME = 0;
+    for (int ch = 0; ch < VOICE_COUNT; ch++) {
+        if (voices[ch].effect != effect) continue;
+        voices[ch].effect = SFX_NONE;
+        voices[ch].next = NULL;
+        psgWrite(VOICE_REGS[ch][0], 0x0000);
+        psgWrite(VOICE_REGS[ch][1], 0x0000);
+    }
+    REG_IME = ime;
+}
+
+static void updateSoundEffects(void) {
+    for (int ch = 0; ch < VOICE_COUNT; ch++) {
+        Voice *v = &voices[ch];
+        if (!v->next || v->next->reg == SFX_SUSTAIN || --v->wait) continue;
+        runSteps(v);
+    }
+}
+
+// Mixer volumes (0-64) of the sampled effects
+#define EXPLOSION_VOLUME    48
+#define HIT_VOLUME          64
 
-// Play shooting sound (laser-like sweep on channel 1)
 void playShootSound(void) {
-    REG_SOUND1CNT_L = 0x0077; // Fast downward sweep
-    REG_SOUND1CNT_H = 0xF140; // Full volume, very short decay
-    REG_SOUND1CNT_X = 0x87C0; // High frequency, restart
+    startEffect(SFX_SHOOT);
 }
 
-// Play explosion sound (downward sweep on channel 1)
+// Sampled (sfx/explosion.wav), on the DirectSound mixer
 void playExplosionSound(void) {
-    REG_SOUND1CNT_L = 0x0078; // Fast upward sweep (reversed)
-    REG_SOUND1CNT_H = 0xF110; // Duty 25%, very quick decay
-    REG_SOUND1CNT_X = 0x8600; // Higher starting frequency, restart
+    adpcmPlay(explosion_adpcm, EXPLOSION_VOLUME);
 }
 
-// Play menu selection sound (mid-tone beep on channel 1)
 void playMenuSelectSound(void) {
-    REG_SOUND1CNT_L = 0x0000; // No sweep
-    REG_SOUND1CNT_H = 0x8300; // Duty 50%, short
-    REG_SOUND1CNT_X = 0x8400; // Frequency ~800Hz, restart
+    startEffect(SFX_MENU_SELECT);
 }
 
-// Play thruster sound (continuous low tone on channel 2)
 void playThrusterSound(void) {
-    REG_SOUND2CNT_L = 0x6800; // Duty 50%, initial volume 0x6 (medium), no envelope change
-    REG_SOUND2CNT_H = 0x8100; // Frequency ~100Hz, restart
+    startEffect(SFX_THRUSTER);
 }
 
-// Stop thruster sound
 void stopThrusterSound(void) {
-    // Stop channel 2 by setting volume to 0
-    REG_SOUND2CNT_L = 0x0000;
-    REG_SOUND2CNT_H = 0x0000;
+    stopEffect(SFX_THRUSTER);
 }
 
-// Play siren sound (rapid low-to-high sweep repeated 3 times on channel 1)
 void playSirenSound(void) {
-    REG_SOUND1CNT_L = 0x0068; // Medium speed upward sweep, repeated 3 times
-    REG_SOUND1CNT_H = 0xF120; // Duty 25%, medium envelope decay
-    REG_SOUND1CNT_X = 0x8300; // Mid-range starting frequency ~400Hz, restart
+    startEffect(SFX_SIREN);
 }
 
-// Play player hit sound (high-pitched downward sweep repeated 3 times on channel 1)
+// Sampled (sfx/hit.wav); the hit also cuts the thruster
 void playPlayerHitSound(void) {
-    // Stop thruster sound immediately when player gets hit
     stopThrusterSound();
-    
-    // Play the sound 3 times in rapid succession
-    for (int i = 0; i < 3; i++) {
-        REG_SOUND1CNT_L = 0x0077; // Fast downward sweep
-        REG_SOUND1CNT_H = 0xF108; // Full volume, extremely quick decay
-        REG_SOUND1CNT_X = 0x8780; // Very high starting frequency, restart
-        
-        // Longer delay between repetitions to make them distinct
-        for (volatile int d = 0; d < 100000; d++);
-    }
+    adpcmPlay(hit_adpcm, HIT_VOLUME);
 }
 
-// Background Music System using Channel 2
-static volatile int musicTick = 0;
-static volatile int noteIndex = 0;
-static volatile int frameCounter = 0;  // Track actual frames for consistent timing
-static volatile int musicComplete = 0; // Flag to track if melody has finished playing
-
-// Mario theme - using correct formula: 2048 - (131072 / Hz)
-// CONFIRMED: Higher hex = higher pitch
-// E4=0x0673, F4=0x0688, C5=0x0705, D5=0x0721, E5=0x0739, F5=0x074D, G4=0x06B2, G5=0x0759, A4=0x06D6, B4=0x06F7, C6=0x0778
-static const u16 melodyNotes[] = {
-    // Opening: E5 E5 _ E5 _ C5 E5 _ G5 _ _ _ G4 _ _ _
-    0x0739, 0x0739, 0x0000, 0x0739, 0x0000, 0x0705, 0x0739, 0x0000,  // E E _ E _ C E _
-    0x0759, 0x0000, 0x0000, 0x0000,                                  // G5 _ _ _
-    0x06B2, 0x0000, 0x0000, 0x0000,                                  // G4 _ _ _
+// --- Music Sequencer ---
+// Plays a PsgSong (psg_music.h) on all four channels from the timer 1
+// interrupt, so the tempo never depends on the frame rate. A channel an
+// effect holds stays with the effect; the song picks it up again at its
+// next note there.
+#define MUSIC_TIMER_DIV_256 0x0002  // Timer 1 prescaler: 65536 counts a second
+#define SND3CNT_L           0x70    // Channel 3 wave RAM bank, enable
+#define WAVE_PLAY           0x0080  // Plays bank 0 (the CPU then sees bank 1)
+#define WAVE_WRITE_BANK0    0x0040  // Plays bank 1, so bank 0 is writable
+
+// Frequency register values (2048 - 131072 / Hz) of C2-B7
+static const u16 NOTE_RATES[72] = {
+    44, 157, 263, 363, 457, 547, 631, 711, 786, 856, 923, 986,
+    1046, 1102, 1155, 1205, 1253, 1297, 1339, 1379, 1417, 1452, 1486, 1517,
+    1547, 1575, 1602, 1627, 1650, 1673, 1694, 1714, 1732, 1750, 1767, 1783,
+    1798, 1812, 1825, 1837, 1849, 1860, 1871, 1881, 1890, 1899, 1907, 1915,
+    1923, 1930, 1936, 1943, 1949, 1954, 1959, 1964, 1969, 1974, 1978, 1982,
+    1985, 1989, 1992, 1995, 1998, 2001, 2004, 2006, 2009, 2011, 2013, 2015,
 };
-#define MELODY_LENGTH 16
-#define NOTE_DURATION 2 // Frames per note/rest
-
-void initProceduralMusic(void) {
-    musicTick = 0;
-    noteIndex = 0;
-    frameCounter = 0;
-    musicComplete = 0; // Reset the completion flag
-    
-    // Start first note on channel 2 with better tone
-    if (melodyNotes[0] != 0x0000) {
-        REG_SOUND2CNT_L = 0x3780; // Duty 25%, volume 0x3, no envelope
-        REG_SOUND2CNT_H = 0x8000 | (melodyNotes[0] & 0x07FF); // Start with first note, mask to 11 bits
-    }
+#define NOTE_COUNT 72
+
+// Channel 3's triangle wave, 32 4-bit samples. The wave channel plays a
+// period of it per 'rate' step, an octave below the square channels, so its
+// notes are looked up an octave higher.
+static const u32 BASS_WAVE[4] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476 };
+#define WAVE_OCTAVE 12
+
+typedef struct {
+    const u8 *pos;      // Next pattern byte
+    u8 order;           // Index in the channel's order list
+    u8 wait;            // Ticks until the next event
+    u8 length;          // Ticks per note or rest
+    u8 instrument;
+} MusicChannel;
+
+static const PsgSong *musicSong = NULL;
+static MusicChannel musicChannels[PSG_CHANNELS];
+
+static void musicWrite(int ch, u8 reg, u16 value) {
+    if (voices[ch].effect == SFX_NONE) psgWrite(reg, value);
 }
 
-void updateProceduralMusic(void) {
-    // Don't update music if it's already complete
-    if (musicComplete) {
-        return;
+static void musicNote(int ch, int note, const PsgInstrument *ins) {
+    u16 rate;
+    if (ch == 3) {
+        rate = note; // Noise: the frequency register's bits
+    } else {
+        if (ch == 2) note += WAVE_OCTAVE;
+        if (note >= NOTE_COUNT) note = NOTE_COUNT - 1;
+        rate = NOTE_RATES[note];
     }
-    
-    frameCounter++;
-    musicTick++;
-    
-    // Change note when duration expires
-    if (musicTick >= NOTE_DURATION) {
-        musicTick = 0;
-        noteIndex++;
-        
-        // Check if we've reached the end of the melody
-        if (noteIndex >= MELODY_LENGTH) {
-            musicComplete = 1; // Mark as complete
-            REG_SOUND2CNT_L = 0x0000;
-            REG_SOUND2CNT_H = 0x0000;
-            return;
-        }
-        
-        u16 currentNote = melodyNotes[noteIndex];
-        
-        // Handle rests (silence) vs actual notes
-        if (currentNote == 0x0000) {
-            // Rest - turn off channel 2 briefly
-            REG_SOUND2CNT_H = 0x0000;
+    if (ch == 0) musicWrite(ch, SND1CNT_L, ins->sweep);
+    musicWrite(ch, VOICE_REGS[ch][0], ins->envelope);
+    musicWrite(ch, VOICE_REGS[ch][1], RESTART | rate);
+}
+
+// Reads a channel's events up to its next note or rest
+static void musicStep(int ch) {
+    MusicChannel *c = &musicChannels[ch];
+    const u8 *orders = musicSong->orders[ch];
+    for (int guard = 0; guard < 256; guard++) {
+        u8 b = *c->pos++;
+        if (b == PSG_END) {
+            if (orders[++c->order] == PSG_ORDER_LOOP) c->order = 0;
+            c->pos = musicSong->patterns[orders[c->order]];
+        } else if (b >= PSG_INS(0)) {
+            c->instrument = b & 0x3F;
+        } else if (b >= PSG_LEN(1)) {
+            c->length = (b & 0x3F) + 1;
         } else {
-            // Play the note on channel 2
-            REG_SOUND2CNT_L = 0x3780; // Duty 25%, volume 0x3, no envelope
-            REG_SOUND2CNT_H = 0x8000 | (currentNote & 0x07FF); // Restart with new note, mask to 11 bits, ensure continuous mode
+            if (b == PSG_REST) {
+                musicWrite(ch, VOICE_REGS[ch][0], 0x0000);
+                musicWrite(ch, VOICE_REGS[ch][1], 0x0000);
+            } else {
+                musicNote(ch, b, &musicSong->instruments[c->instrument]);
+            }
+            c->wait = c->length;
+            return;
         }
     }
+    c->wait = 0xFF; // A song with no notes on this channel
+}
+
+// Timer 1 interrupt: one tick (at 50 Hz, at most one per frame), into the
+// shadow registers
+static void musicTimerHandler(void) {
+    for (int ch = 0; ch < PSG_CHANNELS; ch++) {
+        if (!--musicChannels[ch].wait) musicStep(ch);
+    }
+}
+
+// Wave RAM is loaded through the bank not playing, so the bank select has
+// to reach the hardware before the samples do: done by the VBlank handler
+// ahead of the flush, which then switches playback to the new bank
+static volatile bool waveLoadPending = false;
+
+static void loadPendingWave(void) {
+    if (!waveLoadPending) return;
+    *(vu16 *)(REG_BASE + SND3CNT_L) = WAVE_WRITE_BANK0;
+    psgHardware[PSG_SLOT(SND3CNT_L)] = WAVE_WRITE_BANK0;
+    for (int i = 0; i < 4; i++) WAVE_RAM[i] = BASS_WAVE[i];
+    psgWrite(SND3CNT_L, WAVE_PLAY);
+    waveLoadPending = false;
+}
+
+static void musicSilence(void) {
+    for (int ch = 0; ch < PSG_CHANNELS; ch++) {
+        musicWrite(ch, VOICE_REGS[ch][0], 0x0000);
+        musicWrite(ch, VOICE_REGS[ch][1], 0x0000);
+    }
+}
+
+void musicPlay(const PsgSong *song) {
+    musicStop();
+
+    u16 ime = REG_IME;
+    REG_IME = 0;
+    waveLoadPending = true; // The bass wave, on the next VBlank
+    musicSong = song;
+    for (int ch = 0; ch < PSG_CHANNELS; ch++) {
+        MusicChannel *c = &musicChannels[ch];
+        c->order = 0;
+        c->pos = song->patterns[song->orders[ch][0]];
+        c->wait = 1; // Every channel starts on the first tick
+        c->length = 1;
+        c->instrument = 0;
+    }
+    REG_TM1CNT_L = 65536 - song->tickCounts;
+    REG_TM1CNT_H = TIMER_START | TIMER_IRQ | MUSIC_TIMER_DIV_256;
+    irqSet(IRQ_TIMER1, musicTimerHandler);
+    irqEnable(IRQ_TIMER1);
+    REG_IME = ime;
+}
+
+void musicStop(void) {
+    u16 ime = REG_IME;
+    REG_IME = 0;
+    REG_TM1CNT_H = 0;
+    irqDisable(IRQ_TIMER1);
+    if (musicSong) musicSilence();
+    musicSong = NULL;
+    REG_IME = ime;
 }
 
-void stopProceduralMusic(void) {
-    REG_SOUND2CNT_L = 0x0000;
-    REG_SOUND2CNT_H = 0x0000;
-    musicTick = 0;
-    noteIndex = 0;
-    frameCounter = 0;
-    musicComplete = 0;
+void soundVBlank(void) {
+    updateSoundEffects();
+    loadPendingWave();
+    psgFlush();
+    sfxTriggered = 0;
 }
@@ -2,8 +2,9 @@
 #define SOUND_H
 
 #include <gba_types.h>
+#include "psg_music.h"
 
-// Sound effect functions
+// Sound effects: sequenced, never blocking (sound.c)
 void playShootSound(void);
 void playExplosionSound(void);
 void playMenuSelectSound(void);
@@ -12,9 +13,12 @@ void stopThrusterSound(void);
 void playSirenSound(void);
 void playPlayerHitSound(void);
 
-// Procedural music functions (channel 2)
-void initProceduralMusic(void);
-void updateProceduralMusic(void);
-void stopProceduralMusic(void);
+// Music: loops a song (psg_music.h) on the PSG channels, ticked by timer 1
+void musicPlay(const PsgSong *song);
+void musicStop(void);
+
+// Once per refresh, from the VBlank handler: advances effects, then writes
+// the PSG registers that changed
+void soundVBlank(void);
 
 #endif
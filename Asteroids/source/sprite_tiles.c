@@ -0,0 +1,187 @@
+#include <gba_video.h>
+#include <stdlib.h>
+#include "sprite_tiles.h"
+#include "fixed_trig.h"
+#include "game_objects.h"
+#include "graphics.h"
+#include "mem_ops.h"
+#include "oam_manager.h"
+#include "vector_sprites.h"
+
+// Cached shapes are drawn in palette entry 1; banks 2-7 give it the six
+// rainbow colors (bank 1 is the vector sprites' outline palette)
+#define SPRITE_INK          1
+#define COLOR_BANK_FIRST    2
+
+// The cache takes the OBJ tiles after the vector sprites' textures
+#define CACHE_TILE_FIRST    VSPR_TILE_END
+#define CACHE_ENTRIES       24
+
+#define BULLET_RADIUS       2   // drawBullet()'s circle
+#define ROCK_MIN_SCALE      192 // Vertex radius jitter: 0.75-1.0 of the radius (8.8)
+
+typedef struct {
+    u8 shape;
+    u8 radius;
+    u16 tile;
+} CachedShape;
+
+static CachedShape s_cache[CACHE_ENTRIES];
+static int s_cacheCount = 0;
+static int s_nextTile = CACHE_TILE_FIRST;
+
+// Red, yellow, lime, cyan, blue, magenta (the bullet color order)
+static const u16 RAINBOW_RGB[BULLET_COLOR_COUNT] = {
+    RGB5(31,  0,  0), RGB5(31, 31,  0), RGB5( 0, 31,  0),
+    RGB5( 0, 31, 31), RGB5( 0,  0, 31), RGB5(31,  0, 31),
+};
+
+// --- Rasterization into 4bpp tiles (1D mapping) ---
+
+void spriteTextureClear(int tile, int size) {
+    memFill32(objTileData(tile), 0, (size / 8) * (size / 8) * 32);
+}
+
+// VRAM takes no byte writes: each u16 holds four 4-bit texels
+static void plotTexel(int tile, int size, int x, int y, int color) {
+    if ((unsigned)x >= (unsigned)size || (unsigned)y >= (unsigned)size) return;
+    vu16 *half = objTileData(tile + (y >> 3) * (size >> 3) + (x >> 3)) + (y & 7) * 2 + ((x & 7) >> 2);
+    int shift = (x & 3) * 4;
+    *half = (*half & ~(0xF << shift)) | (color << shift);
+}
+
+void spriteTextureLine(int tile, int size, int x0, int y0, int x1, int y1, int color) {
+    int dx = abs(x1 - x0);
+    int dy = abs(y1 - y0);
+    int sx = (x0 < x1) ? 1 : -1;
+    int sy = (y0 < y1) ? 1 : -1;
+    int err = dx - dy;
+
+    for (;;) {
+        plotTexel(tile, size, x0, y0, color);
+        if (x0 == x1 && y0 == y1) break;
+        int e2 = 2 * err;
+        if (e2 > -dy) { err -= dy; x0 += sx; }
+        if (e2 < dx) { err += dx; y0 += sy; }
+    }
+}
+
+void spriteTextureOutline(int tile, int size, const int *vx, const int *vy, int count, int color) {
+    int c = size / 2;
+    for (int v = 0; v < count; v++) {
+        int w = (v + 1 < count) ? v + 1 : 0;
+        spriteTextureLine(tile, size, c + vx[v], c + vy[v], c + vx[w], c + vy[w], color);
+    }
+}
+
+void spriteTextureCircle(int tile, int size, int radius, int color) {
+    int c = size / 2;
+    int x = radius;
+    int y = 0;
+    int err = 0;
+
+    while (x >= y) {
+        plotTexel(tile, size, c + x, c + y, color);
+        plotTexel(tile, size, c + y, c + x, color);
+        plotTexel(tile, size, c - y, c + x, color);
+        plotTexel(tile, size, c - x, c + y, color);
+        plotTexel(tile, size, c - x, c - y, color);
+        plotTexel(tile, size, c - y, c - x, color);
+        plotTexel(tile, size, c + y, c - x, color);
+        plotTexel(tile, size, c + x, c - y, color);
+
+        y++;
+        if (err <= 0) {
+            err += 2 * y + 1;
+        } else {
+            x--;
+            err -= 2 * x + 1;
+        }
+    }
+}
+
+// --- Shapes ---
+
+// A lumpy polygon: SPRITE_ROCK_VERTICES evenly spaced directions, each at a
+// jittered distance. The seed depends only on variant and radius, so a
+// rock looks the same every boot (and at every rotation).
+void spriteRockOutline(int variant, int radius, int angle, int *vx, int *vy) {
+    u32 seed = 0x9E3779B9u * (variant + 1) + radius;
+    for (int v = 0; v < SPRITE_ROCK_VERTICES; v++) {
+        // xorshift32
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        int scale = ROCK_MIN_SCALE + (seed & 0xFF) * (256 - ROCK_MIN_SCALE) / 256;
+        int r = (radius * scale) >> 8;
+        int a = angle + v * 360 / SPRITE_ROCK_VERTICES;
+        vx[v] = (r * cos_fp_deg(a)) >> FP_SHIFT;
+        vy[v] = (r * sin_fp_deg(a)) >> FP_SHIFT;
+    }
+}
+
+static void rasterizeRock(int tile, int size, int radius, int variant) {
+    int vx[SPRITE_ROCK_VERTICES], vy[SPRITE_ROCK_VERTICES];
+    spriteRockOutline(variant, radius, 0, vx, vy);
+    spriteTextureOutline(tile, size, vx, vy, SPRITE_ROCK_VERTICES, SPRITE_INK);
+}
+
+int spriteTileSize(int radius) {
+    int diameter = 2 * radius + 1;
+    if (diameter <= 8) return 8;
+    if (diameter <= 16) return 16;
+    return 32;
+}
+
+u16 spriteTileSizeBits(int radius) {
+    int size = spriteTileSize(radius);
+    if (size == 8) return ATTR1_SIZE_8;
+    if (size == 16) return ATTR1_SIZE_16;
+    return ATTR1_SIZE_32;
+}
+
+int spriteColorBank(int colorIdx) {
+    return COLOR_BANK_FIRST + colorIdx;
+}
+
+int spriteTileGet(int shape, int radius) {
+    for (int i = 0; i < s_cacheCount; i++) {
+        if (s_cache[i].shape == shape && s_cache[i].radius == radius) return s_cache[i].tile;
+    }
+
+    int size = spriteTileSize(radius);
+    int tiles = (size / 8) * (size / 8);
+    if (s_cacheCount >= CACHE_ENTRIES || s_nextTile + tiles > OBJ_TILE_COUNT) return -1;
+
+    int tile = s_nextTile;
+    spriteTextureClear(tile, size);
+    if (shape == SPRITE_SHAPE_CIRCLE) {
+        spriteTextureCircle(tile, size, radius, SPRITE_INK);
+    } else {
+        rasterizeRock(tile, size, radius, shape - SPRITE_SHAPE_ROCK);
+    }
+
+    s_cache[s_cacheCount].shape = shape;
+    s_cache[s_cacheCount].radius = radius;
+    s_cache[s_cacheCount].tile = tile;
+    s_cacheCount++;
+    s_nextTile += tiles;
+    return tile;
+}
+
+void spriteTilesInit(void) {
+    for (int i = 0; i < BULLET_COLOR_COUNT; i++) {
+        SPRITE_PALETTE[spriteColorBank(i) * 16 + SPRITE_INK] = RAINBOW_RGB[i];
+    }
+
+    // Everything the game draws, so no frame ever rasterizes
+    static const int asteroidSizes[] = { ASTEROID_SIZE_L, ASTEROID_SIZE_M, ASTEROID_SIZE_S };
+    for (unsigned i = 0; i < sizeof(asteroidSizes) / sizeof(asteroidSizes[0]); i++) {
+        int radius = getAsteroidRadius(asteroidSizes[i]);
+        spriteTileGet(SPRITE_SHAPE_CIRCLE, radius);
+        for (int v = 0; v < SPRITE_ROCK_VARIANTS; v++) {
+            spriteTileGet(SPRITE_SHAPE_ROCK + v, radius);
+        }
+    }
+    spriteTileGet(SPRITE_SHAPE_CIRCLE, BULLET_RADIUS);
+}
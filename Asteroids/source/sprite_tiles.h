@@ -0,0 +1,49 @@
+#ifndef SPRITE_TILES_H
+#define SPRITE_TILES_H
+
+#include <gba_types.h>
+
+// --- Procedural Sprite Tiles ---
+// Asteroid and bullet imagery for OBJ sprites, rasterized at boot into 4bpp
+// OBJ tiles: the circle outlines the software renderer draws, plus a few
+// irregular rock outlines. Tiles are cached by shape and radius, so every
+// sprite of a shape shares one copy; color comes from the palette bank
+// (spriteColorBank()), not from the tiles.
+#define SPRITE_SHAPE_CIRCLE     0
+#define SPRITE_SHAPE_ROCK       1   // Rock variants are SPRITE_SHAPE_ROCK + 0..SPRITE_ROCK_VARIANTS-1
+#define SPRITE_ROCK_VARIANTS    3
+#define SPRITE_ROCK_VERTICES    9
+
+// Loads the color banks and rasterizes the game's shapes; call after
+// vectorSpritesInit()
+void spriteTilesInit(void);
+
+// First tile (relative to OBJ_TILE_BASE) of a shape's square texture,
+// rasterizing it on first use; -1 when the cache is full. The shape is
+// centered in its texture.
+int spriteTileGet(int shape, int radius);
+
+// Side of the texture of a shape with this radius (8, 16 or 32), and its
+// ATTR1_SIZE_* bits
+int spriteTileSize(int radius);
+u16 spriteTileSizeBits(int radius);
+
+// Vertex offsets of a rock outline turned by 'angle' degrees; the software
+// stamps (stamp_cache.c) draw the same rocks
+void spriteRockOutline(int variant, int radius, int angle, int *vx, int *vy);
+
+// Palette bank drawing cached shapes in rainbow color 'colorIdx' (0-5: red,
+// yellow, lime, cyan, blue, magenta)
+int spriteColorBank(int colorIdx);
+
+// --- Rasterization into 4bpp tiles (1D mapping) ---
+// A texture is size x size pixels at 'tile'; coordinates outside it are
+// clipped.
+void spriteTextureClear(int tile, int size);
+void spriteTextureLine(int tile, int size, int x0, int y0, int x1, int y1, int color);
+// Outline through vertex offsets from the texture's center
+void spriteTextureOutline(int tile, int size, const int *vx, const int *vy, int count, int color);
+// Midpoint circle around the texture's center, as drawCircle() plots it
+void spriteTextureCircle(int tile, int size, int radius, int color);
+
+#endif // SPRITE_TILES_H
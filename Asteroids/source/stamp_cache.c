@@ -0,0 +1,161 @@
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "stamp_cache.h"
+#include "game_objects.h"
+#include "sprite_tiles.h"
+
+#define STAMP_MAX_SIDE      (2 * STAMP_MAX_RADIUS + 1)
+#define STAMP_MAX_COUNT     96  // All circles plus every rock rotation of three sizes
+#define STAMP_POOL_BYTES    6144
+#define NO_STAMP            (-1)
+
+#define BULLET_RADIUS       2   // drawBullet()'s circle
+
+typedef struct {
+    u16 offset; // Into s_pool
+    u8 side;
+} Stamp;
+
+// Span lists are read for every asteroid every frame: keep them in IWRAM
+static u8 s_pool[STAMP_POOL_BYTES];
+static int s_poolUsed = 0;
+static Stamp s_stamps[STAMP_MAX_COUNT];
+static int s_stampCount = 0;
+// Handle of every built shape; rocks use all rotations, circles rotation 0
+static s8 s_index[STAMP_SHAPES][STAMP_MAX_RADIUS + 1][STAMP_ROTATIONS];
+static bool s_indexReady = false;
+
+// --- Rasterization into a bit mask (bit x of row y) ---
+
+static void maskPlot(u32 *mask, int side, int x, int y) {
+    if ((unsigned)x < (unsigned)side && (unsigned)y < (unsigned)side) mask[y] |= 1u << x;
+}
+
+static void maskLine(u32 *mask, int side, int x0, int y0, int x1, int y1) {
+    int dx = abs(x1 - x0);
+    int dy = abs(y1 - y0);
+    int sx = (x0 < x1) ? 1 : -1;
+    int sy = (y0 < y1) ? 1 : -1;
+    int err = dx - dy;
+
+    for (;;) {
+        maskPlot(mask, side, x0, y0);
+        if (x0 == x1 && y0 == y1) break;
+        int e2 = 2 * err;
+        if (e2 > -dy) { err -= dy; x0 += sx; }
+        if (e2 < dx) { err += dx; y0 += sy; }
+    }
+}
+
+// drawCircleStep()'s midpoint walk, around the mask's center
+static void maskCircle(u32 *mask, int radius, int step) {
+    int side = 2 * radius + 1;
+    int c = radius;
+    int x = radius;
+    int y = 0;
+    int err = 0;
+    int phase = 0;
+
+    while (x >= y) {
+        if (phase == 0) {
+            maskPlot(mask, side, c + x, c + y); maskPlot(mask, side, c + y, c + x);
+            maskPlot(mask, side, c - y, c + x); maskPlot(mask, side, c - x, c + y);
+            maskPlot(mask, side, c - x, c - y); maskPlot(mask, side, c - y, c - x);
+            maskPlot(mask, side, c + y, c - x); maskPlot(mask, side, c + x, c - y);
+        }
+        if (++phase >= step) phase = 0;
+
+        y++;
+        if (err <= 0) {
+            err += 2 * y + 1;
+        } else {
+            x--;
+            err -= 2 * x + 1;
+        }
+    }
+}
+
+static void maskRock(u32 *mask, int radius, int variant, int rotation) {
+    int vx[SPRITE_ROCK_VERTICES], vy[SPRITE_ROCK_VERTICES];
+    int side = 2 * radius + 1;
+    spriteRockOutline(variant, radius, rotation * (360 / STAMP_ROTATIONS), vx, vy);
+    for (int v = 0; v < SPRITE_ROCK_VERTICES; v++) {
+        int w = (v + 1 < SPRITE_ROCK_VERTICES) ? v + 1 : 0;
+        maskLine(mask, side, radius + vx[v], radius + vy[v], radius + vx[w], radius + vy[w]);
+    }
+}
+
+// --- Span encoding ---
+
+// Appends the span list of a mask to the pool; returns its offset, or -1
+// when it does not fit
+static int encodeSpans(const u32 *mask, int side) {
+    int start = s_poolUsed;
+    int at = start;
+    for (int y = 0; y < side; y++) {
+        // A row has at most (side + 1) / 2 spans
+        if (at + 1 + (side + 1) > STAMP_POOL_BYTES) return -1;
+        int countAt = at++;
+        int count = 0;
+        int x = 0, last = 0;
+        u32 bits = mask[y];
+        while (x < side) {
+            if (!(bits & (1u << x))) { x++; continue; }
+            int run = 0;
+            while (x + run < side && (bits & (1u << (x + run)))) run++;
+            s_pool[at++] = x - last;
+            s_pool[at++] = run;
+            count++;
+            x += run;
+            last = x;
+        }
+        s_pool[countAt] = count;
+    }
+    s_poolUsed = at;
+    return start;
+}
+
+static void resetIndex(void) {
+    memset(s_index, NO_STAMP, sizeof(s_index));
+    s_indexReady = true;
+}
+
+int stampGet(int shape, int radius, int rotation) {
+    if (shape < 0 || shape >= STAMP_SHAPES || radius < 0 || radius > STAMP_MAX_RADIUS) return -1;
+    if (!s_indexReady) resetIndex();
+    rotation = (shape >= STAMP_ROCK) ? (rotation & (STAMP_ROTATIONS - 1)) : 0;
+
+    s8 *slot = &s_index[shape][radius][rotation];
+    if (*slot != NO_STAMP) return *slot;
+    if (s_stampCount >= STAMP_MAX_COUNT) return -1;
+
+    u32 mask[STAMP_MAX_SIDE] = { 0 };
+    int side = 2 * radius + 1;
+    if (shape == STAMP_CIRCLE) maskCircle(mask, radius, 1);
+    else if (shape == STAMP_CIRCLE_DOTTED) maskCircle(mask, radius, 2);
+    else maskRock(mask, radius, shape - STAMP_ROCK, rotation);
+
+    int offset = encodeSpans(mask, side);
+    if (offset < 0) return -1;
+    s_stamps[s_stampCount].offset = offset;
+    s_stamps[s_stampCount].side = side;
+    *slot = s_stampCount;
+    return s_stampCount++;
+}
+
+const u8 *stampSpans(int stamp, int *side) {
+    if (stamp < 0 || stamp >= s_stampCount) return NULL;
+    *side = s_stamps[stamp].side;
+    return &s_pool[s_stamps[stamp].offset];
+}
+
+void stampCacheInit(void) {
+    static const int asteroidSizes[] = { ASTEROID_SIZE_L, ASTEROID_SIZE_M, ASTEROID_SIZE_S };
+    for (unsigned i = 0; i < sizeof(asteroidSizes) / sizeof(asteroidSizes[0]); i++) {
+        int radius = getAsteroidRadius(asteroidSizes[i]);
+        stampGet(STAMP_CIRCLE, radius, 0);
+        stampGet(STAMP_CIRCLE_DOTTED, radius, 0);
+    }
+    stampGet(STAMP_CIRCLE, BULLET_RADIUS, 0);
+}
@@ -0,0 +1,36 @@
+#ifndef STAMP_CACHE_H
+#define STAMP_CACHE_H
+
+#include <gba_types.h>
+#include "sprite_tiles.h" // SPRITE_ROCK_VARIANTS
+
+// --- Software Stamp Cache ---
+// Shapes the software renderer draws over and over (asteroid and bullet
+// outlines) are rasterized once into run-length span lists. Drawing one is
+// then a copy of its spans into back_buffer (drawStamp() in graphics.c),
+// with no per-pixel shape math. Stamps are built on first use and never
+// freed.
+//
+// A stamp's span list is one record per row, top to bottom: a span count,
+// then (skip, run) byte pairs, skip counted from the end of the previous
+// span (the stamp's left edge for the first).
+#define STAMP_CIRCLE        0   // Midpoint circle, as drawCircle() plots it
+#define STAMP_CIRCLE_DOTTED 1   // Every other step, as drawCircleStep(.., 2)
+#define STAMP_ROCK          2   // Rock outlines: STAMP_ROCK + 0..SPRITE_ROCK_VARIANTS-1
+#define STAMP_SHAPES        (STAMP_ROCK + SPRITE_ROCK_VARIANTS)
+
+#define STAMP_MAX_RADIUS    15  // Stamps are at most 31x31
+#define STAMP_ROTATIONS     8   // Rock rotations, 45 degrees apart
+
+// Stamp handle of a shape (rotation only matters for rocks), building it on
+// first use; -1 when the shape is out of range or the span pool is full
+int stampGet(int shape, int radius, int rotation);
+
+// Span list of a stamp, and its side; the shape is centered on
+// (side / 2, side / 2)
+const u8 *stampSpans(int stamp, int *side);
+
+// Builds the asteroid and bullet circles so gameplay never rasterizes
+void stampCacheInit(void);
+
+#endif // STAMP_CACHE_H
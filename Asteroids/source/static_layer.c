@@ -0,0 +1,57 @@
+#include <gba_base.h>
+#include "static_layer.h"
+#include "frame_pipeline.h"
+#include "graphics.h"
+#include "mem_ops.h"
+
+// memCopy32() takes CpuFastSet for multiples of 8 words; two rows are one
+// in the bitmap renderers (a Mode 4 row is only 60 words). The tiled frame
+// can only be cut at whole rows of tiles.
+#if FRAME_ROW_ALIGN > 2
+#define ROW_ALIGN   FRAME_ROW_ALIGN
+#else
+#define ROW_ALIGN   2
+#endif
+
+static FRAMELINE s_layer[SCREEN_HEIGHT] EWRAM_BSS;
+static int s_layerId = LAYER_NONE;
+// Back buffers that already hold the full layer
+static FRAMELINE *s_seeded[FRAME_BACK_BUFFERS];
+static int s_seededCount = 0;
+
+// A CPU copy rather than DMA: it can be interrupted, so the VBlank handler
+// (and its own DMA) is not held off for the length of the copy
+static void copyRows(FRAMELINE *dst, const FRAMELINE *src, int top, int bottom) {
+    memCopy32(dst[top], src[top], (bottom - top) * sizeof(FRAMELINE));
+}
+
+bool staticLayerRestore(int layer, int top, int bottom) {
+    if (layer != s_layerId) return false;
+
+    for (int i = 0; i < s_seededCount; i++) {
+        if (s_seeded[i] == back_buffer) {
+            top &= ~(ROW_ALIGN - 1);
+            bottom = (bottom + ROW_ALIGN - 1) & ~(ROW_ALIGN - 1);
+            if (top < 0) top = 0;
+            if (bottom > SCREEN_HEIGHT) bottom = SCREEN_HEIGHT;
+            if (top < bottom) copyRows(back_buffer, s_layer, top, bottom);
+            return true;
+        }
+    }
+
+    copyRows(back_buffer, s_layer, 0, SCREEN_HEIGHT);
+    if (s_seededCount < FRAME_BACK_BUFFERS) s_seeded[s_seededCount++] = back_buffer;
+    return true;
+}
+
+void staticLayerCapture(int layer) {
+    copyRows(s_layer, back_buffer, 0, SCREEN_HEIGHT);
+    s_layerId = layer;
+    s_seeded[0] = back_buffer;
+    s_seededCount = 1;
+}
+
+void staticLayerInvalidate(void) {
+    s_layerId = LAYER_NONE;
+    s_seededCount = 0;
+}
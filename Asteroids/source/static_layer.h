@@ -0,0 +1,38 @@
+#ifndef STATIC_LAYER_H
+#define STATIC_LAYER_H
+
+#include <stdbool.h>
+
+// --- Retained Static Layer ---
+// Menu-style screens draw their static content (titles, option text) once,
+// capture it, and start every later frame by copying it back instead of
+// clearing and redrawing text pixel by pixel:
+//
+//     if (!staticLayerRestore(LAYER_X, top, bottom)) {
+//         ...draw the static content...
+//         staticLayerCapture(LAYER_X);
+//     }
+//     ...draw cursors and other animated elements...
+//
+// Rows [top, bottom) are where the animated elements draw: a back buffer
+// gets the full layer once and then only that band, since the rest of it
+// never changes. The cache is dropped on screen changes
+// (staticLayerInvalidate()).
+
+#define LAYER_NONE              0
+#define LAYER_MENU              1
+#define LAYER_SETTINGS          2
+#define LAYER_SETTINGS_CONFIRM  3
+#define LAYER_CREDITS           4
+#define LAYER_PAUSE             5
+
+// Copies the cached layer into back_buffer if it holds screen 'layer';
+// returns false (and copies nothing) when the caller has to draw it
+bool staticLayerRestore(int layer, int top, int bottom);
+
+// Stores back_buffer as the layer of screen 'layer'
+void staticLayerCapture(int layer);
+
+void staticLayerInvalidate(void);
+
+#endif // STATIC_LAYER_H
@@ -0,0 +1,109 @@
+#include <gba_video.h>
+#include <stdlib.h>
+#include "vector_sprites.h"
+#include "fixed_trig.h"
+#include "game_objects.h"
+#include "graphics.h"
+#include "oam_manager.h"
+#include "sprite_tiles.h"
+
+// Outlines use their own 16-color OBJ palette bank: entries 1-6 are the
+// rainbow colors, 0 is transparent
+#define OUTLINE_PALBANK 1
+#define OUTLINE_LIME    3
+
+// Tile layout: OBJ tiles 0 to VSPR_TILE_END
+#define SHIP_TILE       0
+#define SHIP_SIZE       16
+#define POLYGON_TILE    (SHIP_TILE + (SHIP_SIZE / 8) * (SHIP_SIZE / 8))
+#define POLYGON_SIZE    32
+#define POLYGON_TILES   ((POLYGON_SIZE / 8) * (POLYGON_SIZE / 8))
+#if POLYGON_TILE + VSPR_POLYGON_SLOTS * POLYGON_TILES > VSPR_TILE_END
+#error "vector sprite textures overrun VSPR_TILE_END"
+#endif
+
+// The paletted renderers show the OBJ layer through palette index 0, so the
+// menu polygons can sit behind the frame (and its text) as they did when
+// drawn into it. The Mode 3 bitmap is opaque and needs them in front.
+#ifdef RENDER_PALETTED
+#define POLYGON_PRIORITY 1
+#else
+#define POLYGON_PRIORITY 0
+#endif
+
+typedef struct {
+    int oam;    // Sprite handle
+    int affine; // Matrix handle
+} VectorSprite;
+
+static VectorSprite s_ship;
+static VectorSprite s_polygons[VSPR_POLYGON_SLOTS];
+
+static const u16 OUTLINE_RGB[7] = {
+    0x0000,
+    RGB5(31,  0,  0), RGB5(31, 31,  0), RGB5( 0, 31,  0),
+    RGB5( 0, 31, 31), RGB5( 0,  0, 31), RGB5(31,  0, 31),
+};
+
+// --- Sprites ---
+
+static void allocSprite(VectorSprite *s) {
+    s->oam = allocateOAMSprite();
+    s->affine = allocateOAMAffine();
+}
+
+static void placeSprite(const VectorSprite *s, int cx, int cy, int angle, int tile, int size,
+                        int priority, u16 size_bits) {
+    int cosA = cos_fp_deg(angle);
+    int sinA = sin_fp_deg(angle);
+    // Screen-to-texture mapping: the inverse of rotating the texture by angle
+    setOAMAffine(s->affine, (s16)cosA, (s16)sinA, (s16)-sinA, (s16)cosA);
+    setOAMAffineAttributes(s->oam, s->affine, cx - size / 2, cy - size / 2,
+                           tile, OUTLINE_PALBANK, priority, size_bits);
+}
+
+void vectorSpritesInit(void) {
+    for (int i = 0; i < 7; i++) {
+        SPRITE_PALETTE[OUTLINE_PALBANK * 16 + i] = OUTLINE_RGB[i];
+    }
+
+    // The ship triangle of the old software renderer, pointing east
+    int offset = PLAYER_SIZE / 2;
+    int back = -offset + PLAYER_BACK_INSET;
+    const int shipX[3] = { offset + PLAYER_FRONT_EXTEND, back, back };
+    const int shipY[3] = { 0, offset - PLAYER_BACK_INSET, -offset + PLAYER_BACK_INSET };
+    spriteTextureClear(SHIP_TILE, SHIP_SIZE);
+    spriteTextureOutline(SHIP_TILE, SHIP_SIZE, shipX, shipY, 3, OUTLINE_LIME);
+
+    allocSprite(&s_ship);
+    for (int i = 0; i < VSPR_POLYGON_SLOTS; i++) {
+        allocSprite(&s_polygons[i]);
+    }
+}
+
+void showShipSprite(int cx, int cy, int angle) {
+    placeSprite(&s_ship, cx, cy, angle, SHIP_TILE, SHIP_SIZE, 0, ATTR1_SIZE_16);
+}
+
+void hideShipSprite(void) {
+    hideOAMSprite(s_ship.oam);
+}
+
+void loadPolygonSprite(int slot, const int *vertexX, const int *vertexY, int count, int colorIdx) {
+    if (slot < 0 || slot >= VSPR_POLYGON_SLOTS) return;
+    int tile = POLYGON_TILE + slot * POLYGON_TILES;
+    spriteTextureClear(tile, POLYGON_SIZE);
+    spriteTextureOutline(tile, POLYGON_SIZE, vertexX, vertexY, count, 1 + colorIdx);
+}
+
+void showPolygonSprite(int slot, int cx, int cy, int angle) {
+    if (slot < 0 || slot >= VSPR_POLYGON_SLOTS) return;
+    placeSprite(&s_polygons[slot], cx, cy, angle, POLYGON_TILE + slot * POLYGON_TILES,
+                POLYGON_SIZE, POLYGON_PRIORITY, ATTR1_SIZE_32);
+}
+
+void hidePolygonSprites(void) {
+    for (int i = 0; i < VSPR_POLYGON_SLOTS; i++) {
+        hideOAMSprite(s_polygons[i].oam);
+    }
+}
@@ -0,0 +1,28 @@
+#ifndef VECTOR_SPRITES_H
+#define VECTOR_SPRITES_H
+
+#include <gba_types.h>
+
+// --- Vector Sprites ---
+// The player ship and the menu polygons are outlines rasterized once into
+// OBJ tiles. A frame only places their sprite and sets its affine matrix
+// from the angle; the hardware does the rotation and nothing is drawn into
+// the framebuffer.
+#define VSPR_POLYGON_SLOTS  5   // One per menu shape
+#define VSPR_POLYGON_RADIUS 15  // Largest outline a 32x32 sprite holds whole
+#define VSPR_TILE_END       84  // The textures take OBJ tiles 0-83
+
+// Loads the outline palette and rasterizes the ship; call after initOAM()
+void vectorSpritesInit(void);
+
+// Ship centered on (cx, cy), pointing at 'angle' degrees (0 = east)
+void showShipSprite(int cx, int cy, int angle);
+void hideShipSprite(void);
+
+// Rasterizes a closed polygon (vertex offsets from its center) into a slot,
+// in rainbow color 'colorIdx' (0-5: red, yellow, lime, cyan, blue, magenta)
+void loadPolygonSprite(int slot, const int *vertexX, const int *vertexY, int count, int colorIdx);
+void showPolygonSprite(int slot, int cx, int cy, int angle);
+void hidePolygonSprites(void);
+
+#endif // VECTOR_SPRITES_H
@@ -0,0 +1,191 @@
+// WAV to 4-bit ADPCM blob encoder (see README.txt and ../../source/adpcm.h)
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "adpcm.h"
+
+typedef struct {
+    int channels;
+    int rate;
+    int bits;
+    const u8 *data;
+    u32 bytes;
+} WavInfo;
+
+static u32 readLong(const u8 *p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((u32)p[3] << 24);
+}
+
+static u16 readShort(const u8 *p) {
+    return p[0] | (p[1] << 8);
+}
+
+static void writeLong(u8 *p, u32 v) {
+    p[0] = v;
+    p[1] = v >> 8;
+    p[2] = v >> 16;
+    p[3] = v >> 24;
+}
+
+static u8 *readFile(const char *path, u32 *size) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long length = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    u8 *buffer = malloc(length > 0 ? length : 1);
+    if (buffer && fread(buffer, 1, length, f) != (size_t)length) {
+        free(buffer);
+        buffer = NULL;
+    }
+    fclose(f);
+    *size = length;
+    return buffer;
+}
+
+static const char *parseWav(const u8 *file, u32 size, WavInfo *wav) {
+    if (size < 12 || memcmp(file, "RIFF", 4) || memcmp(file + 8, "WAVE", 4)) return "not a WAV file";
+    bool haveFormat = false;
+    wav->data = NULL;
+    for (u32 pos = 12; pos + 8 <= size;) {
+        const u8 *chunk = file + pos;
+        u32 length = readLong(chunk + 4);
+        if (length > size - pos - 8) length = size - pos - 8;
+        if (!memcmp(chunk, "fmt ", 4) && length >= 16) {
+            if (readShort(chunk + 8) != 1) return "not uncompressed PCM";
+            wav->channels = readShort(chunk + 10);
+            wav->rate = readLong(chunk + 12);
+            wav->bits = readShort(chunk + 22);
+            haveFormat = true;
+        } else if (!memcmp(chunk, "data", 4)) {
+            wav->data = chunk + 8;
+            wav->bytes = length;
+        }
+        pos += 8 + length + (length & 1);
+    }
+    if (!haveFormat || !wav->data) return "missing fmt or data chunk";
+    if (wav->bits != 8 && wav->bits != 16) return "only 8- and 16-bit samples are supported";
+    if (wav->channels < 1) return "no channels";
+    return NULL;
+}
+
+// Mono, in the 8-bit range the decoder produces
+static int *loadSamples(const WavInfo *wav, u32 *count) {
+    int frameBytes = wav->channels * wav->bits / 8;
+    *count = wav->bytes / frameBytes;
+    int *samples = malloc((*count + ADPCM_BLOCK_SAMPLES) * sizeof(int));
+    for (u32 i = 0; i < *count; i++) {
+        const u8 *frame = wav->data + i * frameBytes;
+        long sum = 0;
+        for (int c = 0; c < wav->channels; c++) {
+            if (wav->bits == 8) sum += (frame[c] - 128) * 256;
+            else sum += (s16)readShort(frame + c * 2);
+        }
+        long value = sum / wav->channels;
+        samples[i] = (int)lround(value / 256.0);
+        if (samples[i] > 127) samples[i] = 127;
+        if (samples[i] < -128) samples[i] = -128;
+    }
+    return samples;
+}
+
+// Greedy codes for one block at 'scale', starting from 'previous'; returns
+// the squared error and leaves the last decoded sample in *previous
+static long encodeBlock(const int *target, int scale, int *previous, u8 *codes) {
+    const s8 *steps = ADPCM_STEPS[scale];
+    int sample = *previous;
+    long error = 0;
+    for (int i = 0; i < ADPCM_BLOCK_SAMPLES; i++) {
+        int best = 0;
+        int bestError = -1;
+        for (int code = 0; code < 16; code++) {
+            int next = sample + steps[code];
+            if (next < -128 || next > 127) continue; // The decoder does not clamp
+            int e = abs(next - target[i]);
+            if (bestError < 0 || e < bestError) {
+                best = code;
+                bestError = e;
+            }
+        }
+        sample += steps[best];
+        codes[i] = best;
+        error += (long)bestError * bestError;
+    }
+    *previous = sample;
+    return error;
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s in.wav out.adpcm\n", argv[0]);
+        return 1;
+    }
+
+    u32 size;
+    u8 *file = readFile(argv[1], &size);
+    if (!file) {
+        fprintf(stderr, "%s: cannot read\n", argv[1]);
+        return 1;
+    }
+    WavInfo wav = { 0 };
+    const char *problem = parseWav(file, size, &wav);
+    if (problem) {
+        fprintf(stderr, "%s: %s\n", argv[1], problem);
+        return 1;
+    }
+
+    u32 count;
+    int *samples = loadSamples(&wav, &count);
+    u32 blocks = (count + ADPCM_BLOCK_SAMPLES - 1) / ADPCM_BLOCK_SAMPLES;
+    // Pad the last block by holding the final sample
+    for (u32 i = count; i < blocks * ADPCM_BLOCK_SAMPLES; i++) samples[i] = count ? samples[count - 1] : 0;
+
+    u32 outBytes = ADPCM_HEADER_BYTES + blocks * ADPCM_BLOCK_BYTES;
+    u8 *out = malloc(outBytes);
+    memcpy(out, "AD4S", 4);
+    writeLong(out + 4, count);
+    writeLong(out + 8, wav.rate);
+
+    int sample = 0;
+    double signal = 0, noise = 0;
+    u8 *block = out + ADPCM_HEADER_BYTES;
+    for (u32 b = 0; b < blocks; b++, block += ADPCM_BLOCK_BYTES) {
+        const int *target = samples + b * ADPCM_BLOCK_SAMPLES;
+        u8 codes[ADPCM_BLOCK_SAMPLES];
+        u8 bestCodes[ADPCM_BLOCK_SAMPLES];
+        int bestScale = 0, bestEnd = 0;
+        long bestError = -1;
+        for (int scale = 0; scale < ADPCM_SCALES; scale++) {
+            int end = sample;
+            long error = encodeBlock(target, scale, &end, codes);
+            if (bestError < 0 || error < bestError) {
+                bestError = error;
+                bestScale = scale;
+                bestEnd = end;
+                memcpy(bestCodes, codes, sizeof(codes));
+            }
+        }
+        block[0] = bestScale;
+        for (int i = 0; i < ADPCM_BLOCK_SAMPLES; i += 2) {
+            block[1 + i / 2] = bestCodes[i] | (bestCodes[i + 1] << 4);
+        }
+        sample = bestEnd;
+        noise += bestError;
+        for (int i = 0; i < ADPCM_BLOCK_SAMPLES; i++) signal += (double)target[i] * target[i];
+    }
+
+    FILE *f = fopen(argv[2], "wb");
+    if (!f || fwrite(out, 1, outBytes, f) != outBytes) {
+        fprintf(stderr, "%s: cannot write\n", argv[2]);
+        return 1;
+    }
+    fclose(f);
+
+    double snr = (noise > 0) ? 10 * log10(signal / noise) : 99;
+    printf("%s: %u samples at %d Hz, %u bytes, SNR %.1f dB\n", argv[2], count, wav.rate, outBytes, snr);
+    free(out);
+    free(samples);
+    free(file);
+    return 0;
+}
@@ -0,0 +1,335 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <gba_types.h>
+#include "autopilot.h"
+#include "game_objects.h"
+#include "object_pool.h"
+
+// --- Host Batch Simulator ---
+// Plays thousands of seeded matches under the autopilot on every core and
+// reports survival, score, entity-peak and spawn-curve statistics for each
+// combination of spawn tuning values. Usage:
+//   batchsim [-m matches] [-t threads] [-s seed] [-f maxFrames]
+//            [-i initialIntervals] [-d decreaseAmounts]
+// -i and -d take comma-separated lists; every pair is simulated. A match runs
+// until game over or maxFrames. Deaths respawn the ship at once (the game's
+// short respawn delay is not modelled).
+
+#define MAX_VALUES     16
+#define CURVE_BUCKET   600   // Frames per spawn-curve sample (10 s)
+#define CURVE_BUCKETS  12
+
+typedef struct {
+    MatchTuning tuning;
+} Config;
+
+typedef struct {
+    int frames;                      // Frames survived
+    int capped;                      // Still alive at maxFrames
+    int score;
+    int peakAsteroids;
+    int peakBullets;
+    int spawnRefusals;               // Asteroid allocations refused (pool full)
+    int curveFrames[CURVE_BUCKETS];  // Frames played in each bucket
+    int curveAsteroids[CURVE_BUCKETS]; // Live asteroids summed over the bucket
+    int curveInterval[CURVE_BUCKETS];  // Spawn interval at the end of the bucket
+} MatchResult;
+
+// Each worker owns a contiguous range of job indices. The owner takes jobs from
+// the front; an idle worker steals the back half of another worker's range.
+typedef struct {
+    pthread_mutex_t lock;
+    int head;
+    int tail;
+} JobRange;
+
+typedef struct {
+    const Config *configs;
+    int matchesPerConfig;
+    int maxFrames;
+    u32 seed;
+    MatchResult *results;
+    JobRange *ranges;
+    int workers;
+} Batch;
+
+typedef struct {
+    Batch *batch;
+    int id;
+    int steals;
+} Worker;
+
+static u32 jobSeed(u32 seed, int job) {
+    // Mix so neighbouring jobs get unrelated xorshift streams
+    u32 x = seed ^ ((u32)job * 0x9E3779B9u);
+    x ^= x >> 16;
+    x *= 0x85EBCA6Bu;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35u;
+    x ^= x >> 16;
+    return x;
+}
+
+static void runMatch(const Config *config, u32 seed, int maxFrames, MatchResult *r) {
+    MatchContext match;
+    GameObject ship;
+    Asteroid asteroids[MAX_ASTEROIDS];
+    GameObject bullets[MAX_BULLETS];
+    int score, lives;
+    Autopilot autopilot;
+
+    memset(r, 0, sizeof(*r));
+    matchContextInit(&match, seed);
+    match.tuning = config->tuning;
+    setupMatch(&match, &ship, asteroids, bullets, &score, &lives);
+    autopilotInit(&autopilot);
+
+    int frame;
+    for (frame = 0; frame < maxFrames; frame++) {
+        u16 keysDown;
+        u16 keysHeld = autopilotKeys(&autopilot, &match, &ship, asteroids, &keysDown);
+        stepMatch(&match, &ship, asteroids, bullets, &score, &lives, keysHeld, keysDown);
+
+        int rocks = poolLiveCount(&match.asteroidPool);
+        int shots = poolLiveCount(&match.bulletPool);
+        if (rocks > r->peakAsteroids) r->peakAsteroids = rocks;
+        if (shots > r->peakBullets) r->peakBullets = shots;
+
+        int bucket = frame / CURVE_BUCKET;
+        if (bucket < CURVE_BUCKETS) {
+            r->curveFrames[bucket]++;
+            r->curveAsteroids[bucket] += rocks;
+            r->curveInterval[bucket] = match.currentSpawnInterval;
+        }
+
+        if (!ship.isAlive) {
+            if (lives <= 0) {
+                frame++;
+                break;
+            }
+            respawnShip(&match, &ship, asteroids);
+        }
+    }
+
+    r->frames = frame;
+    r->capped = (frame >= maxFrames) && ship.isAlive;
+    r->score = score;
+    r->spawnRefusals = match.asteroidPool.allocFailures;
+}
+
+static bool takeJob(JobRange *range, int *job) {
+    bool ok = false;
+    pthread_mutex_lock(&range->lock);
+    if (range->head < range->tail) {
+        *job = range->head++;
+        ok = true;
+    }
+    pthread_mutex_unlock(&range->lock);
+    return ok;
+}
+
+// Moves the back half of the fullest other range into this worker's range
+static bool stealJobs(Batch *batch, int self) {
+    int victim = -1, most = 0;
+    for (int i = 0; i < batch->workers; i++) {
+        if (i == self) continue;
+        int left = batch->ranges[i].tail - batch->ranges[i].head; // Racy peek, rechecked below
+        if (left > most) {
+            most = left;
+            victim = i;
+        }
+    }
+    if (victim < 0) return false;
+
+    JobRange *from = &batch->ranges[victim];
+    int head = 0, tail = 0;
+    pthread_mutex_lock(&from->lock);
+    int left = from->tail - from->head;
+    if (left > 0) {
+        tail = from->tail;
+        head = tail - (left + 1) / 2;
+        from->tail = head;
+    }
+    pthread_mutex_unlock(&from->lock);
+    if (head == tail) return true; // Lost the race; look again
+
+    JobRange *to = &batch->ranges[self];
+    pthread_mutex_lock(&to->lock);
+    to->head = head;
+    to->tail = tail;
+    pthread_mutex_unlock(&to->lock);
+    return true;
+}
+
+static void *workerMain(void *arg) {
+    Worker *w = arg;
+    Batch *batch = w->batch;
+    for (;;) {
+        int job;
+        while (takeJob(&batch->ranges[w->id], &job)) {
+            int config = job / batch->matchesPerConfig;
+            runMatch(&batch->configs[config], jobSeed(batch->seed, job),
+                     batch->maxFrames, &batch->results[job]);
+        }
+        if (!stealJobs(batch, w->id)) break;
+        w->steals++;
+    }
+    return NULL;
+}
+
+static int compareInt(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+static int parseList(const char *arg, int *values) {
+    int count = 0;
+    char *end;
+    while (*arg && count < MAX_VALUES) {
+        values[count++] = (int)strtol(arg, &end, 10);
+        if (*end != ',') break;
+        arg = end + 1;
+    }
+    return count;
+}
+
+static void report(const Config *config, const MatchResult *results, int matches, int maxFrames) {
+    int *frames = malloc(sizeof(int) * matches);
+    double score = 0, peakRocks = 0, peakShots = 0;
+    int maxRocks = 0, capped = 0, refusals = 0;
+
+    for (int i = 0; i < matches; i++) {
+        const MatchResult *r = &results[i];
+        frames[i] = r->frames;
+        score += r->score;
+        peakRocks += r->peakAsteroids;
+        peakShots += r->peakBullets;
+        if (r->peakAsteroids > maxRocks) maxRocks = r->peakAsteroids;
+        capped += r->capped;
+        refusals += r->spawnRefusals;
+    }
+    qsort(frames, matches, sizeof(int), compareInt);
+
+    printf("initial interval %d, decrease %d every %d frames, floor %d\n",
+           config->tuning.initialSpawnInterval, config->tuning.decreaseAmount,
+           config->tuning.decreaseInterval, config->tuning.minSpawnInterval);
+    printf("  survival frames: p10 %d  median %d  p90 %d  (%d%% reached %d)\n",
+           frames[matches / 10], frames[matches / 2], frames[(matches * 9) / 10],
+           (capped * 100) / matches, maxFrames);
+    printf("  score mean %.0f   peak asteroids mean %.1f max %d   peak bullets mean %.1f   refused spawns %d\n",
+           score / matches, peakRocks / matches, maxRocks, peakShots / matches, refusals);
+    printf("  spawn curve (s: live asteroids / spawn interval / matches still running):\n   ");
+    for (int b = 0; b < CURVE_BUCKETS; b++) {
+        long rocks = 0, played = 0, interval = 0;
+        int running = 0;
+        for (int i = 0; i < matches; i++) {
+            const MatchResult *r = &results[i];
+            rocks += r->curveAsteroids[b];
+            played += r->curveFrames[b];
+            if (r->curveFrames[b] == CURVE_BUCKET) {
+                interval += r->curveInterval[b];
+                running++;
+            }
+        }
+        if (!played) break;
+        printf(" %ds:%.1f/%ld/%d", ((b + 1) * CURVE_BUCKET) / 60, (double)rocks / played,
+               running ? interval / running : 0, running);
+    }
+    printf("\n");
+    free(frames);
+}
+
+int main(int argc, char **argv) {
+    int matches = 1000;
+    int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int maxFrames = 60 * 60 * 10;   // Ten minutes of play
+    u32 seed = 1;
+    int intervals[MAX_VALUES] = { 60 }, intervalCount = 1;
+    int decreases[MAX_VALUES] = { 5 }, decreaseCount = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-m") && i + 1 < argc) matches = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-t") && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-f") && i + 1 < argc) maxFrames = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-s") && i + 1 < argc) seed = (u32)strtoul(argv[++i], NULL, 10);
+        else if (!strcmp(argv[i], "-i") && i + 1 < argc) intervalCount = parseList(argv[++i], intervals);
+        else if (!strcmp(argv[i], "-d") && i + 1 < argc) decreaseCount = parseList(argv[++i], decreases);
+        else {
+            fprintf(stderr, "usage: %s [-m matches] [-t threads] [-s seed] [-f maxFrames]"
+                            " [-i initialIntervals] [-d decreaseAmounts]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (matches < 1 || threads < 1 || maxFrames < 1 || !intervalCount || !decreaseCount) {
+        fprintf(stderr, "%s: counts must be positive\n", argv[0]);
+        return 1;
+    }
+
+    // Every interval/decrease pair, with the rest of the tuning at its defaults
+    int configCount = intervalCount * decreaseCount;
+    Config *configs = calloc(configCount, sizeof(Config));
+    MatchContext defaults;
+    matchContextInit(&defaults, 1);
+    for (int i = 0; i < intervalCount; i++) {
+        for (int d = 0; d < decreaseCount; d++) {
+            MatchTuning *t = &configs[i * decreaseCount + d].tuning;
+            *t = defaults.tuning;
+            t->initialSpawnInterval = intervals[i];
+            t->decreaseInterval = intervals[i] * 2;
+            t->decreaseAmount = decreases[d];
+        }
+    }
+
+    int jobs = configCount * matches;
+    if (threads > jobs) threads = jobs;
+    Batch batch = {
+        configs, matches, maxFrames, seed,
+        calloc(jobs, sizeof(MatchResult)),
+        calloc(threads, sizeof(JobRange)),
+        threads
+    };
+    for (int i = 0; i < threads; i++) {
+        pthread_mutex_init(&batch.ranges[i].lock, NULL);
+        batch.ranges[i].head = (int)(((long)jobs * i) / threads);
+        batch.ranges[i].tail = (int)(((long)jobs * (i + 1)) / threads);
+    }
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    pthread_t *tids = calloc(threads, sizeof(pthread_t));
+    Worker *workers = calloc(threads, sizeof(Worker));
+    for (int i = 0; i < threads; i++) {
+        workers[i].batch = &batch;
+        workers[i].id = i;
+        pthread_create(&tids[i], NULL, workerMain, &workers[i]);
+    }
+    int steals = 0;
+    for (int i = 0; i < threads; i++) {
+        pthread_join(tids[i], NULL);
+        steals += workers[i].steals;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double seconds = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+    long long frames = 0;
+    for (int j = 0; j < jobs; j++) frames += batch.results[j].frames;
+
+    printf("%d matches on %d threads in %.2f s (%.1f M frames/s, %d steals)\n\n",
+           jobs, threads, seconds, frames / seconds / 1e6, steals);
+    for (int c = 0; c < configCount; c++) {
+        report(&configs[c], &batch.results[c * matches], matches, maxFrames);
+    }
+
+    for (int i = 0; i < threads; i++) pthread_mutex_destroy(&batch.ranges[i].lock);
+    free(workers);
+    free(tids);
+    free(batch.ranges);
+    free(batch.results);
+    free(configs);
+    return 0;
+}
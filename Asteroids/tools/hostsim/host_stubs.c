@@ -0,0 +1,28 @@
+#include <gba_types.h>
+#include "perf.h"
+#include "sound.h"
+
+// --- Host Stand-ins ---
+// Sound is silent on the host, and there is no scanline counter to measure
+// frame cost with, so the spawn scheduler always sees an idle frame with
+// the nominal budget and the stand-in asteroid cost.
+
+void playShootSound(void) {}
+void playExplosionSound(void) {}
+void playMenuSelectSound(void) {}
+void playThrusterSound(void) {}
+void stopThrusterSound(void) {}
+void playSirenSound(void) {}
+void playPlayerHitSound(void) {}
+
+int perfAvgFrameLines(void) {
+    return 0;
+}
+
+int perfBudgetLines(void) {
+    return FRAME_BUDGET_LINES;
+}
+
+int perfLoadCost8(void) {
+    return -1;
+}
@@ -0,0 +1,15 @@
+#ifndef HOSTSIM_GBA_BASE_H
+#define HOSTSIM_GBA_BASE_H
+
+// Host stand-in for libgba's gba_base.h: section placement is meaningless here
+#include "gba_types.h"
+
+#define IWRAM_CODE
+#define EWRAM_CODE
+#define IWRAM_DATA
+#define EWRAM_DATA
+#define EWRAM_BSS
+#define ALIGN(m) __attribute__((aligned (m)))
+#define BIT(n)   (1 << (n))
+
+#endif // HOSTSIM_GBA_BASE_H
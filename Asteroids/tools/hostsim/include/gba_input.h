@@ -0,0 +1,20 @@
+#ifndef HOSTSIM_GBA_INPUT_H
+#define HOSTSIM_GBA_INPUT_H
+
+// Host stand-in for libgba's gba_input.h: key bits only, input comes from the autopilot
+#include "gba_base.h"
+
+typedef enum KEYPAD_BITS {
+    KEY_A      = BIT(0),
+    KEY_B      = BIT(1),
+    KEY_SELECT = BIT(2),
+    KEY_START  = BIT(3),
+    KEY_RIGHT  = BIT(4),
+    KEY_LEFT   = BIT(5),
+    KEY_UP     = BIT(6),
+    KEY_DOWN   = BIT(7),
+    KEY_R      = BIT(8),
+    KEY_L      = BIT(9),
+} KEYPAD_BITS;
+
+#endif // HOSTSIM_GBA_INPUT_H
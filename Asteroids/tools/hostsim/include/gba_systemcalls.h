@@ -0,0 +1,9 @@
+#ifndef HOSTSIM_GBA_SYSTEMCALLS_H
+#define HOSTSIM_GBA_SYSTEMCALLS_H
+
+// Host stand-in for libgba's gba_systemcalls.h: the BIOS divide is plain C here
+
+static inline int Div(int Number, int Divisor) { return Number / Divisor; }
+static inline int DivMod(int Number, int Divisor) { return Number % Divisor; }
+
+#endif // HOSTSIM_GBA_SYSTEMCALLS_H
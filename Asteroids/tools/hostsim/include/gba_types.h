@@ -0,0 +1,22 @@
+#ifndef HOSTSIM_GBA_TYPES_H
+#define HOSTSIM_GBA_TYPES_H
+
+// Host stand-in for libgba's gba_types.h
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef uint8_t  u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int8_t   s8;
+typedef int16_t  s16;
+typedef int32_t  s32;
+typedef int64_t  s64;
+typedef volatile u8  vu8;
+typedef volatile u16 vu16;
+typedef volatile u32 vu32;
+typedef volatile s16 vs16;
+typedef volatile s32 vs32;
+
+#endif // HOSTSIM_GBA_TYPES_H
@@ -0,0 +1,9 @@
+#ifndef HOSTSIM_GBA_VIDEO_H
+#define HOSTSIM_GBA_VIDEO_H
+
+// Host stand-in for libgba's gba_video.h (game logic only needs RGB5)
+#include "gba_base.h"
+
+#define RGB5(r,g,b) ((r) | ((g) << 5) | ((b) << 10))
+
+#endif // HOSTSIM_GBA_VIDEO_H
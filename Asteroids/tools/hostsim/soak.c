@@ -0,0 +1,167 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <gba_types.h>
+#include "autopilot.h"
+#include "game_objects.h"
+#include "object_pool.h"
+
+// --- Host Soak Harness ---
+// Runs the unmodified match logic under the autopilot, uncapped, and times
+// every stepMatch() call. Usage:
+//   soak [-n frames] [-s seed] [-o frames.csv] [-e]
+// Deaths respawn the ship at once, and a game over starts a new match, as the
+// game does; -e hands lost lives back instead so a single match runs on at
+// its peak spawn rate. Deaths and game overs are reported either way. The
+// optional CSV gets one line per frame: frame,ns,asteroids,bullets.
+
+#define WORST_FRAMES   10
+#define REPORT_FRAMES  1000000
+
+typedef struct {
+    u64 frame;
+    u64 ns;
+    int asteroids;
+    int bullets;
+} FrameSample;
+
+static FrameSample worst[WORST_FRAMES];
+static int worstCount = 0;
+
+static u64 nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000ull + (u64)ts.tv_nsec;
+}
+
+// Keeps the WORST_FRAMES slowest frames, sorted slowest first
+static void recordWorst(const FrameSample *s) {
+    if (worstCount == WORST_FRAMES && s->ns <= worst[WORST_FRAMES - 1].ns) return;
+    int i = (worstCount < WORST_FRAMES) ? worstCount++ : WORST_FRAMES - 1;
+    while (i > 0 && worst[i - 1].ns < s->ns) {
+        worst[i] = worst[i - 1];
+        i--;
+    }
+    worst[i] = *s;
+}
+
+int main(int argc, char **argv) {
+    u64 frames = 5000000;
+    unsigned seed = 1;
+    const char *csvPath = NULL;
+    bool endless = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-n") && i + 1 < argc) frames = strtoull(argv[++i], NULL, 10);
+        else if (!strcmp(argv[i], "-s") && i + 1 < argc) seed = (unsigned)strtoul(argv[++i], NULL, 10);
+        else if (!strcmp(argv[i], "-o") && i + 1 < argc) csvPath = argv[++i];
+        else if (!strcmp(argv[i], "-e")) endless = true;
+        else {
+            fprintf(stderr, "usage: %s [-n frames] [-s seed] [-o frames.csv] [-e]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    FILE *csv = NULL;
+    if (csvPath) {
+        csv = fopen(csvPath, "w");
+        if (!csv) {
+            perror(csvPath);
+            return 1;
+        }
+        fprintf(csv, "frame,ns,asteroids,bullets\n");
+    }
+
+    MatchContext match;
+    matchContextInit(&match, seed);
+
+    GameObject ship;
+    Asteroid asteroids[MAX_ASTEROIDS];
+    GameObject bullets[MAX_BULLETS];
+    int score, lives;
+    Autopilot autopilot;
+
+    setupMatch(&match, &ship, asteroids, bullets, &score, &lives);
+    autopilotInit(&autopilot);
+    const int startLives = lives;
+
+    u64 matches = 1, deaths = 0, gameOvers = 0, bestScore = 0;
+    u64 totalNs = 0, windowNs = 0;
+    u64 matchStart = 0, longestMatch = 0;
+    u64 start = nowNs();
+
+    for (u64 frame = 1; frame <= frames; frame++) {
+        u16 keysDown;
+        u16 keysHeld = autopilotKeys(&autopilot, &match, &ship, asteroids, &keysDown);
+
+        u64 t0 = nowNs();
+        stepMatch(&match, &ship, asteroids, bullets, &score, &lives, keysHeld, keysDown);
+        u64 ns = nowNs() - t0;
+
+        FrameSample s = {
+            frame, ns,
+            poolLiveCount(&match.asteroidPool),
+            poolLiveCount(&match.bulletPool)
+        };
+        recordWorst(&s);
+        totalNs += ns;
+        windowNs += ns;
+        if (csv) {
+            fprintf(csv, "%llu,%llu,%d,%d\n", (unsigned long long)frame,
+                    (unsigned long long)ns, s.asteroids, s.bullets);
+        }
+
+        if (!ship.isAlive) {
+            deaths++;
+            if (endless) lives = startLives;
+            if (lives > 0) {
+                respawnShip(&match, &ship, asteroids);
+            } else {
+                gameOvers++;
+                printf("game over at frame %llu after %llu frames, score %d\n", (unsigned long long)frame,
+                       (unsigned long long)(frame - matchStart), score);
+                if ((u64)score > bestScore) bestScore = score;
+                if (frame - matchStart > longestMatch) longestMatch = frame - matchStart;
+                setupMatch(&match, &ship, asteroids, bullets, &score, &lives);
+                autopilotInit(&autopilot);
+                matchStart = frame;
+                matches++;
+            }
+        }
+
+        if (frame % REPORT_FRAMES == 0) {
+            printf("frame %llu: avg %llu ns, asteroids %d, bullets %d, deaths %llu, game overs %llu\n",
+                   (unsigned long long)frame, (unsigned long long)(windowNs / REPORT_FRAMES),
+                   s.asteroids, s.bullets, (unsigned long long)deaths, (unsigned long long)gameOvers);
+            windowNs = 0;
+        }
+    }
+
+    u64 elapsed = nowNs() - start;
+    if (frames - matchStart > longestMatch) longestMatch = frames - matchStart;
+    if ((u64)score > bestScore) bestScore = score;
+    if (csv) fclose(csv);
+
+    PoolStats rockStats, shotStats;
+    poolGetStats(&match.asteroidPool, &rockStats);
+    poolGetStats(&match.bulletPool, &shotStats);
+
+    printf("\n%llu frames in %.2f s (%.0f frames/s), avg step %llu ns\n",
+           (unsigned long long)frames, elapsed / 1e9, frames / (elapsed / 1e9),
+           (unsigned long long)(frames ? totalNs / frames : 0));
+    printf("deaths %llu, game overs %llu%s\n", (unsigned long long)deaths, (unsigned long long)gameOvers,
+           endless ? " (lives handed back)" : "");
+    printf("matches %llu, longest match %llu frames, best score %llu\n",
+           (unsigned long long)matches, (unsigned long long)longestMatch, (unsigned long long)bestScore);
+    printf("asteroid pool high water %d/%d (%d refused), bullet pool %d/%d (%d refused)\n",
+           rockStats.highWater, rockStats.capacity, rockStats.allocFailures,
+           shotStats.highWater, shotStats.capacity, shotStats.allocFailures);
+    printf("worst frames:\n");
+    for (int i = 0; i < worstCount; i++) {
+        printf("  frame %10llu  %8llu ns  asteroids %2d  bullets %2d\n",
+               (unsigned long long)worst[i].frame, (unsigned long long)worst[i].ns,
+               worst[i].asteroids, worst[i].bullets);
+    }
+    return 0;
+}